@@ -0,0 +1,136 @@
+/**
+ ******************************************************************************
+ * @file    Async_Interface.h
+ * @author  Alaa Elkhateeb
+ * @brief   cooperative tasks which wait for bus transfers without blocking.
+ * @date    Oct 19, 2026
+ ******************************************************************************
+ *
+ * A task is a function which runs from its top every time the executor
+ * calls it. ASYNC_BEGIN jumps back to the ASYNC_AWAIT it left from, so the
+ * function reads like blocking code:
+ *
+ *	static Async_State Sensor(Async_Task *task) {
+ *		Sensor_t *s = task->Context;
+ *
+ *		ASYNC_BEGIN(task);
+ *		ASYNC_AWAIT_OP(task, &s->Op, I2C_WriteReadAsync(I2C1, SENSOR_ADD,
+ *				&s->Reg, 1, s->Raw, 2, Async_OpDone, &s->Op));
+ *		Draw(s->Raw);
+ *		ASYNC_AWAIT(task, SSD1306_UpdateDirtyAsync());
+ *		ASYNC_END(task);
+ *	}
+ *
+ *	Async_Start(&sensor, Sensor, &state);
+ *	while (Async_Run()) {
+ *		__WFI();
+ *	}
+ *
+ * Locals of task function are lost at every wait, keep state in Context.
+ * ASYNC_* macros must not be used inside a switch of the task function.
+ */
+
+#ifndef ASYNC_INTERFACE_H_
+#define ASYNC_INTERFACE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Private defines */
+
+/*RESULT OF ONE RUN OF A TASK*/
+typedef enum {
+	ASYNC_WAITING = 0, ASYNC_DONE
+} Async_State;
+///////////////////////////////////////////////////////////////////////////////
+/*TASK, OWNED BY CALLER, LINKED INTO EXECUTOR BY Async_Start*/
+typedef struct Async_Task Async_Task;
+typedef Async_State (*Async_Body)(Async_Task *task);
+
+struct Async_Task {
+	Async_Body Body;
+	void *Context;
+	u16 Line;					//WHERE TASK WAITS, 0 BEFORE FIRST RUN
+	u8 Running;
+	Async_Task *Next;
+};
+///////////////////////////////////////////////////////////////////////////////
+/*OPERATION STARTED BY A TASK AND ENDED FROM INTERRUPT*/
+typedef struct {
+	u8 Started;
+	volatile u8 Done;
+	volatile u8 Error;			//0 ON SUCCESS
+} Async_Op;
+///////////////////////////////////////////////////////////////////////////////
+
+/*******************************************************************************
+ ****                    Task Macros                                       ****
+ ******************************************************************************/
+/*FIRST STATEMENT OF TASK FUNCTION*/
+#define ASYNC_BEGIN(task)			switch ((task)->Line) { case 0:
+
+/*RETURNS TO EXECUTOR UNTIL cond IS TRUE, cond IS CHECKED AGAIN AT EVERY RUN*/
+#define ASYNC_AWAIT(task, cond)		do { (task)->Line = __LINE__; if (0) { case __LINE__:; } \
+										if (!(cond)) { return ASYNC_WAITING; } } while (0)
+
+/*LETS OTHER TASKS RUN ONCE*/
+#define ASYNC_YIELD(task)			do { (task)->Line = __LINE__; return ASYNC_WAITING; \
+										case __LINE__:; } while (0)
+
+/*STARTS OPERATION AND WAITS FOR ITS END, start RETURNS 0 ONCE IT STARTED
+ *AND IS CALLED AGAIN AT EVERY RUN UNTIL THEN (PERIPHERAL BUSY)*/
+#define ASYNC_AWAIT_OP(task, op, start)	do { Async_OpBegin(op); \
+										ASYNC_AWAIT(task, ((op)->Started || \
+										((op)->Started = !(start))) && (op)->Done); } while (0)
+
+/*LAST STATEMENT OF TASK FUNCTION*/
+#define ASYNC_END(task)				} (task)->Line = 0; return ASYNC_DONE
+
+/*******************************************************************************
+ ****                    Functions Prototypes                              ****
+ ******************************************************************************/
+/******************************************************************************
+ * @brief 	   				Adds task to executor, it runs from its top at
+ * 							next Async_Run. Task must not be running.
+ * @param 					task: task storage, must stay valid while running
+ * @param 					body: task function
+ * @param 					context: stored in task->Context
+ * @return 					VOID
+ *************************************************************************** */
+void Async_Start(Async_Task *task, Async_Body body, void *context);
+/******************************************************************************
+ * @brief 	   				Runs every task once, finished tasks leave the
+ * 							executor. Call it from main loop, core may sleep
+ * 							in between until an interrupt ends an operation.
+ * @return 					number of tasks still running
+ *************************************************************************** */
+u8 Async_Run(void);
+/******************************************************************************
+ * @brief 	   				Task was started and did not finish yet.
+ * @param 					task: task to check
+ * @return 					1 when running, 0 otherwise
+ *************************************************************************** */
+u8 Async_Running(const Async_Task *task);
+/******************************************************************************
+ * @brief 	   				Prepares operation before it is started, used by
+ * 							ASYNC_AWAIT_OP.
+ * @param 					op: operation
+ * @return 					VOID
+ *************************************************************************** */
+void Async_OpBegin(Async_Op *op);
+/******************************************************************************
+ * @brief 	   				Ends operation, has the signature of
+ * 							I2C_DoneCallback so it can be passed to
+ * 							I2C_WriteMultiAsync and I2C_WriteReadAsync.
+ * @param 					op: Async_Op given as context
+ * @param 					error: 0 on success
+ * @return 					VOID
+ *************************************************************************** */
+void Async_OpDone(void *op, u8 error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASYNC_INTERFACE_H_ */
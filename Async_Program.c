@@ -0,0 +1,62 @@
+// ******************************************************************************
+// * @file    Async_Program.c
+// * @author  Alaa Elkhateeb
+// * @brief   executor of cooperative tasks.
+// * @date    Oct 19, 2026
+// ******************************************************************************
+// */
+/*LIB Layer*/
+#include "stdtypes.h"
+/*SERVICE*/
+#include "Async_Interface.h"
+
+/* Running tasks, newest first */
+static Async_Task *Async_List;
+
+void Async_Start(Async_Task *task, Async_Body body, void *context) {
+	task->Body = body;
+	task->Context = context;
+	task->Line = 0;
+	task->Running = 1;
+	task->Next = Async_List;
+	Async_List = task;
+}
+
+u8 Async_Run(void) {
+	Async_Task **link = &Async_List;
+	Async_Task *task;
+	u8 running = 0;
+
+	while (*link) {
+		task = *link;
+		if (task->Body(task) == ASYNC_DONE) {
+			/* Unlink, task may be started again from now on */
+			*link = task->Next;
+			task->Running = 0;
+		} else {
+			link = &task->Next;
+			running++;
+		}
+	}
+
+	return running;
+}
+
+u8 Async_Running(const Async_Task *task) {
+	return task->Running;
+}
+
+void Async_OpBegin(Async_Op *op) {
+	op->Started = 0;
+	op->Done = 0;
+	op->Error = 0;
+}
+
+void Async_OpDone(void *op, u8 error) {
+	Async_Op *o = op;
+
+	/* Error first, task checks Done */
+	o->Error = error;
+	o->Done = 1;
+}
+
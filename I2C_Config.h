@@ -8,6 +8,53 @@
 #ifndef I2C_CONFIG_H_
 #define I2C_CONFIG_H_
 
+/*TRANSACTION COUNTERS AND LATENCY HISTOGRAMS, 1 TO ENABLE, SEE I2C_GetStats*/
+#ifndef I2C_STATS_ENABLE
+#define I2C_STATS_ENABLE			0
+#endif
+
+/*SLAVE MODE RING SIZES IN BYTES, EACH MUST BE A POWER OF 2*/
+#ifndef I2C_SLAVE_RX_SIZE
+#define I2C_SLAVE_RX_SIZE			256
+#endif
+#ifndef I2C_SLAVE_TX_SIZE
+#define I2C_SLAVE_TX_SIZE			32
+#endif
+
+/*BYTE SENT WHEN MASTER READS MORE THAN WAS QUEUED*/
+#ifndef I2C_SLAVE_IDLE_BYTE
+#define I2C_SLAVE_IDLE_BYTE			0xFF
+#endif
+
+/*ADAPTIVE SCL SPEED OF MASTER, 1 TO ENABLE, SEE I2C_GetSpeed
+ *LEVELS ARE I2C_SPEED VALUES: 0 = 50KHZ, 1 = 100KHZ, 2 = 200KHZ, 3 = 400KHZ*/
+#ifndef I2C_ADAPTIVE_ENABLE
+#define I2C_ADAPTIVE_ENABLE			1
+#endif
+#ifndef I2C_SPEED_START
+#define I2C_SPEED_START				1
+#endif
+#ifndef I2C_SPEED_MIN
+#define I2C_SPEED_MIN				0
+#endif
+#ifndef I2C_SPEED_MAX
+#define I2C_SPEED_MAX				3
+#endif
+
+/*FAILED TRANSACTIONS BEFORE STEPPING ONE LEVEL DOWN*/
+#ifndef I2C_SPEED_FAULTS
+#define I2C_SPEED_FAULTS			3
+#endif
+
+/*CLEAN TRANSACTIONS IN A ROW BEFORE PROBING NEXT FASTER LEVEL*/
+#ifndef I2C_SPEED_QUIET
+#define I2C_SPEED_QUIET				256
+#endif
+
+/*FAILED PROBE DOUBLES QUIET PERIOD, AT MOST THAT MANY TIMES*/
+#ifndef I2C_SPEED_BACKOFF
+#define I2C_SPEED_BACKOFF			4
+#endif
 
 
 
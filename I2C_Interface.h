@@ -10,14 +10,23 @@
 #ifndef I2C_INTERFACE_H_
 #define I2C_INTERFACE_H_
 
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 #ifndef I2C_TIMEOUT
 #define I2C_TIMEOUT					20000
 #endif
 
+/* Latency histogram: bucket k counts transactions shorter than
+ * 2^(I2C_STATS_BUCKET_SHIFT + k) cycles, last bucket counts all longer ones */
+#ifndef I2C_STATS_BUCKETS
+#define I2C_STATS_BUCKETS			12
+#endif
+#ifndef I2C_STATS_BUCKET_SHIFT
+#define I2C_STATS_BUCKET_SHIFT		10
+#endif
 
-/* Private variables */
-static u32 I2C_Timeout;
 
 /* Private defines */
 
@@ -77,6 +86,44 @@ typedef enum {
 	DMA_DISABLE = 0, DMA_EN
 } I2C_MA_TRANSFER;
 ///////////////////////////////////////////////////////////////////////////////
+/* I2C_STATS: counters of one peripheral, all times in clock cycles.
+ * A transaction lasts from START to STOP */
+typedef struct {
+	u32 Transactions;
+	u32 Bytes;
+	u32 Failures;						//WAITS ENDED BY NACK OR TIMEOUT
+	u32 WaitCycles[8];					//WAITING FOR SR1 FLAG, INDEXED BY ITS BIT
+	u32 Latency[I2C_STATS_BUCKETS];		//TRANSACTION LATENCY HISTOGRAM
+	u32 LatencyMax;
+} I2C_Stats;
+///////////////////////////////////////////////////////////////////////////////
+/* I2C_SPEED: SCL clock levels of adaptive master, see I2C_Config.h */
+typedef enum {
+	I2C_SPEED_50K = 0, I2C_SPEED_100K, I2C_SPEED_200K, I2C_SPEED_400K
+} I2C_SPEED;
+///////////////////////////////////////////////////////////////////////////////
+/* I2C_ERRORS: bus events of one master since I2C_Init, kept also when
+ * I2C_STATS_ENABLE is 0. NACK of an address is counted in Af but is not a
+ * fault, it means no device answered */
+typedef struct {
+	u32 Af;								//NACK OF ADDRESS OR DATA BYTE
+	u32 Arlo;							//ARBITRATION LOST
+	u32 Berr;							//MISPLACED START OR STOP ON THE BUS
+	u32 Timeout;						//FLAG OR STOP NEVER CAME
+	u32 StepsDown;						//SPEED LOWERED AFTER FAULTS
+	u32 StepsUp;						//FASTER SPEED PROBED AFTER QUIET PERIOD
+} I2C_Errors;
+///////////////////////////////////////////////////////////////////////////////
+/* I2C_SLAVE_CALLBACK: called from interrupt when master ends a write frame
+ * with STOP or repeated START, dual is 1 when frame was addressed to second
+ * address, length is number of bytes of this frame now waiting in receive ring */
+typedef void (*I2C_SlaveCallback)(u8 dual, u16 length);
+///////////////////////////////////////////////////////////////////////////////
+/* I2C_DONE_CALLBACK: called from interrupt when a background master
+ * transaction ended, error is 0 on success and 1 on NACK or bus error,
+ * context is what the transaction was started with */
+typedef void (*I2C_DoneCallback)(void *context, u8 error);
+///////////////////////////////////////////////////////////////////////////////
 /*******************************************************************************
  ****                    Functions Prototypes                              ****
  ******************************************************************************/
@@ -106,7 +153,7 @@ void I2C_Init(I2CPeripheral I2Cx);
  * @param 					ack: ack enabled or disabled
  * @return 					Start condition status
  *************************************************************************** */
-u16 I2C_Start(I2CPeripheral I2Cx,u8 address,u8 direction,u8 ack);
+u16 I2C_Start(I2CPeripheral I2Cx,u8 address,I2C_Mode direction,I2C_AckBit ack);
 /******************************************************************************
  * @brief 	   				GENERATING STOP CONDITION.
  * @param 					I2Cx: where x can be 1 or 2 to select
@@ -138,14 +185,32 @@ void I2C_Write(I2CPeripheral I2Cx, u8 address, u8 reg ,u8 data );
 void I2C_WriteMulti(I2CPeripheral I2Cx, u8 address, u8 reg,
 		u8 *data, u16 count);
 /******************************************************************************
- * @brief 	   				Receives N bytes of data .
+ * @brief 	   				Receives N bytes of data into caller buffer.
  * @param 					I2Cx: where x can be 1 or 2 to select
  * 									the I2C peripheral
-  * @param					size: number of bytes to to receive.
-
- * @return 					Pointer to array that holds data
+ * @param  					address: 7 bit slave address, left aligned,
+ * 								bits 7:1 are used, LSB bit is not used
+ * @param					*data: pointer to buffer of at least size bytes
+ * @param					size: number of bytes to to receive, any length.
+ * @return 					0 on success, 1 on NACK or timeout
+ *************************************************************************** */
+u8 I2C_Read(I2CPeripheral I2Cx, u8 address, u8 *data, u16 size);
+/******************************************************************************
+ * @brief 	   				Writes N bytes then reads M bytes in one transaction,
+ * 							a repeated START separates both phases so no other
+ * 							master can get between register address and data.
+ * @param 					I2Cx: where x can be 1 or 2 to select
+ * 									the I2C peripheral
+ * @param  					address: 7 bit slave address, left aligned,
+ * 								bits 7:1 are used, LSB bit is not used
+ * @param					*tx: bytes to write first, usually register address
+ * @param					txlen: number of bytes to write, 0 for plain read
+ * @param					*rx: pointer to buffer of at least rxlen bytes
+ * @param					rxlen: number of bytes to read, 0 for plain write
+ * @return 					0 on success, 1 on NACK or timeout
  *************************************************************************** */
-u8* I2C_Read(I2CPeripheral I2Cx, u8 size);
+u8 I2C_WriteRead(I2CPeripheral I2Cx, u8 address, const u8 *tx, u16 txlen,
+		u8 *rx, u16 rxlen);
 /******************************************************************************
  * @brief  					connection check
  * @param  					I2Cx: I2C used
@@ -161,5 +226,161 @@ u8 I2C_IsDeviceConnected(I2CPeripheral I2Cx, u8 address);
  * @@return					 Void
   ***************************************************************************** */
 void I2C_WriteData(I2CPeripheral I2Cx, u8 data);
+
+/******************************************************************************
+ * @brief 	   				Copies counters, all zero unless I2C_STATS_ENABLE
+ * 							is 1 in I2C_Config.h.
+ * @param 					I2Cx: I2C used
+ * @param					*stats: where counters are copied to
+ * @return 					VOID
+ *************************************************************************** */
+void I2C_GetStats(I2CPeripheral I2Cx, I2C_Stats *stats);
+/******************************************************************************
+ * @brief 	   				Sets all counters to zero.
+ * @param 					I2Cx: I2C used
+ * @return 					VOID
+ *************************************************************************** */
+void I2C_ResetStats(I2CPeripheral I2Cx);
+/******************************************************************************
+ * @brief 	   				Replaces DWT cycle counter as time source, for
+ * 							host builds. Call before I2C_Init.
+ * @param 					clock: returns free running cycle count,
+ * 								NULL selects DWT again
+ * @return 					VOID
+ *************************************************************************** */
+void I2C_SetStatsClock(u32 (*clock)(void));
+
+/*******************************************************************************
+ ****                    Adaptive Speed                                    ****
+ ******************************************************************************/
+/******************************************************************************
+ * @brief 	   				SCL clock of next master transaction. Master
+ * 							starts at I2C_SPEED_START, steps one level down
+ * 							after I2C_SPEED_FAULTS failed transactions and
+ * 							probes one level up after I2C_SPEED_QUIET clean
+ * 							ones. New timing is written between transactions.
+ * @param 					I2Cx: I2C used
+ * @return 					clock in kHz
+ *************************************************************************** */
+u16 I2C_GetSpeed(I2CPeripheral I2Cx);
+/******************************************************************************
+ * @brief 	   				Copies error counters.
+ * @param 					I2Cx: I2C used
+ * @param					*errors: where counters are copied to
+ * @return 					VOID
+ *************************************************************************** */
+void I2C_GetErrors(I2CPeripheral I2Cx, I2C_Errors *errors);
+/******************************************************************************
+ * @brief 	   				Sets all error counters to zero, speed is kept.
+ * @param 					I2Cx: I2C used
+ * @return 					VOID
+ *************************************************************************** */
+void I2C_ResetErrors(I2CPeripheral I2Cx);
+
+/*******************************************************************************
+ ****                    Interrupt Driven Master                           ****
+ ******************************************************************************/
+/******************************************************************************
+ * @brief 	   				Starts I2C_WriteMulti in background, event and
+ * 							error interrupts move it on. Blocking functions
+ * 							must not be used on the peripheral until done.
+ * @param 					I2Cx: where x can be 1 or 2 to select
+ * 									the I2C peripheral
+ * @param  					address: 7 bit slave address, left aligned,
+ * 								bits 7:1 are used, LSB bit is not used
+ * @param					reg: register to write to
+ * @param					*data: bytes after reg, must stay unchanged
+ * 								until done is called
+ * @param					count: number bytes will be written
+ * @param					done: end of transaction, may be NULL
+ * @param					context: passed to done
+ * @return 					0 when started, 1 when peripheral is still busy
+ *************************************************************************** */
+u8 I2C_WriteMultiAsync(I2CPeripheral I2Cx, u8 address, u8 reg,
+		const u8 *data, u16 count, I2C_DoneCallback done, void *context);
+/******************************************************************************
+ * @brief 	   				Starts I2C_WriteRead in background, the same
+ * 							repeated START and receive sequences are run
+ * 							from event and error interrupts.
+ * @param 					I2Cx: where x can be 1 or 2 to select
+ * 									the I2C peripheral
+ * @param  					address: 7 bit slave address, left aligned,
+ * 								bits 7:1 are used, LSB bit is not used
+ * @param					*tx: bytes to write first, must stay unchanged
+ * 								until done is called
+ * @param					txlen: number of bytes to write, 0 for plain read
+ * @param					*rx: buffer of at least rxlen bytes, valid
+ * 								when done reports success
+ * @param					rxlen: number of bytes to read, 0 for plain write
+ * @param					done: end of transaction, may be NULL
+ * @param					context: passed to done
+ * @return 					0 when started, 1 when peripheral is still busy
+ *************************************************************************** */
+u8 I2C_WriteReadAsync(I2CPeripheral I2Cx, u8 address, const u8 *tx,
+		u16 txlen, u8 *rx, u16 rxlen, I2C_DoneCallback done, void *context);
+/******************************************************************************
+ * @brief 	   				Background transaction is running.
+ * @param 					I2Cx: I2C used
+ * @return 					1 when busy, 0 otherwise
+ *************************************************************************** */
+u8 I2C_Busy(I2CPeripheral I2Cx);
+
+/*******************************************************************************
+ ****                    Slave Mode                                        ****
+ ******************************************************************************/
+/******************************************************************************
+ * @brief 	   				Makes peripheral an interrupt driven slave, bytes
+ * 							written by master go to receive ring, bytes read by
+ * 							master come from transmit ring. Blocking master
+ * 							functions must not be used on the same peripheral
+ * 							afterwards. Background ones may, slave interrupts
+ * 							and ACK of own address are back when they end.
+ * @param 					I2Cx: where x can be 1 or 2 to select
+ * 									the I2C peripheral
+ * @param  					address1: 7 bit own address, left aligned,
+ * 								bits 7:1 are used, LSB bit is not used
+ * @param					DAddMode: TO ENABLE OR DISABLE SECOND ADDRESS
+ * @param  					address2: second 7 bit own address, left aligned,
+ * 								used only when DAddMode is DUAL_EN
+ * @param					callback: end of write frame, may be NULL
+ * @return 					VOID
+ *************************************************************************** */
+void I2C_SlaveInit(I2CPeripheral I2Cx, u8 address1,
+		I2C_DUAL_ADDRESSING_MODE DAddMode, u8 address2,
+		I2C_SlaveCallback callback);
+/******************************************************************************
+ * @brief 	   				Number of received bytes waiting in receive ring.
+ * @param 					I2Cx: I2C used
+ * @return 					number of bytes
+ *************************************************************************** */
+u16 I2C_SlaveAvailable(I2CPeripheral I2Cx);
+/******************************************************************************
+ * @brief 	   				Takes received bytes out of receive ring.
+ * @param 					I2Cx: I2C used
+ * @param					*data: pointer to buffer of at least size bytes
+ * @param					size: maximum number of bytes to take
+ * @return 					number of bytes taken
+ *************************************************************************** */
+u16 I2C_SlaveRead(I2CPeripheral I2Cx, u8 *data, u16 size);
+/******************************************************************************
+ * @brief 	   				Queues bytes for next master reads, master gets
+ * 							I2C_SLAVE_IDLE_BYTE once queue is empty.
+ * @param 					I2Cx: I2C used
+ * @param					*data: bytes to queue
+ * @param					size: number of bytes
+ * @return 					number of bytes queued, less than size when full
+ *************************************************************************** */
+u16 I2C_SlaveWrite(I2CPeripheral I2Cx, const u8 *data, u16 size);
+/******************************************************************************
+ * @brief 	   				Bytes dropped because receive ring was full.
+ * @param 					I2Cx: I2C used
+ * @return 					number of dropped bytes since init
+ *************************************************************************** */
+u32 I2C_SlaveOverflow(I2CPeripheral I2Cx);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* I2C_INTERFACE_H_ */
 
@@ -10,38 +10,165 @@
 
 #ifndef I2C_PRIVATE_H_
 #define I2C_PRIVATE_H_
+
+#ifndef I2C_SIM
 /*******************************************************************************
  ***                       Base Addressing                            ***
  ******************************************************************************/
 
 
-#define I2C1_BASE_ADDRESS         *((volatile u32 *)(0x40005400))
-#define I2C2_BASE_ADDRESS         *((volatile u32 *)(0x40005800))
+#define I2C1_BASE_ADDRESS         0x40005400
+#define I2C2_BASE_ADDRESS         0x40005800
 
 /*******************************************************************************
  ***                       Registers Addressing                            ***
  ******************************************************************************/
-				/*I2C1 REGISTERS ADDERSSING*/
-#define	I2C1_CR1_REG				*((volatile u32 *)(0x40005400))
-#define	I2C1_CR2_REG				*((volatile u32 *)(0x40005404))
-#define	I2C1_OAR1_REG				*((volatile u32 *)(0x40005408))
-#define	I2C1_OAR2_REG				*((volatile u32 *)(0x4000540C))
-#define	I2C1_DR_REG					*((volatile u32 *)(0x40005410))
-#define	I2C1_SR1_REG				*((volatile u32 *)(0x40005414))
-#define	I2C1_SR2_REG				*((volatile u32 *)(0x40005418))
-#define	I2C1_CCR_REG				*((volatile u32 *)(0x4000541C))
-#define	I2C1_TRISE_REG				*((volatile u32 *)(0x40005420))
-
-				/*I2C2 REGISTERS ADDERSSING*/
-#define	I2C2_CR1_REG				*((volatile u32 *)(0x40005800))
-#define	I2C2_CR2_REG				*((volatile u32 *)(0x40005804))
-#define	I2C2_OAR1_REG				*((volatile u32 *)(0x40005808))
-#define	I2C2_OAR2_REG				*((volatile u32 *)(0x4000580C))
-#define	I2C2_DR_REG					*((volatile u32 *)(0x40005810))
-#define	I2C2_SR1_REG				*((volatile u32 *)(0x40005814))
-#define	I2C2_SR2_REG				*((volatile u32 *)(0x40005818))
-#define	I2C2_CCR_REG				*((volatile u32 *)(0x4000581C))
-#define	I2C2_TRISE_REG				*((volatile u32 *)(0x40005820))
+				/*REGISTER BLOCK OF ONE PERIPHERAL*/
+typedef struct {
+	volatile u32 CR1;
+	volatile u32 CR2;
+	volatile u32 OAR1;
+	volatile u32 OAR2;
+	volatile u32 DR;
+	volatile u32 SR1;
+	volatile u32 SR2;
+	volatile u32 CCR;
+	volatile u32 TRISE;
+} I2C_RegDef_t;
+
+				/*BLOCKS ARE 0x400 APART, I2Cx IS 0 FOR I2C1 AND 1 FOR I2C2*/
+#define I2C_REGS(I2Cx)	((I2C_RegDef_t *)(I2C1_BASE_ADDRESS + \
+						((u32)(I2Cx) << 10)))
+
+				/*NVIC INTERRUPT SET ENABLE REGISTERS*/
+#define I2C_NVIC_ISER			((volatile u32 *)0xE000E100)
+
+				/*CYCLE COUNTER OF CORE, USED BY STATISTICS*/
+#define I2C_DEMCR				((volatile u32 *)0xE000EDFC)
+#define I2C_DWT_CTRL			((volatile u32 *)0xE0001000)
+#define I2C_DWT_CYCCNT			((volatile u32 *)0xE0001004)
+
+#else
+				/*HOST BUILD, SAME NAMES MAPPED TO REGISTER MODEL IN sim/*/
+#include "I2C_Sim.h"
+#endif
+
+				/*CLOCK AND PINS OF ONE PERIPHERAL*/
+typedef struct {
+	u8 ClockEn;
+	u8 SclPin;
+	u8 SdaPin;
+} I2C_PinDef_t;
+
+				/*EVENT IRQ NUMBER, ERROR IRQ FOLLOWS IT, I2Cx IS 0 OR 1*/
+#define I2C_EV_IRQ(I2Cx)		(31 + ((I2Cx) << 1))
+#define I2C_ER_IRQ(I2Cx)		(I2C_EV_IRQ(I2Cx) + 1)
+
+				/*DWT BITS*/
+#define I2C_DEMCR_TRCENA_BIT			24
+#define I2C_DWT_CTRL_CYCCNTENA_BIT		0
+
+				/*RING OF BYTES SHARED WITH INTERRUPT, SIZE IS POWER OF 2*/
+typedef struct {
+	u8 *Buffer;
+	u16 Mask;
+	volatile u16 Head;		//WRITTEN BY PRODUCER ONLY
+	volatile u16 Tail;		//WRITTEN BY CONSUMER ONLY
+} I2C_Ring_t;
+
+				/*SLAVE STATE OF ONE PERIPHERAL*/
+typedef struct {
+	I2C_Ring_t Rx;
+	I2C_Ring_t Tx;
+	I2C_SlaveCallback Callback;
+	u16 Length;				//BYTES RECEIVED IN CURRENT FRAME
+	u8 Dual;				//FRAME ADDRESSED TO SECOND ADDRESS
+	u8 Receiving;			//MASTER IS WRITING
+	u8 Enabled;				//SLAVE MODE CONFIGURED, KEEPS ITS INTERRUPTS
+	volatile u32 Overflow;
+} I2C_SlaveDef_t;
+
+				/*BACKGROUND MASTER TRANSACTION OF ONE PERIPHERAL*/
+typedef struct {
+	const u8 *Tx;
+	u8 *Rx;
+	u16 TxLen;
+	u16 RxLen;
+	u16 Index;				//NEXT BYTE OF CURRENT PHASE
+	u8 Address;
+	u8 Reg;
+	u8 HasReg;				//REG GOES OUT BEFORE TX BYTES
+	u8 Receiving;			//READ PHASE, AFTER (REPEATED) START
+	u8 Addressed;			//ADDR OF CURRENT PHASE WAS CLEARED
+	volatile u8 Busy;
+	I2C_DoneCallback Done;
+	void *Context;
+} I2C_MasterDef_t;
+
+				/*SCL TIMING OF ONE SPEED LEVEL*/
+typedef struct {
+	u16 Ccr;				//CCR VALUE WITH F/S AND DUTY BITS
+	u8 Trise;
+	u16 Khz;
+} I2C_SpeedDef_t;
+
+				/*ERROR COUNTERS AND SPEED LEVEL OF ONE MASTER*/
+typedef struct {
+	I2C_Errors Count;
+	u8 Level;				//I2C_SPEED OF NEXT TRANSACTION
+	u8 Pending;				//LEVEL CHANGED, CCR AND TRISE NOT WRITTEN YET
+	u8 Failed;				//CURRENT TRANSACTION HIT A FAULT
+	u8 Errored;				//CURRENT TRANSACTION COUNTED AN ERROR, FAULT OR NOT
+	u8 Lost;				//CURRENT TRANSACTION LOST ARBITRATION, NO STOP
+	u8 Faults;				//FAILED TRANSACTIONS SINCE LEVEL CHANGE OR QUIET PERIOD
+	u8 Probing;				//LEVEL WAS RAISED AND DID NOT HOLD A QUIET PERIOD YET
+	u8 Backoff;				//QUIET PERIOD IS DOUBLED THAT MANY TIMES
+	u32 Clean;				//TRANSACTIONS WITHOUT FAULT IN A ROW
+} I2C_AdaptDef_t;
+////////////////////////////////////////////////////////////////////////////
+
+/*******************************************************************************
+ ***                       Register Bits                                   ***
+ ******************************************************************************/
+				/*CR1 BITS*/
+#define I2C_CR1_PE_BIT				0
+#define I2C_CR1_START_BIT			8
+#define I2C_CR1_STOP_BIT			9
+#define I2C_CR1_ACK_BIT				10
+#define I2C_CR1_POS_BIT				11
+
+				/*CR2 BITS*/
+#define I2C_CR2_ITERREN_BIT			8
+#define I2C_CR2_ITEVTEN_BIT			9
+#define I2C_CR2_ITBUFEN_BIT			10
+
+				/*OAR1/OAR2 BITS*/
+#define I2C_OAR1_MUST_BE_ONE_BIT	14	//BIT 14 MUST BE KEPT 1 BY SOFTWARE
+#define I2C_OAR2_ENDUAL_BIT			0
+
+				/*CCR BITS*/
+#define I2C_CCR_DUTY_BIT			14
+#define I2C_CCR_FS_BIT				15
+
+				/*SR1 BITS*/
+#define I2C_SR1_SB_BIT				0
+#define I2C_SR1_ADDR_BIT			1
+#define I2C_SR1_BTF_BIT				2
+#define I2C_SR1_STOPF_BIT			4
+#define I2C_SR1_RXNE_BIT			6
+#define I2C_SR1_TXE_BIT				7
+#define I2C_SR1_BERR_BIT			8
+#define I2C_SR1_ARLO_BIT			9
+#define I2C_SR1_AF_BIT				10
+#define I2C_SR1_OVR_BIT				11
+
+				/*SR1 FLAGS WHICH END A MASTER TRANSACTION*/
+#define I2C_SR1_FAULTS				((1UL << I2C_SR1_BERR_BIT) | (1UL << I2C_SR1_ARLO_BIT) \
+									| (1UL << I2C_SR1_AF_BIT))
+
+				/*SR2 BITS*/
+#define I2C_SR2_TRA_BIT				2
+#define I2C_SR2_DUALF_BIT			7
 ////////////////////////////////////////////////////////////////////////////
 
 
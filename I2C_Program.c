@@ -11,122 +11,332 @@
 /*MCAL*/
 #include "I2C_Interface.h"
 #include "I2C_Private.h"
+#include "I2C_Config.h"
 #include "RCC_Interface.h"
 #include "GPIO_Interface.h"
 
-void I2C_Init(I2CPeripheral I2Cx) {
-	RCC_APB2_EnableCLK(PORTB_EN);
-	RCC_APB1_EnableCLK(I2C1_EN); //ENABLE RCC CLK
-	RCC_APB1_EnableCLK(AFIOEN);
-	if (I2Cx == I2C1) {
-		GPIO_u8SetPinMode(GPIO_U8_PORTB, GPIO_U8_P6, GPIO_U8_OUT_10MHZ_AF_OD);
-		GPIO_u8SetPinMode(GPIO_U8_PORTB, GPIO_U8_P7, GPIO_U8_OUT_10MHZ_AF_OD);
+/* Clock enable bit and SCL/SDA pins, indexed by I2CPeripheral */
+static const I2C_PinDef_t I2C_PinMap[2] = {
+	{ I2C1_EN, GPIO_U8_P6, GPIO_U8_P7 },
+	{ I2C2_EN, GPIO_U8_P10, GPIO_U8_P11 }
+};
+
+/* Slave rings and state, indexed by I2CPeripheral */
+static u8 I2C_SlaveRxBuffer[2][I2C_SLAVE_RX_SIZE];
+static u8 I2C_SlaveTxBuffer[2][I2C_SLAVE_TX_SIZE];
+static I2C_SlaveDef_t I2C_Slave[2];
+
+/* Background master transactions, indexed by I2CPeripheral */
+static I2C_MasterDef_t I2C_Master[2];
+
+/* SCL timings for PCLK1 of 36MHZ, indexed by I2C_SPEED. Standard mode period is
+ * 2 * CCR clocks, fast mode with duty 2 is 3 * CCR clocks. TRISE is maximum rise
+ * time in clocks + 1, 1000NS in standard mode and 300NS in fast mode */
+static const I2C_SpeedDef_t I2C_SpeedMap[4] = {
+	{ 360, 37, 50 },
+	{ 180, 37, 100 },
+	{ (1U << I2C_CCR_FS_BIT) | (I2C_DUTY_2 << I2C_CCR_DUTY_BIT) | 60, 11, 200 },
+	{ (1U << I2C_CCR_FS_BIT) | (I2C_DUTY_2 << I2C_CCR_DUTY_BIT) | 30, 11, 400 }
+};
+
+/* Error counters and speed levels, indexed by I2CPeripheral */
+static I2C_AdaptDef_t I2C_Adapt[2];
+
+#if I2C_STATS_ENABLE
+/* Reads DWT cycle counter */
+static u32 I2C_DwtClock(void) {
+	return *I2C_DWT_CYCCNT;
+}
 
-		I2C1_CR2_REG |= (36 & 0x3F); //  14 FREQ value in CR2 reg masked all except first 6 bits 0x3F ->11 11 11
-		I2C1_CCR_REG |= (180 & 0xFFF); // 70 CCR value in CCR reg masked all except first 12 bits 0xFFF ->1111 1111 1111
-		I2C1_TRISE_REG = (37 & 0x3F); //15fr0m datasheet TRISE = (FREQvalue/1000ns)+1;
+/* Counters, clock and START time, indexed by I2CPeripheral */
+static I2C_Stats I2C_Stat[2];
+static u32 (*I2C_StatsClock)(void) = I2C_DwtClock;
+static u32 I2C_StatsBegin[2];
+#endif
+
+/* Transaction begins with START */
+static void I2C_StatsStart(I2CPeripheral I2Cx) {
+#if I2C_STATS_ENABLE
+	I2C_StatsBegin[I2Cx] = I2C_StatsClock();
+#else
+	(void) I2Cx;
+#endif
+}
 
-		SET(I2C1_CR1_REG, 0);		//EN PERIPHERAL
-		I2C1_CR1_REG |= (ACK << 10);   //SETTING ACK
-	} else if (I2Cx == I2C2) {
-		GPIO_u8SetPinMode(GPIO_U8_PORTB, GPIO_U8_P8, GPIO_U8_OUT_10MHZ_AF_OD);
-		GPIO_u8SetPinMode(GPIO_U8_PORTB, GPIO_U8_P9, GPIO_U8_OUT_10MHZ_AF_OD);
+/* Transaction ends with STOP, its latency goes to histogram */
+static void I2C_StatsEnd(I2CPeripheral I2Cx) {
+#if I2C_STATS_ENABLE
+	u32 cycles = I2C_StatsClock() - I2C_StatsBegin[I2Cx];
+	u32 bound = cycles >> I2C_STATS_BUCKET_SHIFT;
+	u8 k = 0;
 
-		I2C2_CR2_REG |= (36 & 0x3F); //  14 FREQ value in CR2 reg masked all except first 6 bits 0x3F ->11 11 11
-		I2C2_CCR_REG |= (180 & 0xFFF); // 70 CCR value in CCR reg masked all except first 12 bits 0xFFF ->1111 1111 1111
-		I2C2_TRISE_REG = (37 & 0x3F); //15fr0m datasheet TRISE = (FREQvalue/1000ns)+1;
+	while (bound && k < I2C_STATS_BUCKETS - 1) {
+		bound >>= 1;
+		k++;
+	}
+	I2C_Stat[I2Cx].Transactions++;
+	I2C_Stat[I2Cx].Latency[k]++;
+	if (cycles > I2C_Stat[I2Cx].LatencyMax) {
+		I2C_Stat[I2Cx].LatencyMax = cycles;
+	}
+#else
+	(void) I2Cx;
+#endif
+}
 
-		SET(I2C2_CR1_REG, 0);		//EN PERIPHERAL
-		I2C2_CR1_REG |= (ACK << 10);   //SETTING ACK
+/* Bytes which went over the bus */
+static void I2C_StatsBytes(I2CPeripheral I2Cx, u16 count) {
+#if I2C_STATS_ENABLE
+	I2C_Stat[I2Cx].Bytes += count;
+#else
+	(void) I2Cx;
+	(void) count;
+#endif
+}
+
+/* Counts error flags of SR1, none set is a timeout. NACK of address is an
+ * absent device, not a fault of the wiring */
+static void I2C_CountError(I2CPeripheral I2Cx, u32 sr1, u8 address) {
+	I2C_RegDef_t *I2C = I2C_REGS(I2Cx);
+	I2C_AdaptDef_t *adapt = &I2C_Adapt[I2Cx];
 
+	if (GET(sr1, I2C_SR1_BERR_BIT)) {
+		adapt->Count.Berr++;
+		adapt->Failed = 1;
+	}
+	if (GET(sr1, I2C_SR1_ARLO_BIT)) {
+		adapt->Count.Arlo++;
+		adapt->Failed = 1;
+		adapt->Lost = 1;
 	}
+	if (GET(sr1, I2C_SR1_AF_BIT)) {
+		adapt->Count.Af++;
+		adapt->Failed |= !address;
+	}
+	if (!(sr1 & I2C_SR1_FAULTS)) {
+		adapt->Count.Timeout++;
+		adapt->Failed = 1;
+	}
+
+	adapt->Errored = 1;
 
+	/* BERR AND ARLO ARE CLEARED BY WRITING 0, CALLERS CLEAR AF */
+	if (sr1 & ((1UL << I2C_SR1_BERR_BIT) | (1UL << I2C_SR1_ARLO_BIT))) {
+		I2C->SR1 &= ~((1UL << I2C_SR1_BERR_BIT) | (1UL << I2C_SR1_ARLO_BIT));
+	}
 }
 
-u16 I2C_Start(I2CPeripheral I2Cx, u8 address, I2C_Mode direction,
-		I2C_AckBit ack) {
-	if (I2Cx == I2C1) {
-		SET(I2C1_CR1_REG, 8);		//GENERATE START
-		while (((GET(I2C1_SR1_REG, 0)) == 0))
-			;		/////START CONDITION SUCCESS
-		if (ack) {
-			I2C1_CR1_REG |= (1 << 10);   //SETTING ACK
-		}
-		/* Send write/read bit */
-		if (direction == I2C_TRANSMITTER_MODE) {
-			/* Send address with zero last bit */
-			I2C1_DR_REG = (address) & ~(GET(I2C1_OAR1_REG, 0));
-			while (((GET(I2C1_SR1_REG, 1)) == 0))
-				;		/////ADDRESS RECIEVIED
-		}
-		if (direction == I2C_RECEIVER_MODE) {
-			/* Send address with 1 last bit */
-			I2C1_DR_REG = (address) | (GET(I2C1_OAR1_REG, 0));
-
-			/* Wait till finished */
-			I2C_Timeout = I2C_TIMEOUT;
-			if (--I2C_Timeout == 0x00) {
-				return 1;
-			}
+/* Writes timing of speed level, peripheral must be disabled */
+static void I2C_SetTiming(I2C_RegDef_t *I2C, u8 level) {
+	I2C->CCR = I2C_SpeedMap[level].Ccr;
+	I2C->TRISE = I2C_SpeedMap[level].Trise;
+}
 
-		}
-		/* Read status register to clear ADDR flag */
-		u8 temp = (I2C1_SR2_REG) | (I2C1_SR2_REG);
+/* Moves to new speed level, registers follow before next transaction */
+static void I2C_AdaptStep(I2C_AdaptDef_t *adapt, u8 level) {
+	if (level > adapt->Level) {
+		adapt->Count.StepsUp++;
+	} else {
+		adapt->Count.StepsDown++;
+	}
+	adapt->Level = level;
+	adapt->Pending = 1;
+	adapt->Faults = 0;
+	adapt->Clean = 0;
+}
 
-	} else if (I2Cx == I2C1) {
-		SET(I2C2_CR1_REG, 8);
-		while (((GET(I2C2_SR1_REG, 0)) == 0))
-			;		/////START CONDITION SUCCESS
-		if (ack) {
-			I2C2_CR1_REG |= (1 << 10);   //SETTING ACK
-		}
-		/* Send write/read bit */
-		if (direction == I2C_TRANSMITTER_MODE) {
-			/* Send address with zero last bit */
-			I2C2_DR_REG = (address) & ~(GET(I2C2_OAR1_REG, 0));
-			/* Wait till finished */
-			while (((GET(I2C2_SR1_REG, 1)) == 0))
-				;		/////ADDRESS RECIEVIED
+/* Transaction begins, CCR and TRISE can be written only while PE is 0 */
+static void I2C_AdaptApply(I2CPeripheral I2Cx) {
+#if I2C_ADAPTIVE_ENABLE
+	I2C_RegDef_t *I2C = I2C_REGS(I2Cx);
+	u32 timeout = I2C_TIMEOUT;
 
-		}
-		if (direction == I2C_RECEIVER_MODE) {
-			/* Send address with 1 last bit */
-			I2C2_DR_REG = (address) | (GET(I2C2_OAR1_REG, 0));
+	if (!I2C_Adapt[I2Cx].Pending) {
+		return;
+	}
+	I2C_Adapt[I2Cx].Pending = 0;
+
+	/* STOP OF LAST TRANSACTION MUST GO OUT FIRST */
+	while (GET(I2C->CR1, I2C_CR1_STOP_BIT) && --timeout)
+		;
+	RESET(I2C->CR1, I2C_CR1_PE_BIT);
+	I2C_SetTiming(I2C, I2C_Adapt[I2Cx].Level);
+	SET(I2C->CR1, I2C_CR1_PE_BIT);
+	SET(I2C->CR1, I2C_CR1_ACK_BIT);		//ACK IS CLEARED WITH PE
+#else
+	(void) I2Cx;
+#endif
+}
 
-			/* Wait till finished */
-			I2C_Timeout = I2C_TIMEOUT;
-			if (I2C_Timeout == 0x00) {
-				return 1;
+/* Transaction ended, faults step speed down, quiet period probes next level up */
+static void I2C_AdaptEnd(I2CPeripheral I2Cx) {
+	I2C_AdaptDef_t *adapt = &I2C_Adapt[I2Cx];
+	u8 failed = adapt->Failed;
+
+	adapt->Failed = 0;
+	adapt->Errored = 0;
+	adapt->Lost = 0;
+#if I2C_ADAPTIVE_ENABLE
+	if (failed) {
+		adapt->Clean = 0;
+		if (adapt->Level <= I2C_SPEED_MIN) {
+			/* NOTHING SLOWER TO TRY */
+		} else if (adapt->Probing) {
+			/* RAISED LEVEL DID NOT HOLD, NEXT PROBE WAITS LONGER */
+			adapt->Probing = 0;
+			if (adapt->Backoff < I2C_SPEED_BACKOFF) {
+				adapt->Backoff++;
 			}
-
+			I2C_AdaptStep(adapt, adapt->Level - 1);
+		} else if (++adapt->Faults >= I2C_SPEED_FAULTS) {
+			/* WIRING GOT WORSE, FAILED PROBES OF BEFORE SAY NOTHING NOW */
+			adapt->Backoff = 0;
+			I2C_AdaptStep(adapt, adapt->Level - 1);
 		}
-		/* Read status register to clear ADDR flag */
-		u8 temp = (I2C2_SR2_REG) | (I2C2_SR2_REG);
+	} else if (++adapt->Clean >= ((u32) I2C_SPEED_QUIET << adapt->Backoff)) {
+		adapt->Clean = 0;
+		adapt->Faults = 0;
+		if (adapt->Probing) {
+			/* RAISED LEVEL HELD A WHOLE QUIET PERIOD */
+			adapt->Probing = 0;
+			adapt->Backoff = 0;
+		} else if (adapt->Level < I2C_SPEED_MAX) {
+			I2C_AdaptStep(adapt, adapt->Level + 1);
+			adapt->Probing = 1;
+		}
+	}
+#else
+	(void) failed;
+#endif
+}
 
+/* Waits for SR1 flag, gives up on NACK, bus error, lost arbitration or timeout */
+static u8 I2C_WaitFlag(I2CPeripheral I2Cx, u8 flag) {
+	I2C_RegDef_t *I2C = I2C_REGS(I2Cx);
+	u32 timeout = I2C_TIMEOUT;
+	u32 sr1;
+	u8 failed = 0;
+#if I2C_STATS_ENABLE
+	u32 begin = I2C_StatsClock();
+#endif
+
+	while (1) {
+		sr1 = I2C->SR1;
+		if (sr1 & ((1UL << I2C_SR1_BERR_BIT) | (1UL << I2C_SR1_ARLO_BIT))) {
+			/* BYTE WAS LOST, TXE MAY STILL BE SET FROM IT */
+			failed = 1;
+		} else if (GET(sr1, flag)) {
+			break;
+		} else if (GET(sr1, I2C_SR1_AF_BIT) || --timeout == 0) {
+			failed = 1;
+		}
+		if (failed) {
+			I2C_CountError(I2Cx, sr1, flag == I2C_SR1_ADDR_BIT);
+			break;
+		}
 	}
 
-	/* Return 0, everything ok */
-	return 0;
+#if I2C_STATS_ENABLE
+	I2C_Stat[I2Cx].WaitCycles[flag] += I2C_StatsClock() - begin;
+	I2C_Stat[I2Cx].Failures += failed;
+#endif
+	return failed;
+}
 
+/* Reading SR1 then SR2 clears ADDR */
+static void I2C_ClearAddr(I2C_RegDef_t *I2C) {
+	u32 sr;
+
+	sr = I2C->SR1;
+	sr = I2C->SR2;
+	(void) sr;
 }
 
-u8 I2C_Stop(I2CPeripheral I2Cx) {
-	I2C_Timeout = I2C_TIMEOUT;
-	if (I2Cx == I2C1) {
+void I2C_Init(I2CPeripheral I2Cx) {
+	I2C_RegDef_t *I2C = I2C_REGS(I2Cx);
+	I2C_AdaptDef_t adapt = { 0 };
 
-		while ((((GET(I2C1_SR1_REG, 7)) || (GET(I2C1_SR1_REG, 2))) == 0))
-			;
-		SET(I2C1_CR1_REG, 9); //GENERATE STOP
-	} else if (I2Cx == I2C1) {
+	RCC_APB2_EnableCLK(PORTB_EN);
+	RCC_APB2_EnableCLK(AFIOEN);
+	RCC_APB1_EnableCLK(I2C_PinMap[I2Cx].ClockEn); //ENABLE RCC CLK
+
+	GPIO_u8SetPinMode(GPIO_U8_PORTB, I2C_PinMap[I2Cx].SclPin, GPIO_U8_OUT_10MHZ_AF_OD);
+	GPIO_u8SetPinMode(GPIO_U8_PORTB, I2C_PinMap[I2Cx].SdaPin, GPIO_U8_OUT_10MHZ_AF_OD);
+
+	I2C->CR2 |= (36 & 0x3F); //  14 FREQ value in CR2 reg masked all except first 6 bits 0x3F ->11 11 11
+
+	/* CCR AND TRISE OF START LEVEL, SEE I2C_SpeedMap */
+	adapt.Level = I2C_SPEED_START;
+	I2C_Adapt[I2Cx] = adapt;
+	I2C_SetTiming(I2C, I2C_SPEED_START);
+
+	SET(I2C->CR1, I2C_CR1_PE_BIT);		//EN PERIPHERAL
+	I2C->CR1 |= (ACK << I2C_CR1_ACK_BIT);   //SETTING ACK
+
+#if I2C_STATS_ENABLE
+	if (I2C_StatsClock == I2C_DwtClock) {
+		SET(*I2C_DEMCR, I2C_DEMCR_TRCENA_BIT);		//DWT NEEDS TRACE ENABLED
+		SET(*I2C_DWT_CTRL, I2C_DWT_CTRL_CYCCNTENA_BIT);
+	}
+#endif
+}
+
+u16 I2C_Start(I2CPeripheral I2Cx, u8 address, I2C_Mode direction,
+		I2C_AckBit ack) {
+	I2C_RegDef_t *I2C = I2C_REGS(I2Cx);
 
-		while ((((GET(I2C1_SR1_REG, 7)) || (GET(I2C1_SR1_REG, 2))) == 0))
-			;
-		SET(I2C2_CR1_REG, 9);
+	I2C_AdaptApply(I2Cx);
+	I2C_StatsStart(I2Cx);
+	SET(I2C->CR1, I2C_CR1_START_BIT);		//GENERATE START
+	if (I2C_WaitFlag(I2Cx, I2C_SR1_SB_BIT)) {
+		return 1;
+	}
+	if (ack) {
+		SET(I2C->CR1, I2C_CR1_ACK_BIT);   //SETTING ACK
 	}
 
+	/* Send address with write/read bit */
+	if (direction == I2C_TRANSMITTER_MODE) {
+		I2C->DR = address & ~1;
+	} else {
+		I2C->DR = address | 1;
+	}
+	if (I2C_WaitFlag(I2Cx, I2C_SR1_ADDR_BIT)) {
+		/* No ACK from slave */
+		RESET(I2C->SR1, I2C_SR1_AF_BIT);
+		return 1;
+	}
+
+	/* Read status registers to clear ADDR flag */
+	I2C_ClearAddr(I2C);
+
 	/* Return 0, everything ok */
 	return 0;
 }
+
+u8 I2C_Stop(I2CPeripheral I2Cx) {
+	I2C_RegDef_t *I2C = I2C_REGS(I2Cx);
+	u32 timeout = I2C_TIMEOUT;
+
+	/* Wait till transmitter is empty or byte transfer finished */
+	while (!(GET(I2C->SR1, I2C_SR1_TXE_BIT) || GET(I2C->SR1, I2C_SR1_BTF_BIT))
+			&& --timeout)
+		;
+	if (!timeout && !I2C_Adapt[I2Cx].Errored) {
+		/* AFTER NACK OR BUS ERROR NEITHER FLAG COMES, THAT IS NO NEW ERROR */
+		I2C_CountError(I2Cx, 0, 0);
+	}
+	if (!I2C_Adapt[I2Cx].Lost) {
+		/* AFTER LOST ARBITRATION PERIPHERAL IS SLAVE, BUS BELONGS TO WINNER */
+		SET(I2C->CR1, I2C_CR1_STOP_BIT); //GENERATE STOP
+	}
+	I2C_StatsEnd(I2Cx);
+	I2C_AdaptEnd(I2Cx);
+
+	/* Return 0, everything ok, 1 on timeout */
+	return timeout == 0;
+}
+
 void I2C_Write(I2CPeripheral I2Cx, u8 address, u8 reg, u8 data) {
 
 	I2C_Start(I2Cx, address, I2C_TRANSMITTER_MODE, NACK);
@@ -135,30 +345,35 @@ void I2C_Write(I2CPeripheral I2Cx, u8 address, u8 reg, u8 data) {
 	I2C_Stop(I2Cx);
 
 }
-void I2C_WriteData(I2CPeripheral I2Cx, u8 data) {
-	if (I2Cx == I2C1) {
-		while (!(GET(I2C1_SR1_REG, 7)))
-			;
 
-		/* Send I2C data */
-		I2C1_DR_REG = data;
-	} else if (I2Cx == I2C2) {
-		while (!(GET(I2C2_SR1_REG, 7)))
-			;
+void I2C_WriteData(I2CPeripheral I2Cx, u8 data) {
+	I2C_RegDef_t *I2C = I2C_REGS(I2Cx);
 
+	if (!I2C_WaitFlag(I2Cx, I2C_SR1_TXE_BIT)) {
 		/* Send I2C data */
-		I2C2_DR_REG = data;
+		I2C->DR = data;
+		I2C_StatsBytes(I2Cx, 1);
 	}
-
 }
+
 void I2C_WriteMulti(I2CPeripheral I2Cx, u8 address, u8 reg, u8 *data, u16 count) {
-	u8 i;
+	I2C_RegDef_t *I2C = I2C_REGS(I2Cx);
+	u16 i;
 
-	I2C_Start(I2Cx, address, I2C_TRANSMITTER_MODE, ACK);
+	if (I2C_Start(I2Cx, address, I2C_TRANSMITTER_MODE, ACK)) {
+		I2C_Stop(I2Cx);
+		return;
+	}
 	I2C_WriteData(I2Cx, reg);
+
+	/* Bytes are counted once after the burst, not per byte */
 	for (i = 0; i < count; i++) {
-		I2C_WriteData(I2Cx, data[i]);
+		if (I2C_WaitFlag(I2Cx, I2C_SR1_TXE_BIT)) {
+			break;
+		}
+		I2C->DR = data[i];
 	}
+	I2C_StatsBytes(I2Cx, i);
 	I2C_Stop(I2Cx);
 
 }
@@ -177,71 +392,574 @@ u8 I2C_IsDeviceConnected(I2CPeripheral I2Cx, u8 address) {
 	return connected;
 }
 
-u8* I2C_Read(I2CPeripheral I2Cx, u8 size) {
-	u8 buffer[8];
-	u8 remaining = size;
+u8 I2C_Read(I2CPeripheral I2Cx, u8 address, u8 *data, u16 size) {
+	return I2C_WriteRead(I2Cx, address, 0, 0, data, size);
+}
 
-	if (size == 1) {
+u8 I2C_WriteRead(I2CPeripheral I2Cx, u8 address, const u8 *tx, u16 txlen,
+		u8 *rx, u16 rxlen) {
+	I2C_RegDef_t *I2C = I2C_REGS(I2Cx);
+	u32 timeout;
+	u16 i;
+
+	I2C_AdaptApply(I2Cx);
+	I2C_StatsStart(I2Cx);
+	if (txlen) {
+		SET(I2C->CR1, I2C_CR1_START_BIT);		//GENERATE START
+		if (I2C_WaitFlag(I2Cx, I2C_SR1_SB_BIT)) {
+			goto error;
+		}
+		I2C->DR = address & ~1;
+		if (I2C_WaitFlag(I2Cx, I2C_SR1_ADDR_BIT)) {
+			goto error;
+		}
+		I2C_ClearAddr(I2C);
 
-		if (I2Cx == I2C1) {
-			RESET(I2C1_CR1_REG, 10);		//CLEARING ACK
-			I2C_Stop(I2C1);
-			while (((GET(I2C1_SR1_REG, 6)) == 0))
-				;
-			buffer[size - remaining] = I2C1_DR_REG;
-		} else if (I2Cx == I2C2) {
+		for (i = 0; i < txlen; i++) {
+			if (I2C_WaitFlag(I2Cx, I2C_SR1_TXE_BIT)) {
+				goto error;
+			}
+			I2C->DR = tx[i];
+		}
+		I2C_StatsBytes(I2Cx, txlen);
+		/* Last byte has to leave shift register before the repeated START */
+		if (I2C_WaitFlag(I2Cx, I2C_SR1_BTF_BIT)) {
+			goto error;
+		}
+	}
+
+	if (!rxlen) {
+		if (txlen) {
+			SET(I2C->CR1, I2C_CR1_STOP_BIT);
+			I2C_StatsEnd(I2Cx);
+			I2C_AdaptEnd(I2Cx);
+		}
+		return 0;
+	}
+
+	SET(I2C->CR1, I2C_CR1_ACK_BIT);
+	SET(I2C->CR1, I2C_CR1_START_BIT);		//(REPEATED) START
+	if (I2C_WaitFlag(I2Cx, I2C_SR1_SB_BIT)) {
+		goto error;
+	}
+	if (rxlen == 2) {
+		/* ACK/NACK applies to the byte after the one in shift register */
+		SET(I2C->CR1, I2C_CR1_POS_BIT);
+	}
+	I2C->DR = address | 1;
+	if (I2C_WaitFlag(I2Cx, I2C_SR1_ADDR_BIT)) {
+		goto error;
+	}
 
-			RESET(I2C2_CR1_REG, 10);
-			I2C_Stop(I2C2);
-			while (((GET(I2C2_SR1_REG, 6)) == 0))
-				;
-			buffer[size - remaining] = I2C2_DR_REG;
+	if (rxlen == 1) {
+		/* NACK must be programmed before ADDR is cleared */
+		RESET(I2C->CR1, I2C_CR1_ACK_BIT);
+		I2C_ClearAddr(I2C);
+		SET(I2C->CR1, I2C_CR1_STOP_BIT);
+		if (I2C_WaitFlag(I2Cx, I2C_SR1_RXNE_BIT)) {
+			goto error;
+		}
+		rx[0] = I2C->DR;
+	} else if (rxlen == 2) {
+		I2C_ClearAddr(I2C);
+		RESET(I2C->CR1, I2C_CR1_ACK_BIT);
+		/* Byte 1 in DR, byte 2 in shift register */
+		if (I2C_WaitFlag(I2Cx, I2C_SR1_BTF_BIT)) {
+			goto error;
+		}
+		SET(I2C->CR1, I2C_CR1_STOP_BIT);
+		rx[0] = I2C->DR;
+		rx[1] = I2C->DR;
+		RESET(I2C->CR1, I2C_CR1_POS_BIT);
+	} else {
+		I2C_ClearAddr(I2C);
+		for (i = 0; i < rxlen - 3; i++) {
+			if (I2C_WaitFlag(I2Cx, I2C_SR1_RXNE_BIT)) {
+				goto error;
+			}
+			rx[i] = I2C->DR;
+		}
+		/* Byte N-2 in DR, byte N-1 in shift register, bus is stretched */
+		if (I2C_WaitFlag(I2Cx, I2C_SR1_BTF_BIT)) {
+			goto error;
+		}
+		RESET(I2C->CR1, I2C_CR1_ACK_BIT);
+		rx[i++] = I2C->DR;
+		if (I2C_WaitFlag(I2Cx, I2C_SR1_BTF_BIT)) {
+			goto error;
 		}
+		SET(I2C->CR1, I2C_CR1_STOP_BIT);
+		rx[i++] = I2C->DR;
+		if (I2C_WaitFlag(I2Cx, I2C_SR1_RXNE_BIT)) {
+			goto error;
+		}
+		rx[i] = I2C->DR;
+	}
+
+	/* Next START may be requested only after STOP went out */
+	timeout = I2C_TIMEOUT;
+	while (GET(I2C->CR1, I2C_CR1_STOP_BIT) && --timeout)
+		;
+	if (!timeout) {
+		I2C_CountError(I2Cx, 0, 0);
+	}
+	I2C_StatsBytes(I2Cx, rxlen);
+	I2C_StatsEnd(I2Cx);
+	I2C_AdaptEnd(I2Cx);
+	return 0;
+
+error:
+	SET(I2C->CR1, I2C_CR1_STOP_BIT);
+	I2C_StatsEnd(I2Cx);
+	I2C_AdaptEnd(I2Cx);
+	RESET(I2C->CR1, I2C_CR1_POS_BIT);
+	RESET(I2C->SR1, I2C_SR1_AF_BIT);
+	return 1;
+}
+
+void I2C_GetStats(I2CPeripheral I2Cx, I2C_Stats *stats) {
+#if I2C_STATS_ENABLE
+	*stats = I2C_Stat[I2Cx];
+#else
+	u8 *p = (u8 *) stats;
+	u16 i;
+
+	for (i = 0; i < sizeof(*stats); i++) {
+		p[i] = 0;
+	}
+	(void) I2Cx;
+#endif
+}
+
+void I2C_ResetStats(I2CPeripheral I2Cx) {
+#if I2C_STATS_ENABLE
+	I2C_Stats zero = { 0 };
+
+	I2C_Stat[I2Cx] = zero;
+#else
+	(void) I2Cx;
+#endif
+}
+
+void I2C_SetStatsClock(u32 (*clock)(void)) {
+#if I2C_STATS_ENABLE
+	I2C_StatsClock = clock ? clock : I2C_DwtClock;
+#else
+	(void) clock;
+#endif
+}
+
+u16 I2C_GetSpeed(I2CPeripheral I2Cx) {
+	return I2C_SpeedMap[I2C_Adapt[I2Cx].Level].Khz;
+}
+
+void I2C_GetErrors(I2CPeripheral I2Cx, I2C_Errors *errors) {
+	*errors = I2C_Adapt[I2Cx].Count;
+}
+
+void I2C_ResetErrors(I2CPeripheral I2Cx) {
+	I2C_Errors zero = { 0 };
+
+	I2C_Adapt[I2Cx].Count = zero;
+}
+
+/* Event and error interrupts of peripheral reach the core */
+static void I2C_EnableIrq(I2CPeripheral I2Cx) {
+	I2C_NVIC_ISER[I2C_EV_IRQ(I2Cx) >> 5] = 1UL << (I2C_EV_IRQ(I2Cx) & 31);
+	I2C_NVIC_ISER[I2C_ER_IRQ(I2Cx) >> 5] = 1UL << (I2C_ER_IRQ(I2Cx) & 31);
+}
+
+/* Ends background transaction, caller is told from here */
+static void I2C_MasterFinish(I2CPeripheral I2Cx, u8 error) {
+	I2C_RegDef_t *I2C = I2C_REGS(I2Cx);
+	I2C_MasterDef_t *master = &I2C_Master[I2Cx];
+
+	if (I2C_Slave[I2Cx].Enabled) {
+		/* Slave interrupts stay on, own address is ACKed again.
+		 * Buffer interrupt was turned off for the last BTF, slave bytes need it */
+		SET(I2C->CR1, I2C_CR1_ACK_BIT);
+		I2C->CR2 |= (1UL << I2C_CR2_ITERREN_BIT) | (1UL << I2C_CR2_ITEVTEN_BIT)
+				| (1UL << I2C_CR2_ITBUFEN_BIT);
 	} else {
-		if (I2Cx == I2C1) {
-			while (remaining > 2) {
-				while (((GET(I2C1_SR1_REG, 6)) == 0))
-					; // wait for RxNE to set
+		I2C->CR2 &= ~((1UL << I2C_CR2_ITERREN_BIT) | (1UL << I2C_CR2_ITEVTEN_BIT)
+				| (1UL << I2C_CR2_ITBUFEN_BIT));
+	}
+	if (master->Receiving && !error) {
+		I2C_StatsBytes(I2Cx, master->RxLen);
+	}
+	I2C_StatsEnd(I2Cx);
+	I2C_AdaptEnd(I2Cx);
+#if I2C_STATS_ENABLE
+	I2C_Stat[I2Cx].Failures += error;
+#endif
+
+	/* Done may start next transaction */
+	master->Busy = 0;
+	if (master->Done) {
+		master->Done(master->Context, error);
+	}
+}
+
+/* Starts background transaction, interrupts take over after START */
+static u8 I2C_MasterStart(I2CPeripheral I2Cx, u8 address, u8 reg, u8 hasreg,
+		const u8 *tx, u16 txlen, u8 *rx, u16 rxlen, I2C_DoneCallback done,
+		void *context) {
+	I2C_RegDef_t *I2C = I2C_REGS(I2Cx);
+	I2C_MasterDef_t *master = &I2C_Master[I2Cx];
+	u32 timeout = I2C_TIMEOUT;
+
+	if (master->Busy) {
+		return 1;
+	}
+	master->Tx = tx;
+	master->TxLen = txlen;
+	master->Rx = rx;
+	master->RxLen = rxlen;
+	master->Index = 0;
+	master->Address = address;
+	master->Reg = reg;
+	master->HasReg = hasreg;
+	master->Receiving = !hasreg && !txlen;
+	master->Addressed = 0;
+	master->Done = done;
+	master->Context = context;
+	master->Busy = 1;
+
+	I2C_StatsStart(I2Cx);
+	if (master->Receiving && !rxlen) {
+		/* Nothing to transfer */
+		I2C_MasterFinish(I2Cx, 0);
+		return 0;
+	}
 
-				buffer[size - remaining] = I2C1_DR_REG; // copy the data into the buffer
+	/* TXE and BTF of last transaction stay set until its STOP went out */
+	while (GET(I2C->CR1, I2C_CR1_STOP_BIT) && --timeout)
+		;
+	I2C_AdaptApply(I2Cx);
 
-				SET(I2C1_CR1_REG, 10); // Set the ACK bit to Acknowledge the data received
-				remaining--;
+	SET(I2C->CR1, I2C_CR1_ACK_BIT);
+	SET(I2C->CR1, I2C_CR1_START_BIT);		//GENERATE START
+	I2C->CR2 |= (1UL << I2C_CR2_ITERREN_BIT) | (1UL << I2C_CR2_ITEVTEN_BIT)
+			| (1UL << I2C_CR2_ITBUFEN_BIT);
+	I2C_EnableIrq(I2Cx);
+	return 0;
+}
+
+u8 I2C_WriteMultiAsync(I2CPeripheral I2Cx, u8 address, u8 reg,
+		const u8 *data, u16 count, I2C_DoneCallback done, void *context) {
+	return I2C_MasterStart(I2Cx, address, reg, 1, data, count, 0, 0, done,
+			context);
+}
+
+u8 I2C_WriteReadAsync(I2CPeripheral I2Cx, u8 address, const u8 *tx,
+		u16 txlen, u8 *rx, u16 rxlen, I2C_DoneCallback done, void *context) {
+	return I2C_MasterStart(I2Cx, address, 0, 0, tx, txlen, rx, rxlen, done,
+			context);
+}
+
+u8 I2C_Busy(I2CPeripheral I2Cx) {
+	return I2C_Master[I2Cx].Busy;
+}
+
+/* One step of background transaction, same sequences as I2C_WriteRead */
+static void I2C_MasterEvent(I2CPeripheral I2Cx) {
+	I2C_RegDef_t *I2C = I2C_REGS(I2Cx);
+	I2C_MasterDef_t *master = &I2C_Master[I2Cx];
+	u32 sr1 = I2C->SR1;
+	u16 left;
+
+	if (GET(sr1, I2C_SR1_SB_BIT)) {
+		/* SR1 read then DR write clears SB */
+		if (!master->Receiving) {
+			I2C->DR = master->Address & ~1;
+		} else {
+			if (master->RxLen == 2) {
+				/* ACK/NACK applies to the byte after the one in shift register */
+				SET(I2C->CR1, I2C_CR1_POS_BIT);
+			}
+			I2C->DR = master->Address | 1;
+		}
+	} else if (GET(sr1, I2C_SR1_ADDR_BIT)) {
+		master->Addressed = 1;
+		if (!master->Receiving) {
+			I2C_ClearAddr(I2C);
+		} else if (master->RxLen == 1) {
+			/* NACK must be programmed before ADDR is cleared */
+			RESET(I2C->CR1, I2C_CR1_ACK_BIT);
+			I2C_ClearAddr(I2C);
+			SET(I2C->CR1, I2C_CR1_STOP_BIT);
+			SET(I2C->CR2, I2C_CR2_ITBUFEN_BIT);		//BYTE COMES WITH RXNE
+		} else if (master->RxLen == 2) {
+			I2C_ClearAddr(I2C);
+			RESET(I2C->CR1, I2C_CR1_ACK_BIT);
+			RESET(I2C->CR2, I2C_CR2_ITBUFEN_BIT);	//BOTH BYTES ARE TAKEN AT BTF
+		} else if (master->RxLen == 3) {
+			I2C_ClearAddr(I2C);
+			RESET(I2C->CR2, I2C_CR2_ITBUFEN_BIT);	//LAST 3 BYTES ARE TAKEN AT BTF
+		} else {
+			I2C_ClearAddr(I2C);
+			SET(I2C->CR2, I2C_CR2_ITBUFEN_BIT);		//BYTES COME WITH RXNE
+		}
+	} else if (!master->Addressed) {
+		/* TXE and BTF of write phase stay set until repeated START went out */
+	} else if (!master->Receiving) {
+		if (master->HasReg || master->Index < master->TxLen) {
+			if (GET(sr1, I2C_SR1_TXE_BIT)) {
+				if (master->HasReg) {
+					I2C->DR = master->Reg;
+					master->HasReg = 0;
+				} else {
+					I2C->DR = master->Tx[master->Index++];
+				}
+				I2C_StatsBytes(I2Cx, 1);
+				if (master->Index == master->TxLen && !master->HasReg) {
+					RESET(I2C->CR2, I2C_CR2_ITBUFEN_BIT);	//WAIT FOR BTF NOW
+				}
 			}
-			// Read the  SECOND LAST BYTE
-			while (((GET(I2C1_SR1_REG, 6)) == 0))
-				; // wait for RxNE to set
-			buffer[size - remaining] = I2C1_DR_REG; // copy the data into the buffer
-			RESET(I2C1_CR1_REG, 10);
-			I2C_Stop(I2C1);
-			remaining--;
-			while (((GET(I2C1_SR1_REG, 6)) == 0))
-				; // wait for RxNE to set
-			buffer[size - remaining] = I2C1_DR_REG; // copy the data into the buffer
-
-		} else if (I2Cx == I2C2) {
-			while (remaining > 2) {
-				while (((GET(I2C2_SR1_REG, 6)) == 0))
-					; // wait for RxNE to set
-
-				buffer[size - remaining] = I2C2_DR_REG; // copy the data into the buffer
-
-				SET(I2C2_CR1_REG, 10); // Set the ACK bit to Acknowledge the data received
-				remaining--;
+		} else if (GET(sr1, I2C_SR1_BTF_BIT)) {
+			/* Last byte left shift register */
+			if (master->RxLen) {
+				master->Receiving = 1;
+				master->Addressed = 0;
+				master->Index = 0;
+				SET(I2C->CR1, I2C_CR1_ACK_BIT);
+				SET(I2C->CR1, I2C_CR1_START_BIT);		//REPEATED START
+			} else {
+				SET(I2C->CR1, I2C_CR1_STOP_BIT);
+				I2C_MasterFinish(I2Cx, 0);
 			}
-			// Read the  SECOND LAST BYTE
-			while (((GET(I2C2_SR1_REG, 6)) == 0))
-				; // wait for RxNE to set
-			buffer[size - remaining] = I2C2_DR_REG; // copy the data into the buffer
-			RESET(I2C2_CR1_REG, 10);
-			I2C_Stop(I2C2);
-			remaining--;
-			while (((GET(I2C2_SR1_REG, 6)) == 0))
-				; // wait for RxNE to set
-			buffer[size - remaining] = I2C2_DR_REG; // copy the data into the buffer
+		}
+	} else {
+		left = master->RxLen - master->Index;
+		if (master->RxLen == 2) {
+			if (GET(sr1, I2C_SR1_BTF_BIT)) {
+				/* Byte 1 in DR, byte 2 in shift register */
+				SET(I2C->CR1, I2C_CR1_STOP_BIT);
+				master->Rx[0] = I2C->DR;
+				master->Rx[1] = I2C->DR;
+				RESET(I2C->CR1, I2C_CR1_POS_BIT);
+				I2C_MasterFinish(I2Cx, 0);
+			}
+		} else if (left > 3) {
+			if (GET(sr1, I2C_SR1_RXNE_BIT)) {
+				master->Rx[master->Index++] = I2C->DR;
+				if (left == 4) {
+					RESET(I2C->CR2, I2C_CR2_ITBUFEN_BIT);	//LAST 3 BYTES ARE TAKEN AT BTF
+				}
+			}
+		} else if (left == 3) {
+			if (GET(sr1, I2C_SR1_BTF_BIT)) {
+				/* Byte N-2 in DR, byte N-1 in shift register, bus is stretched */
+				RESET(I2C->CR1, I2C_CR1_ACK_BIT);
+				master->Rx[master->Index++] = I2C->DR;
+			}
+		} else if (left == 2) {
+			if (GET(sr1, I2C_SR1_BTF_BIT)) {
+				SET(I2C->CR1, I2C_CR1_STOP_BIT);
+				master->Rx[master->Index++] = I2C->DR;
+				SET(I2C->CR2, I2C_CR2_ITBUFEN_BIT);		//LAST BYTE COMES WITH RXNE
+			}
+		} else if (GET(sr1, I2C_SR1_RXNE_BIT)) {
+			master->Rx[master->Index++] = I2C->DR;
+			I2C_MasterFinish(I2Cx, 0);
+		}
+	}
+}
+
+/* NACK or bus error ends background transaction */
+static void I2C_MasterError(I2CPeripheral I2Cx) {
+	I2C_RegDef_t *I2C = I2C_REGS(I2Cx);
+	u32 sr1 = I2C->SR1;
 
+	/* NACK BEFORE ADDR IS AN ABSENT DEVICE */
+	if (sr1 & I2C_SR1_FAULTS) {
+		I2C_CountError(I2Cx, sr1, !I2C_Master[I2Cx].Addressed);
+	}
+
+	/* Error flags are cleared by writing 0 */
+	I2C->SR1 &= ~((1UL << I2C_SR1_BERR_BIT) | (1UL << I2C_SR1_ARLO_BIT)
+			| (1UL << I2C_SR1_AF_BIT) | (1UL << I2C_SR1_OVR_BIT));
+	if (!GET(sr1, I2C_SR1_ARLO_BIT)) {
+		/* After lost arbitration peripheral is slave, bus belongs to winner */
+		SET(I2C->CR1, I2C_CR1_STOP_BIT);
+	}
+	RESET(I2C->CR1, I2C_CR1_POS_BIT);
+	I2C_MasterFinish(I2Cx, 1);
+}
+
+/* Bytes stored in ring */
+static u16 I2C_RingCount(const I2C_Ring_t *ring) {
+	return (ring->Head - ring->Tail) & ring->Mask;
+}
+
+void I2C_SlaveInit(I2CPeripheral I2Cx, u8 address1,
+		I2C_DUAL_ADDRESSING_MODE DAddMode, u8 address2,
+		I2C_SlaveCallback callback) {
+	I2C_RegDef_t *I2C = I2C_REGS(I2Cx);
+	I2C_SlaveDef_t *slave = &I2C_Slave[I2Cx];
+
+	slave->Rx.Buffer = I2C_SlaveRxBuffer[I2Cx];
+	slave->Rx.Mask = I2C_SLAVE_RX_SIZE - 1;
+	slave->Rx.Head = 0;
+	slave->Rx.Tail = 0;
+	slave->Tx.Buffer = I2C_SlaveTxBuffer[I2Cx];
+	slave->Tx.Mask = I2C_SLAVE_TX_SIZE - 1;
+	slave->Tx.Head = 0;
+	slave->Tx.Tail = 0;
+	slave->Callback = callback;
+	slave->Receiving = 0;
+	slave->Enabled = 1;
+	slave->Overflow = 0;
+
+	I2C_Init(I2Cx);		//CLOCKS, PINS, TIMING, PE AND ACK
+
+	I2C->OAR1 = (address1 & 0xFE) | (1UL << I2C_OAR1_MUST_BE_ONE_BIT);
+	I2C->OAR2 = (address2 & 0xFE) | ((u32)DAddMode << I2C_OAR2_ENDUAL_BIT);
+
+	SET(I2C->CR2, I2C_CR2_ITERREN_BIT);
+	SET(I2C->CR2, I2C_CR2_ITEVTEN_BIT);
+	SET(I2C->CR2, I2C_CR2_ITBUFEN_BIT);		//RXNE AND TXE ALSO INTERRUPT
+
+	I2C_EnableIrq(I2Cx);
+}
+
+u16 I2C_SlaveAvailable(I2CPeripheral I2Cx) {
+	return I2C_RingCount(&I2C_Slave[I2Cx].Rx);
+}
+
+u16 I2C_SlaveRead(I2CPeripheral I2Cx, u8 *data, u16 size) {
+	I2C_Ring_t *ring = &I2C_Slave[I2Cx].Rx;
+	u16 tail = ring->Tail;
+	u16 i;
+
+	for (i = 0; i < size && tail != ring->Head; i++) {
+		data[i] = ring->Buffer[tail];
+		tail = (tail + 1) & ring->Mask;
+	}
+	/* Slot is given back to interrupt only after byte was copied */
+	ring->Tail = tail;
+
+	return i;
+}
+
+u16 I2C_SlaveWrite(I2CPeripheral I2Cx, const u8 *data, u16 size) {
+	I2C_Ring_t *ring = &I2C_Slave[I2Cx].Tx;
+	u16 head = ring->Head;
+	u16 next;
+	u16 i;
+
+	for (i = 0; i < size; i++) {
+		next = (head + 1) & ring->Mask;
+		if (next == ring->Tail) {
+			break;
+		}
+		ring->Buffer[head] = data[i];
+		head = next;
+	}
+	/* Byte is visible to interrupt only after it was stored */
+	ring->Head = head;
+
+	return i;
+}
+
+u32 I2C_SlaveOverflow(I2CPeripheral I2Cx) {
+	return I2C_Slave[I2Cx].Overflow;
+}
+
+/* Address match, data byte and STOP events of slave */
+static void I2C_SlaveEvent(I2CPeripheral I2Cx) {
+	I2C_RegDef_t *I2C = I2C_REGS(I2Cx);
+	I2C_SlaveDef_t *slave = &I2C_Slave[I2Cx];
+	u32 sr1 = I2C->SR1;
+	u32 sr2;
+	u16 next;
+	u8 data;
+
+	/* Byte still in DR next to ADDR is the last one of the previous write */
+	if (GET(sr1, I2C_SR1_RXNE_BIT)) {
+		data = I2C->DR;
+		next = (slave->Rx.Head + 1) & slave->Rx.Mask;
+		if (next == slave->Rx.Tail) {
+			/* Byte is ACKed anyway, stretching here would stall the master */
+			slave->Overflow++;
+		} else {
+			slave->Rx.Buffer[slave->Rx.Head] = data;
+			slave->Rx.Head = next;
+			slave->Length++;
+		}
+	}
+
+	if (GET(sr1, I2C_SR1_ADDR_BIT)) {
+		/* Repeated START ends write frame without STOP */
+		if (slave->Receiving && slave->Length && slave->Callback) {
+			slave->Callback(slave->Dual, slave->Length);
 		}
+
+		/* Reading SR2 after SR1 clears ADDR, SR2 tells direction and matched address */
+		sr2 = I2C->SR2;
+		slave->Dual = GET(sr2, I2C_SR2_DUALF_BIT);
+		slave->Receiving = !GET(sr2, I2C_SR2_TRA_BIT);
+		slave->Length = 0;
+		sr1 = I2C->SR1;
 	}
 
-	return buffer;
+	if (GET(sr1, I2C_SR1_TXE_BIT)) {
+		if (slave->Tx.Tail != slave->Tx.Head) {
+			I2C->DR = slave->Tx.Buffer[slave->Tx.Tail];
+			slave->Tx.Tail = (slave->Tx.Tail + 1) & slave->Tx.Mask;
+		} else {
+			I2C->DR = I2C_SLAVE_IDLE_BYTE;
+		}
+	}
+
+	if (GET(sr1, I2C_SR1_STOPF_BIT)) {
+		/* Reading SR1 then writing CR1 clears STOPF */
+		I2C->CR1 = I2C->CR1;
+		if (slave->Receiving && slave->Callback) {
+			slave->Callback(slave->Dual, slave->Length);
+		}
+		slave->Receiving = 0;
+	}
+}
+
+/* Bus errors of slave, NACK from master ends its read */
+static void I2C_SlaveError(I2CPeripheral I2Cx) {
+	I2C_RegDef_t *I2C = I2C_REGS(I2Cx);
+
+	/* Error flags are cleared by writing 0 */
+	I2C->SR1 &= ~((1UL << I2C_SR1_BERR_BIT) | (1UL << I2C_SR1_ARLO_BIT)
+			| (1UL << I2C_SR1_AF_BIT) | (1UL << I2C_SR1_OVR_BIT));
+}
+
+/* Same interrupts serve background master and slave mode */
+void I2C1_EV_IRQHandler(void) {
+	if (I2C_Master[I2C1].Busy) {
+		I2C_MasterEvent(I2C1);
+	} else {
+		I2C_SlaveEvent(I2C1);
+	}
+}
+
+void I2C1_ER_IRQHandler(void) {
+	if (I2C_Master[I2C1].Busy) {
+		I2C_MasterError(I2C1);
+	} else {
+		I2C_SlaveError(I2C1);
+	}
+}
+
+void I2C2_EV_IRQHandler(void) {
+	if (I2C_Master[I2C2].Busy) {
+		I2C_MasterEvent(I2C2);
+	} else {
+		I2C_SlaveEvent(I2C2);
+	}
+}
+
+void I2C2_ER_IRQHandler(void) {
+	if (I2C_Master[I2C2].Busy) {
+		I2C_MasterError(I2C2);
+	} else {
+		I2C_SlaveError(I2C2);
+	}
 }
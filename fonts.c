@@ -28,319 +28,370 @@
  */
 #include "fonts.h"
 
-const uint16_t Font7x10 [] = {
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,  // sp
-0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x0000, 0x1000, 0x0000, 0x0000,  // !
-0x2800, 0x2800, 0x2800, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,  // "
-0x2400, 0x2400, 0x7C00, 0x2400, 0x4800, 0x7C00, 0x4800, 0x4800, 0x0000, 0x0000,  // #
-0x3800, 0x5400, 0x5000, 0x3800, 0x1400, 0x5400, 0x5400, 0x3800, 0x1000, 0x0000,  // $
-0x2000, 0x5400, 0x5800, 0x3000, 0x2800, 0x5400, 0x1400, 0x0800, 0x0000, 0x0000,  // %
-0x1000, 0x2800, 0x2800, 0x1000, 0x3400, 0x4800, 0x4800, 0x3400, 0x0000, 0x0000,  // &
-0x1000, 0x1000, 0x1000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,  // '
-0x0800, 0x1000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x1000, 0x0800,  // (
-0x2000, 0x1000, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x1000, 0x2000,  // )
-0x1000, 0x3800, 0x1000, 0x2800, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,  // *
-0x0000, 0x0000, 0x1000, 0x1000, 0x7C00, 0x1000, 0x1000, 0x0000, 0x0000, 0x0000,  // +
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x1000, 0x1000, 0x1000,  // ,
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3800, 0x0000, 0x0000, 0x0000, 0x0000,  // -
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x1000, 0x0000, 0x0000,  // .
-0x0800, 0x0800, 0x1000, 0x1000, 0x1000, 0x1000, 0x2000, 0x2000, 0x0000, 0x0000,  // /
-0x3800, 0x4400, 0x4400, 0x5400, 0x4400, 0x4400, 0x4400, 0x3800, 0x0000, 0x0000,  // 0
-0x1000, 0x3000, 0x5000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x0000, 0x0000,  // 1
-0x3800, 0x4400, 0x4400, 0x0400, 0x0800, 0x1000, 0x2000, 0x7C00, 0x0000, 0x0000,  // 2
-0x3800, 0x4400, 0x0400, 0x1800, 0x0400, 0x0400, 0x4400, 0x3800, 0x0000, 0x0000,  // 3
-0x0800, 0x1800, 0x2800, 0x2800, 0x4800, 0x7C00, 0x0800, 0x0800, 0x0000, 0x0000,  // 4
-0x7C00, 0x4000, 0x4000, 0x7800, 0x0400, 0x0400, 0x4400, 0x3800, 0x0000, 0x0000,  // 5
-0x3800, 0x4400, 0x4000, 0x7800, 0x4400, 0x4400, 0x4400, 0x3800, 0x0000, 0x0000,  // 6
-0x7C00, 0x0400, 0x0800, 0x1000, 0x1000, 0x2000, 0x2000, 0x2000, 0x0000, 0x0000,  // 7
-0x3800, 0x4400, 0x4400, 0x3800, 0x4400, 0x4400, 0x4400, 0x3800, 0x0000, 0x0000,  // 8
-0x3800, 0x4400, 0x4400, 0x4400, 0x3C00, 0x0400, 0x4400, 0x3800, 0x0000, 0x0000,  // 9
-0x0000, 0x0000, 0x1000, 0x0000, 0x0000, 0x0000, 0x0000, 0x1000, 0x0000, 0x0000,  // :
-0x0000, 0x0000, 0x0000, 0x1000, 0x0000, 0x0000, 0x0000, 0x1000, 0x1000, 0x1000,  // ;
-0x0000, 0x0000, 0x0C00, 0x3000, 0x4000, 0x3000, 0x0C00, 0x0000, 0x0000, 0x0000,  // <
-0x0000, 0x0000, 0x0000, 0x7C00, 0x0000, 0x7C00, 0x0000, 0x0000, 0x0000, 0x0000,  // =
-0x0000, 0x0000, 0x6000, 0x1800, 0x0400, 0x1800, 0x6000, 0x0000, 0x0000, 0x0000,  // >
-0x3800, 0x4400, 0x0400, 0x0800, 0x1000, 0x1000, 0x0000, 0x1000, 0x0000, 0x0000,  // ?
-0x3800, 0x4400, 0x4C00, 0x5400, 0x5C00, 0x4000, 0x4000, 0x3800, 0x0000, 0x0000,  // @
-0x1000, 0x2800, 0x2800, 0x2800, 0x2800, 0x7C00, 0x4400, 0x4400, 0x0000, 0x0000,  // A
-0x7800, 0x4400, 0x4400, 0x7800, 0x4400, 0x4400, 0x4400, 0x7800, 0x0000, 0x0000,  // B
-0x3800, 0x4400, 0x4000, 0x4000, 0x4000, 0x4000, 0x4400, 0x3800, 0x0000, 0x0000,  // C
-0x7000, 0x4800, 0x4400, 0x4400, 0x4400, 0x4400, 0x4800, 0x7000, 0x0000, 0x0000,  // D
-0x7C00, 0x4000, 0x4000, 0x7C00, 0x4000, 0x4000, 0x4000, 0x7C00, 0x0000, 0x0000,  // E
-0x7C00, 0x4000, 0x4000, 0x7800, 0x4000, 0x4000, 0x4000, 0x4000, 0x0000, 0x0000,  // F
-0x3800, 0x4400, 0x4000, 0x4000, 0x5C00, 0x4400, 0x4400, 0x3800, 0x0000, 0x0000,  // G
-0x4400, 0x4400, 0x4400, 0x7C00, 0x4400, 0x4400, 0x4400, 0x4400, 0x0000, 0x0000,  // H
-0x3800, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x3800, 0x0000, 0x0000,  // I
-0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x4400, 0x3800, 0x0000, 0x0000,  // J
-0x4400, 0x4800, 0x5000, 0x6000, 0x5000, 0x4800, 0x4800, 0x4400, 0x0000, 0x0000,  // K
-0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x7C00, 0x0000, 0x0000,  // L
-0x4400, 0x6C00, 0x6C00, 0x5400, 0x4400, 0x4400, 0x4400, 0x4400, 0x0000, 0x0000,  // M
-0x4400, 0x6400, 0x6400, 0x5400, 0x5400, 0x4C00, 0x4C00, 0x4400, 0x0000, 0x0000,  // N
-0x3800, 0x4400, 0x4400, 0x4400, 0x4400, 0x4400, 0x4400, 0x3800, 0x0000, 0x0000,  // O
-0x7800, 0x4400, 0x4400, 0x4400, 0x7800, 0x4000, 0x4000, 0x4000, 0x0000, 0x0000,  // P
-0x3800, 0x4400, 0x4400, 0x4400, 0x4400, 0x4400, 0x5400, 0x3800, 0x0400, 0x0000,  // Q
-0x7800, 0x4400, 0x4400, 0x4400, 0x7800, 0x4800, 0x4800, 0x4400, 0x0000, 0x0000,  // R
-0x3800, 0x4400, 0x4000, 0x3000, 0x0800, 0x0400, 0x4400, 0x3800, 0x0000, 0x0000,  // S
-0x7C00, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x0000, 0x0000,  // T
-0x4400, 0x4400, 0x4400, 0x4400, 0x4400, 0x4400, 0x4400, 0x3800, 0x0000, 0x0000,  // U
-0x4400, 0x4400, 0x4400, 0x2800, 0x2800, 0x2800, 0x1000, 0x1000, 0x0000, 0x0000,  // V
-0x4400, 0x4400, 0x5400, 0x5400, 0x5400, 0x6C00, 0x2800, 0x2800, 0x0000, 0x0000,  // W
-0x4400, 0x2800, 0x2800, 0x1000, 0x1000, 0x2800, 0x2800, 0x4400, 0x0000, 0x0000,  // X
-0x4400, 0x4400, 0x2800, 0x2800, 0x1000, 0x1000, 0x1000, 0x1000, 0x0000, 0x0000,  // Y
-0x7C00, 0x0400, 0x0800, 0x1000, 0x1000, 0x2000, 0x4000, 0x7C00, 0x0000, 0x0000,  // Z
-0x1800, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1800,  // [
-0x2000, 0x2000, 0x1000, 0x1000, 0x1000, 0x1000, 0x0800, 0x0800, 0x0000, 0x0000,  /* \ */
-0x3000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x3000,  // ]
-0x1000, 0x2800, 0x2800, 0x4400, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,  // ^
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xFE00,  // _
-0x2000, 0x1000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,  // `
-0x0000, 0x0000, 0x3800, 0x4400, 0x3C00, 0x4400, 0x4C00, 0x3400, 0x0000, 0x0000,  // a
-0x4000, 0x4000, 0x5800, 0x6400, 0x4400, 0x4400, 0x6400, 0x5800, 0x0000, 0x0000,  // b
-0x0000, 0x0000, 0x3800, 0x4400, 0x4000, 0x4000, 0x4400, 0x3800, 0x0000, 0x0000,  // c
-0x0400, 0x0400, 0x3400, 0x4C00, 0x4400, 0x4400, 0x4C00, 0x3400, 0x0000, 0x0000,  // d
-0x0000, 0x0000, 0x3800, 0x4400, 0x7C00, 0x4000, 0x4400, 0x3800, 0x0000, 0x0000,  // e
-0x0C00, 0x1000, 0x7C00, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x0000, 0x0000,  // f
-0x0000, 0x0000, 0x3400, 0x4C00, 0x4400, 0x4400, 0x4C00, 0x3400, 0x0400, 0x7800,  // g
-0x4000, 0x4000, 0x5800, 0x6400, 0x4400, 0x4400, 0x4400, 0x4400, 0x0000, 0x0000,  // h
-0x1000, 0x0000, 0x7000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x0000, 0x0000,  // i
-0x1000, 0x0000, 0x7000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0xE000,  // j
-0x4000, 0x4000, 0x4800, 0x5000, 0x6000, 0x5000, 0x4800, 0x4400, 0x0000, 0x0000,  // k
-0x7000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x0000, 0x0000,  // l
-0x0000, 0x0000, 0x7800, 0x5400, 0x5400, 0x5400, 0x5400, 0x5400, 0x0000, 0x0000,  // m
-0x0000, 0x0000, 0x5800, 0x6400, 0x4400, 0x4400, 0x4400, 0x4400, 0x0000, 0x0000,  // n
-0x0000, 0x0000, 0x3800, 0x4400, 0x4400, 0x4400, 0x4400, 0x3800, 0x0000, 0x0000,  // o
-0x0000, 0x0000, 0x5800, 0x6400, 0x4400, 0x4400, 0x6400, 0x5800, 0x4000, 0x4000,  // p
-0x0000, 0x0000, 0x3400, 0x4C00, 0x4400, 0x4400, 0x4C00, 0x3400, 0x0400, 0x0400,  // q
-0x0000, 0x0000, 0x5800, 0x6400, 0x4000, 0x4000, 0x4000, 0x4000, 0x0000, 0x0000,  // r
-0x0000, 0x0000, 0x3800, 0x4400, 0x3000, 0x0800, 0x4400, 0x3800, 0x0000, 0x0000,  // s
-0x2000, 0x2000, 0x7800, 0x2000, 0x2000, 0x2000, 0x2000, 0x1800, 0x0000, 0x0000,  // t
-0x0000, 0x0000, 0x4400, 0x4400, 0x4400, 0x4400, 0x4C00, 0x3400, 0x0000, 0x0000,  // u
-0x0000, 0x0000, 0x4400, 0x4400, 0x2800, 0x2800, 0x2800, 0x1000, 0x0000, 0x0000,  // v
-0x0000, 0x0000, 0x5400, 0x5400, 0x5400, 0x6C00, 0x2800, 0x2800, 0x0000, 0x0000,  // w
-0x0000, 0x0000, 0x4400, 0x2800, 0x1000, 0x1000, 0x2800, 0x4400, 0x0000, 0x0000,  // x
-0x0000, 0x0000, 0x4400, 0x4400, 0x2800, 0x2800, 0x1000, 0x1000, 0x1000, 0x6000,  // y
-0x0000, 0x0000, 0x7C00, 0x0800, 0x1000, 0x2000, 0x4000, 0x7C00, 0x0000, 0x0000,  // z
-0x1800, 0x1000, 0x1000, 0x1000, 0x2000, 0x2000, 0x1000, 0x1000, 0x1000, 0x1800,  // {
-0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,  // |
-0x3000, 0x1000, 0x1000, 0x1000, 0x0800, 0x0800, 0x1000, 0x1000, 0x1000, 0x3000,  // }
-0x0000, 0x0000, 0x0000, 0x7400, 0x4C00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,  // ~
+/* Glyph tables of ASCII 32 - 126, packed by tools/ssd1306_fontpack.c, see @ref FontDef_t.
+ * Font7x10 also has U+00B0 degree, U+00B1 plus-minus, U+00B5 micro and U+2190 - U+2193 arrows */
+const uint8_t Font7x10 [] = {
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // sp
+0x00, 0x00, 0x00, 0xC0, 0x2F, 0x00, 0x00, 0x00, 0x00,  // !
+0x00, 0x00, 0x70, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,  // "
+0x00, 0xD0, 0xF3, 0x02, 0x09, 0xF4, 0xBC, 0x00, 0x00,  // #
+0x00, 0x98, 0x91, 0xC8, 0x7F, 0x89, 0xC8, 0x01, 0x00,  // $
+0x00, 0x98, 0x90, 0x81, 0x1B, 0x94, 0x88, 0x01, 0x00,  // %
+0x00, 0x80, 0x61, 0x49, 0x26, 0x66, 0x40, 0x02, 0x00,  // &
+0x00, 0x00, 0x00, 0xC0, 0x01, 0x00, 0x00, 0x00, 0x00,  // '
+0x00, 0x00, 0xC0, 0x8F, 0x40, 0x01, 0x02, 0x00, 0x00,  // (
+0x00, 0x00, 0x10, 0xA0, 0x40, 0xFC, 0x00, 0x00, 0x00,  // )
+0x00, 0x00, 0xA0, 0xC0, 0x01, 0x0A, 0x00, 0x00, 0x00,  // *
+0x00, 0x40, 0x00, 0x01, 0x1F, 0x10, 0x40, 0x00, 0x00,  // +
+0x00, 0x00, 0x00, 0x00, 0xE0, 0x00, 0x00, 0x00, 0x00,  // ,
+0x00, 0x00, 0x00, 0x02, 0x08, 0x20, 0x00, 0x00, 0x00,  // -
+0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00,  // .
+0x00, 0x00, 0x00, 0x0C, 0x0F, 0x03, 0x00, 0x00, 0x00,  // /
+0x00, 0xF8, 0x11, 0x48, 0x22, 0x81, 0xF8, 0x01, 0x00,  // 0
+0x00, 0x10, 0x20, 0xC0, 0x3F, 0x00, 0x00, 0x00, 0x00,  // 1
+0x00, 0x18, 0x12, 0x4C, 0x28, 0x91, 0x38, 0x02, 0x00,  // 2
+0x00, 0x08, 0x11, 0x48, 0x22, 0x89, 0xD8, 0x01, 0x00,  // 3
+0x00, 0xC0, 0xC0, 0x82, 0x08, 0xFF, 0x80, 0x00, 0x00,  // 4
+0x00, 0x3C, 0x91, 0x48, 0x22, 0x89, 0xC4, 0x01, 0x00,  // 5
+0x00, 0xF8, 0x91, 0x48, 0x22, 0x89, 0xC8, 0x01, 0x00,  // 6
+0x00, 0x04, 0x10, 0x4E, 0x06, 0x05, 0x0C, 0x00, 0x00,  // 7
+0x00, 0xD8, 0x91, 0x48, 0x22, 0x89, 0xD8, 0x01, 0x00,  // 8
+0x00, 0x38, 0x11, 0x49, 0x24, 0x91, 0xF8, 0x01, 0x00,  // 9
+0x00, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00, 0x00,  // :
+0x00, 0x00, 0x00, 0x00, 0xE2, 0x00, 0x00, 0x00, 0x00,  // ;
+0x00, 0x40, 0x80, 0x02, 0x0A, 0x44, 0x10, 0x01, 0x00,  // <
+0x00, 0xA0, 0x80, 0x02, 0x0A, 0x28, 0xA0, 0x00, 0x00,  // =
+0x00, 0x10, 0x41, 0x04, 0x0A, 0x28, 0x40, 0x00, 0x00,  // >
+0x00, 0x08, 0x10, 0x40, 0x2C, 0x09, 0x18, 0x00, 0x00,  // ?
+0x00, 0xF8, 0x11, 0x48, 0x26, 0x95, 0x78, 0x00, 0x00,  // @
+0x00, 0x80, 0xE3, 0x43, 0x08, 0x3E, 0x80, 0x03, 0x00,  // A
+0x00, 0xFC, 0x93, 0x48, 0x22, 0x89, 0xD8, 0x01, 0x00,  // B
+0x00, 0xF8, 0x11, 0x48, 0x20, 0x81, 0x08, 0x01, 0x00,  // C
+0x00, 0xFC, 0x13, 0x48, 0x20, 0x42, 0xF0, 0x00, 0x00,  // D
+0x00, 0xFC, 0x93, 0x48, 0x22, 0x89, 0x24, 0x02, 0x00,  // E
+0x00, 0xFC, 0x93, 0x40, 0x02, 0x09, 0x04, 0x00, 0x00,  // F
+0x00, 0xF8, 0x11, 0x48, 0x24, 0x91, 0xC8, 0x01, 0x00,  // G
+0x00, 0xFC, 0x83, 0x00, 0x02, 0x08, 0xFC, 0x03, 0x00,  // H
+0x00, 0x00, 0x10, 0xC8, 0x3F, 0x81, 0x00, 0x00, 0x00,  // I
+0x00, 0x00, 0x01, 0x08, 0x20, 0x80, 0xFC, 0x01, 0x00,  // J
+0x00, 0xFC, 0x83, 0x00, 0x05, 0x62, 0x04, 0x02, 0x00,  // K
+0x00, 0xFC, 0x03, 0x08, 0x20, 0x80, 0x00, 0x02, 0x00,  // L
+0x00, 0xFC, 0x63, 0x00, 0x02, 0x06, 0xFC, 0x03, 0x00,  // M
+0x00, 0xFC, 0x63, 0x00, 0x06, 0x60, 0xFC, 0x03, 0x00,  // N
+0x00, 0xF8, 0x11, 0x48, 0x20, 0x81, 0xF8, 0x01, 0x00,  // O
+0x00, 0xFC, 0x13, 0x41, 0x04, 0x11, 0x38, 0x00, 0x00,  // P
+0x00, 0xF8, 0x11, 0x48, 0x30, 0x81, 0xF8, 0x05, 0x00,  // Q
+0x00, 0xFC, 0x13, 0x41, 0x04, 0x71, 0x38, 0x02, 0x00,  // R
+0x00, 0x18, 0x91, 0x48, 0x22, 0x91, 0x88, 0x01, 0x00,  // S
+0x00, 0x04, 0x10, 0xC0, 0x3F, 0x01, 0x04, 0x00, 0x00,  // T
+0x00, 0xFC, 0x01, 0x08, 0x20, 0x80, 0xFC, 0x01, 0x00,  // U
+0x00, 0x1C, 0x80, 0x03, 0x30, 0x38, 0x1C, 0x00, 0x00,  // V
+0x00, 0xFC, 0x00, 0x0E, 0x07, 0xE0, 0xFC, 0x00, 0x00,  // W
+0x00, 0x04, 0x62, 0x06, 0x06, 0x66, 0x04, 0x02, 0x00,  // X
+0x00, 0x0C, 0xC0, 0x00, 0x3C, 0x0C, 0x0C, 0x00, 0x00,  // Y
+0x00, 0x04, 0x13, 0x4A, 0x26, 0x85, 0x0C, 0x02, 0x00,  // Z
+0x00, 0x00, 0x00, 0xC0, 0xFF, 0x01, 0x02, 0x00, 0x00,  // [
+0x00, 0x00, 0x30, 0x00, 0x0F, 0xC0, 0x00, 0x00, 0x00,  // U+005C
+0x00, 0x00, 0x10, 0xE0, 0xFF, 0x00, 0x00, 0x00, 0x00,  // ]
+0x00, 0x20, 0x60, 0x40, 0x00, 0x06, 0x20, 0x00, 0x00,  // ^
+0x00, 0x02, 0x08, 0x20, 0x80, 0x00, 0x02, 0x08, 0x20,  // _
+0x00, 0x00, 0x10, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00,  // `
+0x00, 0xA0, 0x41, 0x09, 0x25, 0x54, 0xE0, 0x03, 0x00,  // a
+0x00, 0xFC, 0x83, 0x04, 0x21, 0x84, 0xE0, 0x01, 0x00,  // b
+0x00, 0xE0, 0x41, 0x08, 0x21, 0x84, 0x20, 0x01, 0x00,  // c
+0x00, 0xE0, 0x41, 0x08, 0x21, 0x48, 0xFC, 0x03, 0x00,  // d
+0x00, 0xE0, 0x41, 0x09, 0x25, 0x94, 0x60, 0x01, 0x00,  // e
+0x00, 0x10, 0x40, 0x80, 0x3F, 0x05, 0x14, 0x00, 0x00,  // f
+0x00, 0xE0, 0x49, 0x28, 0xA1, 0x48, 0xF2, 0x07, 0x00,  // g
+0x00, 0xFC, 0x83, 0x00, 0x01, 0x04, 0xE0, 0x03, 0x00,  // h
+0x00, 0x10, 0x40, 0x40, 0x3F, 0x00, 0x00, 0x00, 0x00,  // i
+0x00, 0x12, 0x48, 0x60, 0x7F, 0x00, 0x00, 0x00, 0x00,  // j
+0x00, 0xFC, 0x03, 0x01, 0x0A, 0x44, 0x00, 0x02, 0x00,  // k
+0x00, 0x04, 0x10, 0xC0, 0x3F, 0x00, 0x00, 0x00, 0x00,  // l
+0x00, 0xF0, 0x43, 0x00, 0x3F, 0x04, 0xE0, 0x03, 0x00,  // m
+0x00, 0xF0, 0x83, 0x00, 0x01, 0x04, 0xE0, 0x03, 0x00,  // n
+0x00, 0xE0, 0x41, 0x08, 0x21, 0x84, 0xE0, 0x01, 0x00,  // o
+0x00, 0xF0, 0x8F, 0x04, 0x21, 0x84, 0xE0, 0x01, 0x00,  // p
+0x00, 0xE0, 0x41, 0x08, 0x21, 0x48, 0xF0, 0x0F, 0x00,  // q
+0x00, 0xF0, 0x83, 0x00, 0x01, 0x04, 0x20, 0x00, 0x00,  // r
+0x00, 0x20, 0x41, 0x09, 0x25, 0xA4, 0x20, 0x01, 0x00,  // s
+0x00, 0x10, 0xF0, 0x07, 0x21, 0x84, 0x00, 0x00, 0x00,  // t
+0x00, 0xF0, 0x01, 0x08, 0x20, 0x40, 0xF0, 0x03, 0x00,  // u
+0x00, 0x30, 0x00, 0x07, 0x20, 0x70, 0x30, 0x00, 0x00,  // v
+0x00, 0xF0, 0x00, 0x0E, 0x07, 0xE0, 0xF0, 0x00, 0x00,  // w
+0x00, 0x10, 0x82, 0x04, 0x0C, 0x48, 0x10, 0x02, 0x00,  // x
+0x00, 0x30, 0x08, 0x23, 0x70, 0x30, 0x30, 0x00, 0x00,  // y
+0x00, 0x10, 0x43, 0x0A, 0x25, 0x8C, 0x10, 0x02, 0x00,  // z
+0x00, 0x00, 0x00, 0xC3, 0xF3, 0x01, 0x02, 0x00, 0x00,  // {
+0x00, 0x00, 0x00, 0xC0, 0xFF, 0x00, 0x00, 0x00, 0x00,  // |
+0x00, 0x00, 0x10, 0xE0, 0xF3, 0x30, 0x00, 0x00, 0x00,  // }
+0x00, 0x60, 0x80, 0x00, 0x02, 0x10, 0x60, 0x00, 0x00,  // ~
+0x00, 0x00, 0x60, 0x40, 0x02, 0x09, 0x18, 0x00, 0x00,  // U+00B0
+0x00, 0x20, 0x82, 0x88, 0x2F, 0x88, 0x20, 0x02, 0x00,  // U+00B1
+0x00, 0xF0, 0x0F, 0x08, 0x20, 0x40, 0xF0, 0x03, 0x00,  // U+00B5
+0x00, 0x40, 0x80, 0x03, 0x15, 0x10, 0x40, 0x00, 0x00,  // U+2190
+0x00, 0x10, 0x20, 0xC0, 0x3F, 0x02, 0x10, 0x00, 0x00,  // U+2191
+0x00, 0x40, 0x00, 0x01, 0x15, 0x38, 0x40, 0x00, 0x00,  // U+2192
+0x00, 0x80, 0x00, 0xC4, 0x3F, 0x40, 0x80, 0x00, 0x00,  // U+2193
 };
 
-const uint16_t Font11x18 [] = {
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // sp
-0x0000, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0000, 0x0C00, 0x0C00, 0x0000, 0x0000, 0x0000,   // !
-0x0000, 0x1B00, 0x1B00, 0x1B00, 0x1B00, 0x1B00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // "
-0x0000, 0x1980, 0x1980, 0x1980, 0x1980, 0x7FC0, 0x7FC0, 0x1980, 0x3300, 0x7FC0, 0x7FC0, 0x3300, 0x3300, 0x3300, 0x3300, 0x0000, 0x0000, 0x0000,   // #
-0x0000, 0x1E00, 0x3F00, 0x7580, 0x6580, 0x7400, 0x3C00, 0x1E00, 0x0700, 0x0580, 0x6580, 0x6580, 0x7580, 0x3F00, 0x1E00, 0x0400, 0x0400, 0x0000,   // $
-0x0000, 0x7000, 0xD800, 0xD840, 0xD8C0, 0xD980, 0x7300, 0x0600, 0x0C00, 0x1B80, 0x36C0, 0x66C0, 0x46C0, 0x06C0, 0x0380, 0x0000, 0x0000, 0x0000,   // %
-0x0000, 0x1E00, 0x3F00, 0x3300, 0x3300, 0x3300, 0x1E00, 0x0C00, 0x3CC0, 0x66C0, 0x6380, 0x6180, 0x6380, 0x3EC0, 0x1C80, 0x0000, 0x0000, 0x0000,   // &
-0x0000, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // '
-0x0080, 0x0100, 0x0300, 0x0600, 0x0600, 0x0400, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0400, 0x0600, 0x0600, 0x0300, 0x0100, 0x0080,   // (
-0x2000, 0x1000, 0x1800, 0x0C00, 0x0C00, 0x0400, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0400, 0x0C00, 0x0C00, 0x1800, 0x1000, 0x2000,   // )
-0x0000, 0x0C00, 0x2D00, 0x3F00, 0x1E00, 0x3300, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // *
-0x0000, 0x0000, 0x0000, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0xFFC0, 0xFFC0, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // +
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0C00, 0x0C00, 0x0400, 0x0400, 0x0800,   // ,
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x1E00, 0x1E00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // -
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0C00, 0x0C00, 0x0000, 0x0000, 0x0000,   // .
-0x0000, 0x0300, 0x0300, 0x0300, 0x0600, 0x0600, 0x0600, 0x0600, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x1800, 0x1800, 0x1800, 0x0000, 0x0000, 0x0000,   // /
-0x0000, 0x1E00, 0x3F00, 0x3300, 0x6180, 0x6180, 0x6180, 0x6D80, 0x6D80, 0x6180, 0x6180, 0x6180, 0x3300, 0x3F00, 0x1E00, 0x0000, 0x0000, 0x0000,   // 0
-0x0000, 0x0600, 0x0E00, 0x1E00, 0x3600, 0x2600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0000, 0x0000, 0x0000,   // 1
-0x0000, 0x1E00, 0x3F00, 0x7380, 0x6180, 0x6180, 0x0180, 0x0300, 0x0600, 0x0C00, 0x1800, 0x3000, 0x6000, 0x7F80, 0x7F80, 0x0000, 0x0000, 0x0000,   // 2
-0x0000, 0x1C00, 0x3E00, 0x6300, 0x6300, 0x0300, 0x0E00, 0x0E00, 0x0300, 0x0180, 0x0180, 0x6180, 0x7380, 0x3F00, 0x1E00, 0x0000, 0x0000, 0x0000,   // 3
-0x0000, 0x0600, 0x0E00, 0x0E00, 0x1E00, 0x1E00, 0x1600, 0x3600, 0x3600, 0x6600, 0x7F80, 0x7F80, 0x0600, 0x0600, 0x0600, 0x0000, 0x0000, 0x0000,   // 4
-0x0000, 0x7F00, 0x7F00, 0x6000, 0x6000, 0x6000, 0x6E00, 0x7F00, 0x6380, 0x0180, 0x0180, 0x6180, 0x7380, 0x3F00, 0x1E00, 0x0000, 0x0000, 0x0000,   // 5
-0x0000, 0x1E00, 0x3F00, 0x3380, 0x6180, 0x6000, 0x6E00, 0x7F00, 0x7380, 0x6180, 0x6180, 0x6180, 0x3380, 0x3F00, 0x1E00, 0x0000, 0x0000, 0x0000,   // 6
-0x0000, 0x7F80, 0x7F80, 0x0180, 0x0300, 0x0300, 0x0600, 0x0600, 0x0C00, 0x0C00, 0x0C00, 0x0800, 0x1800, 0x1800, 0x1800, 0x0000, 0x0000, 0x0000,   // 7
-0x0000, 0x1E00, 0x3F00, 0x6380, 0x6180, 0x6180, 0x2100, 0x1E00, 0x3F00, 0x6180, 0x6180, 0x6180, 0x6180, 0x3F00, 0x1E00, 0x0000, 0x0000, 0x0000,   // 8
-0x0000, 0x1E00, 0x3F00, 0x7300, 0x6180, 0x6180, 0x6180, 0x7380, 0x3F80, 0x1D80, 0x0180, 0x6180, 0x7300, 0x3F00, 0x1E00, 0x0000, 0x0000, 0x0000,   // 9
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0C00, 0x0C00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0C00, 0x0C00, 0x0000, 0x0000, 0x0000,   // :
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0C00, 0x0C00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0C00, 0x0C00, 0x0400, 0x0400, 0x0800,   // ;
-0x0000, 0x0000, 0x0000, 0x0000, 0x0080, 0x0380, 0x0E00, 0x3800, 0x6000, 0x3800, 0x0E00, 0x0380, 0x0080, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // <
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x7F80, 0x7F80, 0x0000, 0x0000, 0x7F80, 0x7F80, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // =
-0x0000, 0x0000, 0x0000, 0x0000, 0x4000, 0x7000, 0x1C00, 0x0700, 0x0180, 0x0700, 0x1C00, 0x7000, 0x4000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // >
-0x0000, 0x1F00, 0x3F80, 0x71C0, 0x60C0, 0x00C0, 0x01C0, 0x0380, 0x0700, 0x0E00, 0x0C00, 0x0C00, 0x0000, 0x0C00, 0x0C00, 0x0000, 0x0000, 0x0000,   // ?
-0x0000, 0x1E00, 0x3F00, 0x3180, 0x7180, 0x6380, 0x6F80, 0x6D80, 0x6D80, 0x6F80, 0x6780, 0x6000, 0x3200, 0x3E00, 0x1C00, 0x0000, 0x0000, 0x0000,   // @
-0x0000, 0x0E00, 0x0E00, 0x1B00, 0x1B00, 0x1B00, 0x1B00, 0x3180, 0x3180, 0x3F80, 0x3F80, 0x3180, 0x60C0, 0x60C0, 0x60C0, 0x0000, 0x0000, 0x0000,   // A
-0x0000, 0x7C00, 0x7E00, 0x6300, 0x6300, 0x6300, 0x6300, 0x7E00, 0x7E00, 0x6300, 0x6180, 0x6180, 0x6380, 0x7F00, 0x7E00, 0x0000, 0x0000, 0x0000,   // B
-0x0000, 0x1E00, 0x3F00, 0x3180, 0x6180, 0x6000, 0x6000, 0x6000, 0x6000, 0x6000, 0x6000, 0x6180, 0x3180, 0x3F00, 0x1E00, 0x0000, 0x0000, 0x0000,   // C
-0x0000, 0x7C00, 0x7F00, 0x6300, 0x6380, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6300, 0x6300, 0x7E00, 0x7C00, 0x0000, 0x0000, 0x0000,   // D
-0x0000, 0x7F80, 0x7F80, 0x6000, 0x6000, 0x6000, 0x6000, 0x7F00, 0x7F00, 0x6000, 0x6000, 0x6000, 0x6000, 0x7F80, 0x7F80, 0x0000, 0x0000, 0x0000,   // E
-0x0000, 0x7F80, 0x7F80, 0x6000, 0x6000, 0x6000, 0x6000, 0x7F00, 0x7F00, 0x6000, 0x6000, 0x6000, 0x6000, 0x6000, 0x6000, 0x0000, 0x0000, 0x0000,   // F
-0x0000, 0x1E00, 0x3F00, 0x3180, 0x6180, 0x6000, 0x6000, 0x6000, 0x6380, 0x6380, 0x6180, 0x6180, 0x3180, 0x3F80, 0x1E00, 0x0000, 0x0000, 0x0000,   // G
-0x0000, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x7F80, 0x7F80, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x0000, 0x0000, 0x0000,   // H
-0x0000, 0x3F00, 0x3F00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x3F00, 0x3F00, 0x0000, 0x0000, 0x0000,   // I
-0x0000, 0x0180, 0x0180, 0x0180, 0x0180, 0x0180, 0x0180, 0x0180, 0x0180, 0x0180, 0x6180, 0x6180, 0x7380, 0x3F00, 0x1E00, 0x0000, 0x0000, 0x0000,   // J
-0x0000, 0x60C0, 0x6180, 0x6300, 0x6600, 0x6600, 0x6C00, 0x7800, 0x7C00, 0x6600, 0x6600, 0x6300, 0x6180, 0x6180, 0x60C0, 0x0000, 0x0000, 0x0000,   // K
-0x0000, 0x6000, 0x6000, 0x6000, 0x6000, 0x6000, 0x6000, 0x6000, 0x6000, 0x6000, 0x6000, 0x6000, 0x6000, 0x7F80, 0x7F80, 0x0000, 0x0000, 0x0000,   // L
-0x0000, 0x71C0, 0x71C0, 0x7BC0, 0x7AC0, 0x6AC0, 0x6AC0, 0x6EC0, 0x64C0, 0x60C0, 0x60C0, 0x60C0, 0x60C0, 0x60C0, 0x60C0, 0x0000, 0x0000, 0x0000,   // M
-0x0000, 0x7180, 0x7180, 0x7980, 0x7980, 0x7980, 0x6D80, 0x6D80, 0x6D80, 0x6580, 0x6780, 0x6780, 0x6780, 0x6380, 0x6380, 0x0000, 0x0000, 0x0000,   // N
-0x0000, 0x1E00, 0x3F00, 0x3300, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x3300, 0x3F00, 0x1E00, 0x0000, 0x0000, 0x0000,   // O
-0x0000, 0x7E00, 0x7F00, 0x6380, 0x6180, 0x6180, 0x6180, 0x6380, 0x7F00, 0x7E00, 0x6000, 0x6000, 0x6000, 0x6000, 0x6000, 0x0000, 0x0000, 0x0000,   // P
-0x0000, 0x1E00, 0x3F00, 0x3300, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6580, 0x6780, 0x3300, 0x3F80, 0x1E40, 0x0000, 0x0000, 0x0000,   // Q
-0x0000, 0x7E00, 0x7F00, 0x6380, 0x6180, 0x6180, 0x6380, 0x7F00, 0x7E00, 0x6600, 0x6300, 0x6300, 0x6180, 0x6180, 0x60C0, 0x0000, 0x0000, 0x0000,   // R
-0x0000, 0x0E00, 0x1F00, 0x3180, 0x3180, 0x3000, 0x3800, 0x1E00, 0x0700, 0x0380, 0x6180, 0x6180, 0x3180, 0x3F00, 0x1E00, 0x0000, 0x0000, 0x0000,   // S
-0x0000, 0xFFC0, 0xFFC0, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0000, 0x0000, 0x0000,   // T
-0x0000, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x7380, 0x3F00, 0x1E00, 0x0000, 0x0000, 0x0000,   // U
-0x0000, 0x60C0, 0x60C0, 0x60C0, 0x3180, 0x3180, 0x3180, 0x1B00, 0x1B00, 0x1B00, 0x1B00, 0x0E00, 0x0E00, 0x0E00, 0x0400, 0x0000, 0x0000, 0x0000,   // V
-0x0000, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xCCC0, 0x4C80, 0x4C80, 0x5E80, 0x5280, 0x5280, 0x7380, 0x6180, 0x6180, 0x0000, 0x0000, 0x0000,   // W
-0x0000, 0xC0C0, 0x6080, 0x6180, 0x3300, 0x3B00, 0x1E00, 0x0C00, 0x0C00, 0x1E00, 0x1F00, 0x3B00, 0x7180, 0x6180, 0xC0C0, 0x0000, 0x0000, 0x0000,   // X
-0x0000, 0xC0C0, 0x6180, 0x6180, 0x3300, 0x3300, 0x1E00, 0x1E00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0000, 0x0000, 0x0000,   // Y
-0x0000, 0x3F80, 0x3F80, 0x0180, 0x0300, 0x0300, 0x0600, 0x0C00, 0x0C00, 0x1800, 0x1800, 0x3000, 0x6000, 0x7F80, 0x7F80, 0x0000, 0x0000, 0x0000,   // Z
-0x0F00, 0x0F00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0F00, 0x0F00,   // [
-0x0000, 0x1800, 0x1800, 0x1800, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0600, 0x0600, 0x0600, 0x0600, 0x0300, 0x0300, 0x0300, 0x0000, 0x0000, 0x0000,   /* \ */
-0x1E00, 0x1E00, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x1E00, 0x1E00,   // ]
-0x0000, 0x0C00, 0x0C00, 0x1E00, 0x1200, 0x3300, 0x3300, 0x6180, 0x6180, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // ^
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xFFE0, 0x0000,   // _
-0x0000, 0x3800, 0x1800, 0x0C00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // `
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x1F00, 0x3F80, 0x6180, 0x0180, 0x1F80, 0x3F80, 0x6180, 0x6380, 0x7F80, 0x38C0, 0x0000, 0x0000, 0x0000,   // a
-0x0000, 0x6000, 0x6000, 0x6000, 0x6000, 0x6E00, 0x7F00, 0x7380, 0x6180, 0x6180, 0x6180, 0x6180, 0x7380, 0x7F00, 0x6E00, 0x0000, 0x0000, 0x0000,   // b
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x1E00, 0x3F00, 0x7380, 0x6180, 0x6000, 0x6000, 0x6180, 0x7380, 0x3F00, 0x1E00, 0x0000, 0x0000, 0x0000,   // c
-0x0000, 0x0180, 0x0180, 0x0180, 0x0180, 0x1D80, 0x3F80, 0x7380, 0x6180, 0x6180, 0x6180, 0x6180, 0x7380, 0x3F80, 0x1D80, 0x0000, 0x0000, 0x0000,   // d
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x1E00, 0x3F00, 0x7300, 0x6180, 0x7F80, 0x7F80, 0x6000, 0x7180, 0x3F00, 0x1E00, 0x0000, 0x0000, 0x0000,   // e
-0x0000, 0x07C0, 0x0FC0, 0x0C00, 0x0C00, 0x7F80, 0x7F80, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0000, 0x0000, 0x0000,   // f
-0x0000, 0x0000, 0x0000, 0x0000, 0x1D80, 0x3F80, 0x7380, 0x6180, 0x6180, 0x6180, 0x6180, 0x7380, 0x3F80, 0x1D80, 0x0180, 0x6380, 0x7F00, 0x3E00,   // g
-0x0000, 0x6000, 0x6000, 0x6000, 0x6000, 0x6F00, 0x7F80, 0x7180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x0000, 0x0000, 0x0000,   // h
-0x0000, 0x0600, 0x0600, 0x0000, 0x0000, 0x3E00, 0x3E00, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0000, 0x0000, 0x0000,   // i
-0x0600, 0x0600, 0x0000, 0x0000, 0x3E00, 0x3E00, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x4600, 0x7E00, 0x3C00,   // j
-0x0000, 0x6000, 0x6000, 0x6000, 0x6000, 0x6180, 0x6300, 0x6600, 0x6C00, 0x7C00, 0x7600, 0x6300, 0x6300, 0x6180, 0x60C0, 0x0000, 0x0000, 0x0000,   // k
-0x0000, 0x3E00, 0x3E00, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0000, 0x0000, 0x0000,   // l
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xDD80, 0xFFC0, 0xCEC0, 0xCCC0, 0xCCC0, 0xCCC0, 0xCCC0, 0xCCC0, 0xCCC0, 0xCCC0, 0x0000, 0x0000, 0x0000,   // m
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x6F00, 0x7F80, 0x7180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x0000, 0x0000, 0x0000,   // n
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x1E00, 0x3F00, 0x7380, 0x6180, 0x6180, 0x6180, 0x6180, 0x7380, 0x3F00, 0x1E00, 0x0000, 0x0000, 0x0000,   // o
-0x0000, 0x0000, 0x0000, 0x0000, 0x6E00, 0x7F00, 0x7380, 0x6180, 0x6180, 0x6180, 0x6180, 0x7380, 0x7F00, 0x6E00, 0x6000, 0x6000, 0x6000, 0x6000,   // p
-0x0000, 0x0000, 0x0000, 0x0000, 0x1D80, 0x3F80, 0x7380, 0x6180, 0x6180, 0x6180, 0x6180, 0x7380, 0x3F80, 0x1D80, 0x0180, 0x0180, 0x0180, 0x0180,   // q
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x6700, 0x3F80, 0x3900, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x0000, 0x0000, 0x0000,   // r
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x1E00, 0x3F80, 0x6180, 0x6000, 0x7F00, 0x3F80, 0x0180, 0x6180, 0x7F00, 0x1E00, 0x0000, 0x0000, 0x0000,   // s
-0x0000, 0x0000, 0x0800, 0x1800, 0x1800, 0x7F00, 0x7F00, 0x1800, 0x1800, 0x1800, 0x1800, 0x1800, 0x1800, 0x1F80, 0x0F80, 0x0000, 0x0000, 0x0000,   // t
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6180, 0x6380, 0x7F80, 0x3D80, 0x0000, 0x0000, 0x0000,   // u
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x60C0, 0x3180, 0x3180, 0x3180, 0x1B00, 0x1B00, 0x1B00, 0x0E00, 0x0E00, 0x0600, 0x0000, 0x0000, 0x0000,   // v
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xDD80, 0xDD80, 0xDD80, 0x5500, 0x5500, 0x5500, 0x7700, 0x7700, 0x2200, 0x2200, 0x0000, 0x0000, 0x0000,   // w
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x6180, 0x3300, 0x3300, 0x1E00, 0x0C00, 0x0C00, 0x1E00, 0x3300, 0x3300, 0x6180, 0x0000, 0x0000, 0x0000,   // x
-0x0000, 0x0000, 0x0000, 0x0000, 0x6180, 0x6180, 0x3180, 0x3300, 0x3300, 0x1B00, 0x1B00, 0x1B00, 0x0E00, 0x0E00, 0x0E00, 0x1C00, 0x7C00, 0x7000,   // y
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x7FC0, 0x7FC0, 0x0180, 0x0300, 0x0600, 0x0C00, 0x1800, 0x3000, 0x7FC0, 0x7FC0, 0x0000, 0x0000, 0x0000,   // z
-0x0380, 0x0780, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0E00, 0x1C00, 0x1C00, 0x0E00, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0780, 0x0380,   // {
-0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600, 0x0600,   // |
-0x3800, 0x3C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0E00, 0x0700, 0x0700, 0x0E00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x3C00, 0x3800,   // }
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3880, 0x7F80, 0x4700, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // ~
+const FONTS_RANGE_t Font7x10_Ranges [] = {
+	{32, 95, 0},
+	{176, 2, 95},
+	{181, 1, 97},
+	{8592, 4, 98},
 };
 
-const uint16_t Font16x26 [] = {
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [ ]
-0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03C0,0x03C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x0000,0x0000,0x0000,0x03E0,0x03E0,0x03E0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [!]
-0x1E3C,0x1E3C,0x1E3C,0x1E3C,0x1E3C,0x1E3C,0x1E3C,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = ["]
-0x01CE,0x03CE,0x03DE,0x039E,0x039C,0x079C,0x3FFF,0x7FFF,0x0738,0x0F38,0x0F78,0x0F78,0x0E78,0xFFFF,0xFFFF,0x1EF0,0x1CF0,0x1CE0,0x3CE0,0x3DE0,0x39E0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [#]
-0x03FC,0x0FFE,0x1FEE,0x1EE0,0x1EE0,0x1EE0,0x1EE0,0x1FE0,0x0FE0,0x07E0,0x03F0,0x01FC,0x01FE,0x01FE,0x01FE,0x01FE,0x01FE,0x01FE,0x3DFE,0x3FFC,0x0FF0,0x01E0,0x01E0,0x0000,0x0000,0x0000, // Ascii = [$]
-0x3E03,0xF707,0xE78F,0xE78E,0xE39E,0xE3BC,0xE7B8,0xE7F8,0xF7F0,0x3FE0,0x01C0,0x03FF,0x07FF,0x07F3,0x0FF3,0x1EF3,0x3CF3,0x38F3,0x78F3,0xF07F,0xE03F,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [%]
-0x07E0,0x0FF8,0x0F78,0x1F78,0x1F78,0x1F78,0x0F78,0x0FF0,0x0FE0,0x1F80,0x7FC3,0xFBC3,0xF3E7,0xF1F7,0xF0F7,0xF0FF,0xF07F,0xF83E,0x7C7F,0x3FFF,0x1FEF,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [&]
-0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03C0,0x01C0,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [']
-0x003F,0x007C,0x01F0,0x01E0,0x03C0,0x07C0,0x0780,0x0780,0x0F80,0x0F00,0x0F00,0x0F00,0x0F00,0x0F00,0x0F00,0x0F80,0x0780,0x0780,0x07C0,0x03C0,0x01E0,0x01F0,0x007C,0x003F,0x000F,0x0000, // Ascii = [(]
-0x7E00,0x1F00,0x07C0,0x03C0,0x01E0,0x01F0,0x00F0,0x00F0,0x00F8,0x0078,0x0078,0x0078,0x0078,0x0078,0x0078,0x00F8,0x00F0,0x00F0,0x01F0,0x01E0,0x03C0,0x07C0,0x1F00,0x7E00,0x7800,0x0000, // Ascii = [)]
-0x03E0,0x03C0,0x01C0,0x39CE,0x3FFF,0x3F7F,0x0320,0x0370,0x07F8,0x0F78,0x1F3C,0x0638,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [*]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0xFFFF,0xFFFF,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [+]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x03E0,0x03E0,0x03E0,0x03E0,0x01E0,0x01E0,0x01E0,0x01C0,0x0380, // Ascii = [,]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x3FFE,0x3FFE,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [-]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x03E0,0x03E0,0x03E0,0x03E0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [.]
-0x000F,0x000F,0x001E,0x001E,0x003C,0x003C,0x0078,0x0078,0x00F0,0x00F0,0x01E0,0x01E0,0x03C0,0x03C0,0x0780,0x0780,0x0F00,0x0F00,0x1E00,0x1E00,0x3C00,0x3C00,0x7800,0x7800,0xF000,0x0000, // Ascii = [/]
-0x07F0,0x0FF8,0x1F7C,0x3E3E,0x3C1E,0x7C1F,0x7C1F,0x780F,0x780F,0x780F,0x780F,0x780F,0x780F,0x780F,0x7C1F,0x7C1F,0x3C1E,0x3E3E,0x1F7C,0x0FF8,0x07F0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [0]
-0x00F0,0x07F0,0x3FF0,0x3FF0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x3FFF,0x3FFF,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [1]
-0x0FE0,0x3FF8,0x3C7C,0x003C,0x003E,0x003E,0x003E,0x003C,0x003C,0x007C,0x00F8,0x01F0,0x03E0,0x07C0,0x0780,0x0F00,0x1E00,0x3E00,0x3C00,0x3FFE,0x3FFE,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [2]
-0x0FF0,0x1FF8,0x1C7C,0x003E,0x003E,0x003E,0x003C,0x003C,0x00F8,0x0FF0,0x0FF8,0x007C,0x003E,0x001E,0x001E,0x001E,0x001E,0x003E,0x1C7C,0x1FF8,0x1FE0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [3]
-0x0078,0x00F8,0x00F8,0x01F8,0x03F8,0x07F8,0x07F8,0x0F78,0x1E78,0x1E78,0x3C78,0x7878,0x7878,0xFFFF,0xFFFF,0x0078,0x0078,0x0078,0x0078,0x0078,0x0078,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [4]
-0x1FFC,0x1FFC,0x1FFC,0x1E00,0x1E00,0x1E00,0x1E00,0x1E00,0x1FE0,0x1FF8,0x00FC,0x007C,0x003E,0x003E,0x001E,0x003E,0x003E,0x003C,0x1C7C,0x1FF8,0x1FE0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [5]
-0x01FC,0x07FE,0x0F8E,0x1F00,0x1E00,0x3E00,0x3C00,0x3C00,0x3DF8,0x3FFC,0x7F3E,0x7E1F,0x3C0F,0x3C0F,0x3C0F,0x3C0F,0x3E0F,0x1E1F,0x1F3E,0x0FFC,0x03F0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [6]
-0x3FFF,0x3FFF,0x3FFF,0x000F,0x001E,0x001E,0x003C,0x0038,0x0078,0x00F0,0x00F0,0x01E0,0x01E0,0x03C0,0x03C0,0x0780,0x0F80,0x0F80,0x0F00,0x1F00,0x1F00,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [7]
-0x07F8,0x0FFC,0x1F3E,0x1E1E,0x3E1E,0x3E1E,0x1E1E,0x1F3C,0x0FF8,0x07F0,0x0FF8,0x1EFC,0x3E3E,0x3C1F,0x7C1F,0x7C0F,0x7C0F,0x3C1F,0x3F3E,0x1FFC,0x07F0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [8]
-0x07F0,0x0FF8,0x1E7C,0x3C3E,0x3C1E,0x7C1F,0x7C1F,0x7C1F,0x7C1F,0x3C1F,0x3E3F,0x1FFF,0x07EF,0x001F,0x001E,0x001E,0x003E,0x003C,0x38F8,0x3FF0,0x1FE0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [9]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x03E0,0x03E0,0x03E0,0x03E0,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x03E0,0x03E0,0x03E0,0x03E0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [:]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x03E0,0x03E0,0x03E0,0x03E0,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x03E0,0x03E0,0x03E0,0x03E0,0x01E0,0x01E0,0x01E0,0x03C0,0x0380, // Ascii = [;]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0003,0x000F,0x003F,0x00FC,0x03F0,0x0FC0,0x3F00,0xFE00,0x3F00,0x0FC0,0x03F0,0x00FC,0x003F,0x000F,0x0003,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [<]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0xFFFF,0xFFFF,0x0000,0x0000,0x0000,0xFFFF,0xFFFF,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [=]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0xE000,0xF800,0x7E00,0x1F80,0x07E0,0x01F8,0x007E,0x001F,0x007E,0x01F8,0x07E0,0x1F80,0x7E00,0xF800,0xE000,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [>]
-0x1FF0,0x3FFC,0x383E,0x381F,0x381F,0x001E,0x001E,0x003C,0x0078,0x00F0,0x01E0,0x03C0,0x03C0,0x07C0,0x07C0,0x0000,0x0000,0x0000,0x07C0,0x07C0,0x07C0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [?]
-0x03F8,0x0FFE,0x1F1E,0x3E0F,0x3C7F,0x78FF,0x79EF,0x73C7,0xF3C7,0xF38F,0xF38F,0xF38F,0xF39F,0xF39F,0x73FF,0x7BFF,0x79F7,0x3C00,0x1F1C,0x0FFC,0x03F8,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [@]
-0x0000,0x0000,0x0000,0x03E0,0x03E0,0x07F0,0x07F0,0x07F0,0x0F78,0x0F78,0x0E7C,0x1E3C,0x1E3C,0x3C3E,0x3FFE,0x3FFF,0x781F,0x780F,0xF00F,0xF007,0xF007,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [A]
-0x0000,0x0000,0x0000,0x3FF8,0x3FFC,0x3C3E,0x3C1E,0x3C1E,0x3C1E,0x3C3E,0x3C7C,0x3FF0,0x3FF8,0x3C7E,0x3C1F,0x3C1F,0x3C0F,0x3C0F,0x3C1F,0x3FFE,0x3FF8,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [B]
-0x0000,0x0000,0x0000,0x01FF,0x07FF,0x1F87,0x3E00,0x3C00,0x7C00,0x7800,0x7800,0x7800,0x7800,0x7800,0x7C00,0x7C00,0x3E00,0x3F00,0x1F83,0x07FF,0x01FF,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [C]
-0x0000,0x0000,0x0000,0x7FF0,0x7FFC,0x787E,0x781F,0x781F,0x780F,0x780F,0x780F,0x780F,0x780F,0x780F,0x780F,0x780F,0x781F,0x781E,0x787E,0x7FF8,0x7FE0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [D]
-0x0000,0x0000,0x0000,0x3FFF,0x3FFF,0x3E00,0x3E00,0x3E00,0x3E00,0x3E00,0x3E00,0x3FFE,0x3FFE,0x3E00,0x3E00,0x3E00,0x3E00,0x3E00,0x3E00,0x3FFF,0x3FFF,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [E]
-0x0000,0x0000,0x0000,0x1FFF,0x1FFF,0x1E00,0x1E00,0x1E00,0x1E00,0x1E00,0x1E00,0x1FFF,0x1FFF,0x1E00,0x1E00,0x1E00,0x1E00,0x1E00,0x1E00,0x1E00,0x1E00,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [F]
-0x0000,0x0000,0x0000,0x03FE,0x0FFF,0x1F87,0x3E00,0x7C00,0x7C00,0x7800,0xF800,0xF800,0xF87F,0xF87F,0x780F,0x7C0F,0x7C0F,0x3E0F,0x1F8F,0x0FFF,0x03FE,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [G]
-0x0000,0x0000,0x0000,0x7C1F,0x7C1F,0x7C1F,0x7C1F,0x7C1F,0x7C1F,0x7C1F,0x7C1F,0x7FFF,0x7FFF,0x7C1F,0x7C1F,0x7C1F,0x7C1F,0x7C1F,0x7C1F,0x7C1F,0x7C1F,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [H]
-0x0000,0x0000,0x0000,0x3FFF,0x3FFF,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x3FFF,0x3FFF,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [I]
-0x0000,0x0000,0x0000,0x1FFC,0x1FFC,0x007C,0x007C,0x007C,0x007C,0x007C,0x007C,0x007C,0x007C,0x007C,0x007C,0x007C,0x0078,0x0078,0x38F8,0x3FF0,0x3FC0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [J]
-0x0000,0x0000,0x0000,0x3C1F,0x3C1E,0x3C3C,0x3C78,0x3CF0,0x3DE0,0x3FE0,0x3FC0,0x3F80,0x3FC0,0x3FE0,0x3DF0,0x3CF0,0x3C78,0x3C7C,0x3C3E,0x3C1F,0x3C0F,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [K]
-0x0000,0x0000,0x0000,0x3E00,0x3E00,0x3E00,0x3E00,0x3E00,0x3E00,0x3E00,0x3E00,0x3E00,0x3E00,0x3E00,0x3E00,0x3E00,0x3E00,0x3E00,0x3E00,0x3FFF,0x3FFF,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [L]
-0x0000,0x0000,0x0000,0xF81F,0xFC1F,0xFC1F,0xFE3F,0xFE3F,0xFE3F,0xFF7F,0xFF77,0xFF77,0xF7F7,0xF7E7,0xF3E7,0xF3E7,0xF3C7,0xF007,0xF007,0xF007,0xF007,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [M]
-0x0000,0x0000,0x0000,0x7C0F,0x7C0F,0x7E0F,0x7F0F,0x7F0F,0x7F8F,0x7F8F,0x7FCF,0x7BEF,0x79EF,0x79FF,0x78FF,0x78FF,0x787F,0x783F,0x783F,0x781F,0x781F,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [N]
-0x0000,0x0000,0x0000,0x07F0,0x1FFC,0x3E3E,0x7C1F,0x780F,0x780F,0xF80F,0xF80F,0xF80F,0xF80F,0xF80F,0xF80F,0x780F,0x780F,0x7C1F,0x3E3E,0x1FFC,0x07F0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [O]
-0x0000,0x0000,0x0000,0x3FFC,0x3FFF,0x3E1F,0x3E0F,0x3E0F,0x3E0F,0x3E0F,0x3E1F,0x3E3F,0x3FFC,0x3FF0,0x3E00,0x3E00,0x3E00,0x3E00,0x3E00,0x3E00,0x3E00,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [P]
-0x0000,0x0000,0x0000,0x07F0,0x1FFC,0x3E3E,0x7C1F,0x780F,0x780F,0xF80F,0xF80F,0xF80F,0xF80F,0xF80F,0xF80F,0x780F,0x780F,0x7C1F,0x3E3E,0x1FFC,0x07F8,0x007C,0x003F,0x000F,0x0003,0x0000, // Ascii = [Q]
-0x0000,0x0000,0x0000,0x3FF0,0x3FFC,0x3C7E,0x3C3E,0x3C1E,0x3C1E,0x3C3E,0x3C3C,0x3CFC,0x3FF0,0x3FE0,0x3DF0,0x3CF8,0x3C7C,0x3C3E,0x3C1E,0x3C1F,0x3C0F,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [R]
-0x0000,0x0000,0x0000,0x07FC,0x1FFE,0x3E0E,0x3C00,0x3C00,0x3C00,0x3E00,0x1FC0,0x0FF8,0x03FE,0x007F,0x001F,0x000F,0x000F,0x201F,0x3C3E,0x3FFC,0x1FF0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [S]
-0x0000,0x0000,0x0000,0xFFFF,0xFFFF,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [T]
-0x0000,0x0000,0x0000,0x7C0F,0x7C0F,0x7C0F,0x7C0F,0x7C0F,0x7C0F,0x7C0F,0x7C0F,0x7C0F,0x7C0F,0x7C0F,0x7C0F,0x7C0F,0x3C1E,0x3C1E,0x3E3E,0x1FFC,0x07F0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [U]
-0x0000,0x0000,0x0000,0xF007,0xF007,0xF807,0x780F,0x7C0F,0x3C1E,0x3C1E,0x3E1E,0x1E3C,0x1F3C,0x1F78,0x0F78,0x0FF8,0x07F0,0x07F0,0x07F0,0x03E0,0x03E0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [V]
-0x0000,0x0000,0x0000,0xE003,0xF003,0xF003,0xF007,0xF3E7,0xF3E7,0xF3E7,0x73E7,0x7BF7,0x7FF7,0x7FFF,0x7F7F,0x7F7F,0x7F7E,0x3F7E,0x3E3E,0x3E3E,0x3E3E,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [W]
-0x0000,0x0000,0x0000,0xF807,0x7C0F,0x3E1E,0x3E3E,0x1F3C,0x0FF8,0x07F0,0x07E0,0x03E0,0x03E0,0x07F0,0x0FF8,0x0F7C,0x1E7C,0x3C3E,0x781F,0x780F,0xF00F,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [X]
-0x0000,0x0000,0x0000,0xF807,0x7807,0x7C0F,0x3C1E,0x3E1E,0x1F3C,0x0F78,0x0FF8,0x07F0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x03E0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [Y]
-0x0000,0x0000,0x0000,0x7FFF,0x7FFF,0x000F,0x001F,0x003E,0x007C,0x00F8,0x00F0,0x01E0,0x03E0,0x07C0,0x0F80,0x0F00,0x1E00,0x3E00,0x7C00,0x7FFF,0x7FFF,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [Z]
-0x07FF,0x0780,0x0780,0x0780,0x0780,0x0780,0x0780,0x0780,0x0780,0x0780,0x0780,0x0780,0x0780,0x0780,0x0780,0x0780,0x0780,0x0780,0x0780,0x0780,0x0780,0x0780,0x0780,0x07FF,0x07FF,0x0000, // Ascii = [[]
-0x7800,0x7800,0x3C00,0x3C00,0x1E00,0x1E00,0x0F00,0x0F00,0x0780,0x0780,0x03C0,0x03C0,0x01E0,0x01E0,0x00F0,0x00F0,0x0078,0x0078,0x003C,0x003C,0x001E,0x001E,0x000F,0x000F,0x0007,0x0000, // Ascii = [\]
-0x7FF0,0x00F0,0x00F0,0x00F0,0x00F0,0x00F0,0x00F0,0x00F0,0x00F0,0x00F0,0x00F0,0x00F0,0x00F0,0x00F0,0x00F0,0x00F0,0x00F0,0x00F0,0x00F0,0x00F0,0x00F0,0x00F0,0x00F0,0x7FF0,0x7FF0,0x0000, // Ascii = []]
-0x00C0,0x01C0,0x01C0,0x03E0,0x03E0,0x07F0,0x07F0,0x0778,0x0F78,0x0F38,0x1E3C,0x1E3C,0x3C1E,0x3C1E,0x380F,0x780F,0x7807,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [^]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0xFFFF,0xFFFF,0x0000,0x0000,0x0000, // Ascii = [_]
-0x00F0,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [`]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0FF8,0x3FFC,0x3C7C,0x003E,0x003E,0x003E,0x07FE,0x1FFE,0x3E3E,0x7C3E,0x783E,0x7C3E,0x7C7E,0x3FFF,0x1FCF,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [a]
-0x3C00,0x3C00,0x3C00,0x3C00,0x3C00,0x3C00,0x3DF8,0x3FFE,0x3F3E,0x3E1F,0x3C0F,0x3C0F,0x3C0F,0x3C0F,0x3C0F,0x3C0F,0x3C1F,0x3C1E,0x3F3E,0x3FFC,0x3BF0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [b]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x03FE,0x0FFF,0x1F87,0x3E00,0x3E00,0x3C00,0x7C00,0x7C00,0x7C00,0x3C00,0x3E00,0x3E00,0x1F87,0x0FFF,0x03FE,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [c]
-0x001F,0x001F,0x001F,0x001F,0x001F,0x001F,0x07FF,0x1FFF,0x3E3F,0x3C1F,0x7C1F,0x7C1F,0x7C1F,0x781F,0x781F,0x7C1F,0x7C1F,0x3C3F,0x3E7F,0x1FFF,0x0FDF,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [d]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x03F8,0x0FFC,0x1F3E,0x3E1E,0x3C1F,0x7C1F,0x7FFF,0x7FFF,0x7C00,0x7C00,0x3C00,0x3E00,0x1F07,0x0FFF,0x03FE,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [e]
-0x01FF,0x03E1,0x03C0,0x07C0,0x07C0,0x07C0,0x7FFF,0x7FFF,0x07C0,0x07C0,0x07C0,0x07C0,0x07C0,0x07C0,0x07C0,0x07C0,0x07C0,0x07C0,0x07C0,0x07C0,0x07C0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [f]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x07EF,0x1FFF,0x3E7F,0x3C1F,0x7C1F,0x7C1F,0x781F,0x781F,0x781F,0x7C1F,0x7C1F,0x3C3F,0x3E7F,0x1FFF,0x0FDF,0x001E,0x001E,0x001E,0x387C,0x3FF8, // Ascii = [g]
-0x3C00,0x3C00,0x3C00,0x3C00,0x3C00,0x3C00,0x3DFC,0x3FFE,0x3F9E,0x3F1F,0x3E1F,0x3C1F,0x3C1F,0x3C1F,0x3C1F,0x3C1F,0x3C1F,0x3C1F,0x3C1F,0x3C1F,0x3C1F,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [h]
-0x01F0,0x01F0,0x0000,0x0000,0x0000,0x0000,0x7FE0,0x7FE0,0x01E0,0x01E0,0x01E0,0x01E0,0x01E0,0x01E0,0x01E0,0x01E0,0x01E0,0x01E0,0x01E0,0x01E0,0x01E0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [i]
-0x00F8,0x00F8,0x0000,0x0000,0x0000,0x0000,0x3FF8,0x3FF8,0x00F8,0x00F8,0x00F8,0x00F8,0x00F8,0x00F8,0x00F8,0x00F8,0x00F8,0x00F8,0x00F8,0x00F8,0x00F8,0x00F8,0x00F8,0x00F0,0x71F0,0x7FE0, // Ascii = [j]
-0x3C00,0x3C00,0x3C00,0x3C00,0x3C00,0x3C00,0x3C1F,0x3C3E,0x3C7C,0x3CF8,0x3DF0,0x3DE0,0x3FC0,0x3FC0,0x3FE0,0x3DF0,0x3CF8,0x3C7C,0x3C3E,0x3C1F,0x3C1F,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [k]
-0x7FF0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x01F0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [l]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0xF79E,0xFFFF,0xFFFF,0xFFFF,0xFBE7,0xF9E7,0xF1C7,0xF1C7,0xF1C7,0xF1C7,0xF1C7,0xF1C7,0xF1C7,0xF1C7,0xF1C7,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [m]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x3DFC,0x3FFE,0x3F9E,0x3F1F,0x3E1F,0x3C1F,0x3C1F,0x3C1F,0x3C1F,0x3C1F,0x3C1F,0x3C1F,0x3C1F,0x3C1F,0x3C1F,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [n]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x07F0,0x1FFC,0x3E3E,0x3C1F,0x7C1F,0x780F,0x780F,0x780F,0x780F,0x780F,0x7C1F,0x3C1F,0x3E3E,0x1FFC,0x07F0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [o]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x3DF8,0x3FFE,0x3F3E,0x3E1F,0x3C0F,0x3C0F,0x3C0F,0x3C0F,0x3C0F,0x3C0F,0x3C1F,0x3E1E,0x3F3E,0x3FFC,0x3FF8,0x3C00,0x3C00,0x3C00,0x3C00,0x3C00, // Ascii = [p]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x07EE,0x1FFE,0x3E7E,0x3C1E,0x7C1E,0x781E,0x781E,0x781E,0x781E,0x781E,0x7C1E,0x7C3E,0x3E7E,0x1FFE,0x0FDE,0x001E,0x001E,0x001E,0x001E,0x001E, // Ascii = [q]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x1F7F,0x1FFF,0x1FE7,0x1FC7,0x1F87,0x1F00,0x1F00,0x1F00,0x1F00,0x1F00,0x1F00,0x1F00,0x1F00,0x1F00,0x1F00,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [r]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x07FC,0x1FFE,0x1E0E,0x3E00,0x3E00,0x3F00,0x1FE0,0x07FC,0x00FE,0x003E,0x001E,0x001E,0x3C3E,0x3FFC,0x1FF0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [s]
-0x0000,0x0000,0x0000,0x0780,0x0780,0x0780,0x7FFF,0x7FFF,0x0780,0x0780,0x0780,0x0780,0x0780,0x0780,0x0780,0x0780,0x0780,0x0780,0x07C0,0x03FF,0x01FF,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [t]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x3C1E,0x3C1E,0x3C1E,0x3C1E,0x3C1E,0x3C1E,0x3C1E,0x3C1E,0x3C1E,0x3C1E,0x3C3E,0x3C7E,0x3EFE,0x1FFE,0x0FDE,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [u]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0xF007,0x780F,0x780F,0x3C1E,0x3C1E,0x3E1E,0x1E3C,0x1E3C,0x0F78,0x0F78,0x0FF0,0x07F0,0x07F0,0x03E0,0x03E0,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [v]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0xF003,0xF1E3,0xF3E3,0xF3E7,0xF3F7,0xF3F7,0x7FF7,0x7F77,0x7F7F,0x7F7F,0x7F7F,0x3E3E,0x3E3E,0x3E3E,0x3E3E,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [w]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x7C0F,0x3E1E,0x3E3C,0x1F3C,0x0FF8,0x07F0,0x07F0,0x03E0,0x07F0,0x07F8,0x0FF8,0x1E7C,0x3E3E,0x3C1F,0x781F,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [x]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0xF807,0x780F,0x7C0F,0x3C1E,0x3C1E,0x1E3C,0x1E3C,0x1F3C,0x0F78,0x0FF8,0x07F0,0x07F0,0x03E0,0x03E0,0x03C0,0x03C0,0x03C0,0x0780,0x0F80,0x7F00, // Ascii = [y]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x3FFF,0x3FFF,0x001F,0x003E,0x007C,0x00F8,0x01F0,0x03E0,0x07C0,0x0F80,0x1F00,0x1E00,0x3C00,0x7FFF,0x7FFF,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [z]
-0x01FE,0x03E0,0x03C0,0x03C0,0x03C0,0x03C0,0x01E0,0x01E0,0x01E0,0x01C0,0x03C0,0x3F80,0x3F80,0x03C0,0x01C0,0x01E0,0x01E0,0x01E0,0x03C0,0x03C0,0x03C0,0x03C0,0x03E0,0x01FE,0x007E,0x0000, // Ascii = [{]
-0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x01C0,0x0000, // Ascii = [|]
-0x3FC0,0x03E0,0x01E0,0x01E0,0x01E0,0x01E0,0x01C0,0x03C0,0x03C0,0x01C0,0x01E0,0x00FE,0x00FE,0x01E0,0x01C0,0x03C0,0x03C0,0x01C0,0x01E0,0x01E0,0x01E0,0x01E0,0x03E0,0x3FC0,0x3F00,0x0000, // Ascii = [}]
-0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x3F07,0x7FC7,0x73E7,0xF1FF,0xF07E,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [~]
+const uint8_t Font11x18 [] = {
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // sp
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFE, 0x6F, 0xF8, 0xBF, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // !
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x3E, 0x00, 0x00, 0x00, 0xE0, 0x03, 0x80, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // "
+0x00, 0x00, 0x80, 0x19, 0x00, 0xF6, 0x87, 0xFF, 0x1F, 0xFE, 0x06, 0x80, 0x19, 0x00, 0xF6, 0x87, 0xFF, 0x1F, 0xFE, 0x06, 0x80, 0x19, 0x00, 0x00, 0x00,  // #
+0x00, 0x00, 0xE0, 0x70, 0xC0, 0xC7, 0x83, 0x3B, 0x1C, 0xC6, 0x60, 0xF8, 0xFF, 0x67, 0x18, 0x06, 0xC7, 0x0F, 0x18, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00,  // $
+0x3C, 0x00, 0xF8, 0x61, 0x20, 0xC4, 0x80, 0x9F, 0x01, 0x3C, 0x03, 0x00, 0xF6, 0x00, 0xEC, 0x07, 0x98, 0x10, 0x30, 0x7E, 0x60, 0xF0, 0x00, 0x00, 0x00,  // %
+0x00, 0x00, 0x00, 0x78, 0xC0, 0xF3, 0x83, 0x5F, 0x18, 0xC6, 0x61, 0x18, 0x8F, 0xE1, 0x67, 0x03, 0x0F, 0x07, 0x00, 0x7F, 0x00, 0x8C, 0x00, 0x00, 0x00,  // &
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3E, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // '
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x0F, 0xE0, 0xFF, 0xC1, 0x01, 0x8E, 0x01, 0x60, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00,  // (
+0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0xA0, 0x01, 0x60, 0x1C, 0xE0, 0xE0, 0xFF, 0x01, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // )
+0x00, 0x00, 0x00, 0x00, 0xC0, 0x02, 0x00, 0x0E, 0x00, 0x1E, 0x00, 0x78, 0x00, 0x80, 0x03, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // *
+0x80, 0x01, 0x00, 0x06, 0x00, 0x18, 0x00, 0x60, 0x00, 0xF8, 0x1F, 0xE0, 0x7F, 0x00, 0x18, 0x00, 0x60, 0x00, 0x80, 0x01, 0x00, 0x06, 0x00, 0x00, 0x00,  // +
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x02, 0x80, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // ,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0x00, 0x06, 0x00, 0x18, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // -
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x00, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // .
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x7F, 0xC0, 0x3F, 0xE0, 0x0F, 0x80, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // /
+0x00, 0x00, 0xC0, 0x3F, 0xC0, 0xFF, 0x83, 0x03, 0x1C, 0x86, 0x61, 0x18, 0x86, 0xE1, 0x00, 0x07, 0xFF, 0x0F, 0xF0, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0
+0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x06, 0x00, 0x0C, 0x00, 0xF8, 0xFF, 0xE1, 0xFF, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 1
+0x00, 0x00, 0xE0, 0xC0, 0xC1, 0x83, 0x87, 0x03, 0x1B, 0x06, 0x66, 0x18, 0x8C, 0xE1, 0x18, 0x06, 0x3F, 0x18, 0x78, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00,  // 2
+0x00, 0x00, 0x60, 0x60, 0xC0, 0x81, 0x83, 0x01, 0x1C, 0xC6, 0x60, 0x18, 0x83, 0xC1, 0x1F, 0x07, 0xCE, 0x0F, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00,  // 3
+0x00, 0x00, 0x00, 0x38, 0x00, 0xF8, 0x00, 0x7C, 0x03, 0x3C, 0x0C, 0xF8, 0xFF, 0xE1, 0xFF, 0x07, 0x00, 0x03, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00,  // 4
+0x00, 0x00, 0xF8, 0x67, 0xE0, 0x9F, 0x83, 0x21, 0x1C, 0xC6, 0x60, 0x18, 0x83, 0x61, 0x1C, 0x87, 0xE1, 0x0F, 0x00, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00,  // 5
+0x00, 0x00, 0xC0, 0x3F, 0xC0, 0xFF, 0x83, 0x63, 0x1C, 0xC6, 0x60, 0x18, 0x83, 0xE1, 0x1C, 0x07, 0xE7, 0x0F, 0x18, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00,  // 6
+0x00, 0x00, 0x18, 0x00, 0x60, 0x00, 0x80, 0x01, 0x1C, 0x06, 0x7F, 0x18, 0x1F, 0x60, 0x0F, 0x80, 0x0F, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 7
+0x00, 0x00, 0xE0, 0x78, 0xC0, 0xF7, 0x83, 0x61, 0x18, 0x86, 0x61, 0x18, 0x86, 0xE1, 0x18, 0x06, 0xDF, 0x0F, 0x38, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00,  // 8
+0x00, 0x00, 0xE0, 0x63, 0xC0, 0x9F, 0x83, 0xE3, 0x1C, 0x06, 0x63, 0x18, 0x8C, 0xE1, 0x18, 0x07, 0xFF, 0x0F, 0xF0, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00,  // 9
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x80, 0x81, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // :
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x60, 0x02, 0x83, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // ;
+0x00, 0x00, 0x00, 0x04, 0x00, 0x38, 0x00, 0xA0, 0x00, 0xC0, 0x06, 0x00, 0x11, 0x00, 0xC6, 0x00, 0x08, 0x02, 0x30, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00,  // <
+0x00, 0x00, 0x80, 0x19, 0x00, 0x66, 0x00, 0x98, 0x01, 0x60, 0x06, 0x80, 0x19, 0x00, 0x66, 0x00, 0x98, 0x01, 0x60, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00,  // =
+0x00, 0x00, 0xC0, 0x60, 0x00, 0x82, 0x00, 0x18, 0x03, 0x40, 0x04, 0x00, 0x1B, 0x00, 0x28, 0x00, 0xE0, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,  // >
+0x00, 0x00, 0x60, 0x00, 0xC0, 0x01, 0x80, 0x03, 0x00, 0x06, 0x6E, 0x18, 0xBC, 0x61, 0x38, 0x80, 0x73, 0x00, 0xFC, 0x00, 0xE0, 0x01, 0x00, 0x00, 0x00,  // ?
+0x00, 0x00, 0xC0, 0x3F, 0xC0, 0xFF, 0x83, 0x07, 0x1C, 0xC6, 0x63, 0x18, 0x9F, 0x61, 0x66, 0x03, 0xFF, 0x01, 0xF8, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00,  // @
+0x00, 0x00, 0x00, 0xC0, 0x01, 0xF8, 0x07, 0xFE, 0x03, 0x7E, 0x06, 0x18, 0x18, 0xE0, 0x67, 0x00, 0xFE, 0x03, 0x80, 0x7F, 0x00, 0xC0, 0x01, 0x00, 0x00,  // A
+0x00, 0x00, 0xF8, 0xFF, 0xE1, 0xFF, 0x87, 0x61, 0x18, 0x86, 0x61, 0x18, 0x86, 0xC1, 0x3F, 0x07, 0x9E, 0x0F, 0x00, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00,  // B
+0x00, 0x00, 0xC0, 0x3F, 0xC0, 0xFF, 0x83, 0x03, 0x1C, 0x06, 0x60, 0x18, 0x80, 0x61, 0x00, 0x06, 0x07, 0x0E, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00,  // C
+0x00, 0x00, 0xF8, 0xFF, 0xE1, 0xFF, 0x87, 0x01, 0x18, 0x06, 0x60, 0x18, 0x80, 0xC1, 0x81, 0x03, 0xFF, 0x07, 0xF0, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00,  // D
+0x00, 0x00, 0xF8, 0xFF, 0xE1, 0xFF, 0x87, 0x61, 0x18, 0x86, 0x61, 0x18, 0x86, 0x61, 0x18, 0x86, 0x61, 0x18, 0x06, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00,  // E
+0x00, 0x00, 0xF8, 0xFF, 0xE1, 0xFF, 0x87, 0x61, 0x00, 0x86, 0x01, 0x18, 0x06, 0x60, 0x18, 0x80, 0x61, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // F
+0x00, 0x00, 0xC0, 0x3F, 0xC0, 0xFF, 0x83, 0x03, 0x1C, 0x06, 0x60, 0x18, 0x80, 0x61, 0x30, 0x06, 0xC7, 0x0F, 0x18, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00,  // G
+0x00, 0x00, 0xF8, 0xFF, 0xE1, 0xFF, 0x07, 0x60, 0x00, 0x80, 0x01, 0x00, 0x06, 0x00, 0x18, 0x80, 0xFF, 0x1F, 0xFE, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00,  // H
+0x00, 0x00, 0x00, 0x00, 0x60, 0x00, 0x86, 0x01, 0x18, 0xFE, 0x7F, 0xF8, 0xFF, 0x61, 0x00, 0x86, 0x01, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // I
+0x00, 0x00, 0x00, 0x70, 0x00, 0xC0, 0x03, 0x00, 0x1C, 0x00, 0x60, 0x00, 0x80, 0x01, 0x00, 0x87, 0xFF, 0x0F, 0xFE, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00,  // J
+0x00, 0x00, 0xF8, 0xFF, 0xE1, 0xFF, 0x07, 0x60, 0x00, 0xC0, 0x01, 0xC0, 0x1D, 0x80, 0xE3, 0x00, 0x03, 0x0E, 0x06, 0x70, 0x08, 0x00, 0x01, 0x00, 0x00,  // K
+0x00, 0x00, 0xF8, 0xFF, 0xE1, 0xFF, 0x07, 0x00, 0x18, 0x00, 0x60, 0x00, 0x80, 0x01, 0x00, 0x06, 0x00, 0x18, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00,  // L
+0x00, 0x00, 0xF8, 0xFF, 0xE1, 0xFF, 0x87, 0x07, 0x00, 0xF8, 0x00, 0x00, 0x06, 0x80, 0x0F, 0x80, 0x03, 0x00, 0xFE, 0x7F, 0xF8, 0xFF, 0x01, 0x00, 0x00,  // M
+0x00, 0x00, 0xF8, 0xFF, 0xE1, 0xFF, 0x87, 0x0F, 0x00, 0xF8, 0x01, 0x00, 0x7F, 0x00, 0xC0, 0x87, 0xFF, 0x1F, 0xFE, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00,  // N
+0x00, 0x00, 0xC0, 0x3F, 0xC0, 0xFF, 0x83, 0x03, 0x1C, 0x06, 0x60, 0x18, 0x80, 0xE1, 0x00, 0x07, 0xFF, 0x0F, 0xF0, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00,  // O
+0x00, 0x00, 0xF8, 0xFF, 0xE1, 0xFF, 0x87, 0xC1, 0x00, 0x06, 0x03, 0x18, 0x0C, 0xE0, 0x38, 0x00, 0x7F, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // P
+0x00, 0x00, 0xC0, 0x3F, 0xC0, 0xFF, 0x83, 0x03, 0x1C, 0x06, 0x60, 0x18, 0xB0, 0xE1, 0x80, 0x07, 0xFF, 0x0F, 0xF0, 0x2F, 0x00, 0x00, 0x01, 0x00, 0x00,  // Q
+0x00, 0x00, 0xF8, 0xFF, 0xE1, 0xFF, 0x87, 0x61, 0x00, 0x86, 0x01, 0x18, 0x0E, 0xE0, 0xFC, 0x00, 0x3F, 0x0F, 0x78, 0x70, 0x00, 0x00, 0x01, 0x00, 0x00,  // R
+0x00, 0x00, 0x00, 0x30, 0x80, 0xC7, 0x03, 0x3F, 0x1C, 0xC6, 0x60, 0x18, 0x86, 0x61, 0x38, 0x06, 0xC7, 0x0F, 0x18, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00,  // S
+0x06, 0x00, 0x18, 0x00, 0x60, 0x00, 0x80, 0x01, 0x00, 0xFE, 0x7F, 0xF8, 0xFF, 0x61, 0x00, 0x80, 0x01, 0x00, 0x06, 0x00, 0x18, 0x00, 0x00, 0x00, 0x00,  // T
+0x00, 0x00, 0xF8, 0x7F, 0xE0, 0xFF, 0x03, 0x00, 0x1C, 0x00, 0x60, 0x00, 0x80, 0x01, 0x00, 0x87, 0xFF, 0x0F, 0xFE, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00,  // U
+0x00, 0x00, 0x38, 0x00, 0xE0, 0x07, 0x00, 0xFC, 0x01, 0x80, 0x3F, 0x00, 0xE0, 0x01, 0xF8, 0x03, 0xFC, 0x01, 0x7E, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00,  // V
+0x7E, 0x00, 0xF8, 0xFF, 0x01, 0x00, 0x07, 0x80, 0x07, 0xC0, 0x03, 0x00, 0x0F, 0x00, 0xE0, 0x01, 0x00, 0x1C, 0xFE, 0x7F, 0xF8, 0x01, 0x00, 0x00, 0x00,  // W
+0x02, 0x40, 0x38, 0xC0, 0xC1, 0x83, 0x03, 0x9C, 0x07, 0xE0, 0x0F, 0x00, 0x1F, 0x00, 0xE7, 0x00, 0x0E, 0x0F, 0x0E, 0x70, 0x08, 0x00, 0x01, 0x00, 0x00,  // X
+0x02, 0x00, 0x38, 0x00, 0xC0, 0x03, 0x00, 0x3C, 0x00, 0xC0, 0x7F, 0x00, 0xFF, 0x01, 0x0F, 0x00, 0x0F, 0x00, 0x0E, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00,  // Y
+0x00, 0x00, 0x00, 0xC0, 0x61, 0x80, 0x87, 0x81, 0x1B, 0x86, 0x67, 0x18, 0x87, 0x61, 0x07, 0x86, 0x0F, 0x18, 0x0E, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00,  // Z
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F, 0x00, 0xF0, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // [
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x03, 0x00, 0xFE, 0x00, 0xC0, 0x3F, 0x00, 0xF0, 0x07, 0x00, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x5C
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x00, 0xC0, 0x03, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // ]
+0x00, 0x00, 0x00, 0x06, 0x00, 0x1E, 0x00, 0x1E, 0x00, 0x0E, 0x00, 0x38, 0x00, 0x80, 0x07, 0x00, 0x78, 0x00, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,  // ^
+0x00, 0x00, 0x01, 0x00, 0x04, 0x00, 0x10, 0x00, 0x40, 0x00, 0x00, 0x01, 0x00, 0x04, 0x00, 0x10, 0x00, 0x40, 0x00, 0x00, 0x01, 0x00, 0x04, 0x00, 0x10,  // _
+0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x80, 0x01, 0x00, 0x0E, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // `
+0x00, 0x00, 0x00, 0xE2, 0x00, 0xCC, 0x07, 0x98, 0x19, 0x60, 0x66, 0x80, 0x99, 0x00, 0x66, 0x03, 0xF8, 0x0F, 0xC0, 0x7F, 0x00, 0x00, 0x01, 0x00, 0x00,  // a
+0x00, 0x00, 0xF8, 0xFF, 0xE1, 0xFF, 0x07, 0x30, 0x0C, 0x60, 0x60, 0x80, 0x81, 0x01, 0x0E, 0x07, 0xF0, 0x0F, 0x80, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00,  // b
+0x00, 0x00, 0x00, 0x7E, 0x00, 0xFC, 0x03, 0x38, 0x1C, 0x60, 0x60, 0x80, 0x81, 0x01, 0x0E, 0x07, 0x70, 0x0E, 0x80, 0x19, 0x00, 0x00, 0x00, 0x00, 0x00,  // c
+0x00, 0x00, 0x00, 0x7E, 0x00, 0xFC, 0x03, 0x38, 0x1C, 0x60, 0x60, 0x80, 0x81, 0x01, 0x0C, 0x83, 0xFF, 0x1F, 0xFE, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00,  // d
+0x00, 0x00, 0x00, 0x7E, 0x00, 0xFC, 0x03, 0xB8, 0x1D, 0x60, 0x66, 0x80, 0x99, 0x01, 0x6E, 0x06, 0xF0, 0x0D, 0x00, 0x17, 0x00, 0x00, 0x00, 0x00, 0x00,  // e
+0x00, 0x00, 0x80, 0x01, 0x00, 0x06, 0x00, 0x18, 0x00, 0xFC, 0x7F, 0xF8, 0xFF, 0x61, 0x06, 0x80, 0x19, 0x00, 0x66, 0x00, 0x18, 0x00, 0x00, 0x00, 0x00,  // f
+0x00, 0x00, 0x00, 0x3F, 0x06, 0xFE, 0x39, 0x1C, 0xCE, 0x30, 0x30, 0xC3, 0xC0, 0x0C, 0x86, 0x39, 0xFC, 0x7F, 0xF0, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00,  // g
+0x00, 0x00, 0xF8, 0xFF, 0xE1, 0xFF, 0x07, 0x30, 0x00, 0x60, 0x00, 0x80, 0x01, 0x00, 0x06, 0x00, 0xF8, 0x1F, 0xC0, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00,  // h
+0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x18, 0x00, 0x60, 0x00, 0x98, 0xFF, 0x61, 0xFE, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // i
+0x00, 0x00, 0x00, 0x00, 0x06, 0x03, 0x30, 0x0C, 0xC0, 0x30, 0x00, 0xCF, 0xFF, 0x3F, 0xFF, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // j
+0x00, 0x00, 0xF8, 0xFF, 0xE1, 0xFF, 0x07, 0x80, 0x01, 0x00, 0x03, 0x00, 0x1E, 0x00, 0xCC, 0x01, 0x18, 0x0E, 0x20, 0x60, 0x00, 0x00, 0x01, 0x00, 0x00,  // k
+0x00, 0x00, 0x00, 0x00, 0x60, 0x00, 0x80, 0x01, 0x00, 0x06, 0x00, 0xF8, 0xFF, 0xE1, 0xFF, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // l
+0xE0, 0x7F, 0x80, 0xFF, 0x01, 0x04, 0x00, 0x18, 0x00, 0xE0, 0x7F, 0x80, 0xFF, 0x01, 0x0C, 0x00, 0x18, 0x00, 0xE0, 0x7F, 0x00, 0xFF, 0x01, 0x00, 0x00,  // m
+0x00, 0x00, 0x80, 0xFF, 0x01, 0xFE, 0x07, 0x30, 0x00, 0x60, 0x00, 0x80, 0x01, 0x00, 0x06, 0x00, 0xF8, 0x1F, 0xC0, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00,  // n
+0x00, 0x00, 0x00, 0x7E, 0x00, 0xFC, 0x03, 0x38, 0x1C, 0x60, 0x60, 0x80, 0x81, 0x01, 0x0E, 0x07, 0xF0, 0x0F, 0x80, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00,  // o
+0x00, 0x00, 0xC0, 0xFF, 0x0F, 0xFF, 0x3F, 0x18, 0x06, 0x30, 0x30, 0xC0, 0xC0, 0x00, 0x87, 0x03, 0xF8, 0x07, 0xC0, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00,  // p
+0x00, 0x00, 0x00, 0x3F, 0x00, 0xFE, 0x01, 0x1C, 0x0E, 0x30, 0x30, 0xC0, 0xC0, 0x00, 0x86, 0x01, 0xFC, 0xFF, 0xF0, 0xFF, 0x03, 0x00, 0x00, 0x00, 0x00,  // q
+0x00, 0x00, 0x80, 0x00, 0x00, 0xFE, 0x07, 0xF0, 0x1F, 0xC0, 0x00, 0x80, 0x01, 0x00, 0x06, 0x00, 0x38, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // r
+0x00, 0x00, 0x00, 0xCE, 0x00, 0x7C, 0x03, 0x98, 0x19, 0x60, 0x66, 0x80, 0x99, 0x01, 0x66, 0x06, 0xB0, 0x0F, 0xC0, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00,  // s
+0x00, 0x00, 0x80, 0x01, 0x00, 0x06, 0x00, 0xFE, 0x0F, 0xFC, 0x7F, 0x80, 0x81, 0x01, 0x06, 0x06, 0x18, 0x18, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00,  // t
+0x00, 0x00, 0x80, 0xFF, 0x00, 0xFE, 0x07, 0x00, 0x18, 0x00, 0x60, 0x00, 0x80, 0x01, 0x00, 0x03, 0xF8, 0x1F, 0xE0, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00,  // u
+0x00, 0x00, 0x80, 0x00, 0x00, 0x1E, 0x00, 0xF0, 0x03, 0x00, 0x3E, 0x00, 0xC0, 0x01, 0xE0, 0x07, 0xF0, 0x03, 0xE0, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00,  // v
+0xE0, 0x00, 0x80, 0x7F, 0x00, 0x80, 0x07, 0xF8, 0x07, 0xE0, 0x00, 0x80, 0x7F, 0x00, 0x80, 0x07, 0xF8, 0x07, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // w
+0x00, 0x00, 0x80, 0x00, 0x01, 0x0E, 0x07, 0x70, 0x0E, 0x00, 0x0F, 0x00, 0x3C, 0x00, 0x9C, 0x03, 0x38, 0x1C, 0x20, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,  // x
+0x00, 0x00, 0xC0, 0x00, 0x0C, 0x1F, 0x30, 0xF0, 0xE3, 0x00, 0xFE, 0x01, 0xC0, 0x07, 0xF8, 0x07, 0xFC, 0x03, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // y
+0x00, 0x00, 0x80, 0x81, 0x01, 0x06, 0x07, 0x18, 0x1E, 0x60, 0x6C, 0x80, 0x99, 0x01, 0x36, 0x06, 0x78, 0x18, 0xE0, 0x60, 0x80, 0x81, 0x01, 0x00, 0x00,  // z
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x00, 0x80, 0x07, 0xF8, 0xFF, 0xF7, 0xCF, 0xFF, 0x00, 0xC0, 0x03, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00,  // {
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0xFF, 0xFF, 0xFF, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // |
+0x00, 0x00, 0x00, 0x00, 0x30, 0x00, 0xF0, 0x00, 0xC0, 0xFF, 0xFC, 0xFB, 0xFF, 0x07, 0x78, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // }
+0x00, 0x00, 0x00, 0x0C, 0x00, 0x18, 0x00, 0x60, 0x00, 0x80, 0x01, 0x00, 0x0C, 0x00, 0x30, 0x00, 0xC0, 0x00, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,  // ~
+};
+
+const uint8_t Font16x26 [] = {
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // sp
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x3F, 0xC0, 0xC1, 0xFF, 0x1F, 0x07, 0xFF, 0x7F, 0x1C, 0xFC, 0xFF, 0x71, 0xF0, 0x0F, 0xC0, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // !
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x1F, 0x00, 0x00, 0x7F, 0x00, 0x00, 0xFC, 0x01, 0x00, 0xF0, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x07, 0x00, 0xC0, 0x1F, 0x00, 0x00, 0x7F, 0x00, 0x00, 0xFC, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // "
+0x00, 0x60, 0x00, 0x00, 0x82, 0x01, 0x00, 0x0C, 0xC6, 0x01, 0x30, 0xF8, 0x07, 0xC0, 0xFE, 0x1F, 0x80, 0xFF, 0x3F, 0xE0, 0xFF, 0x0F, 0xC0, 0xFF, 0x1B, 0x06, 0xFF, 0xE0, 0x1F, 0x1C, 0xF3, 0x7F, 0x00, 0xFC, 0xFF, 0x01, 0xFF, 0x7F, 0x00, 0xFF, 0x7F, 0x00, 0xFC, 0x83, 0x01, 0xF0, 0x0C, 0x06, 0x00, 0x30, 0x18, 0x00,  // #
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x00, 0x3F, 0x00, 0x03, 0xFE, 0x01, 0x1C, 0xF8, 0x0F, 0x70, 0xF0, 0x7F, 0x80, 0xC1, 0xE1, 0xFF, 0x1F, 0xFF, 0xFF, 0x7F, 0xFC, 0xFF, 0xFF, 0xF1, 0xFF, 0xFF, 0xC7, 0x00, 0xFF, 0x07, 0x07, 0xF8, 0x0F, 0x1C, 0xE0, 0x3F, 0x60, 0x00, 0x7F, 0x00, 0x00, 0x00, 0x00,  // $
+0xFE, 0x01, 0x18, 0xF8, 0x07, 0x70, 0xF0, 0x3F, 0xF0, 0xC1, 0xC0, 0xE0, 0x03, 0x01, 0xC2, 0x07, 0x3C, 0xCF, 0x07, 0xF0, 0xBF, 0x0F, 0x80, 0xFF, 0x1F, 0x00, 0xFC, 0xFF, 0x07, 0x00, 0xFE, 0x3F, 0x00, 0xBE, 0xFF, 0x01, 0x7C, 0xFE, 0x07, 0xFC, 0x18, 0x18, 0xF8, 0x60, 0x60, 0xF0, 0x81, 0xFF, 0xC1, 0x01, 0xFE, 0x07,  // %
+0x00, 0xF8, 0x03, 0x00, 0xF0, 0x1F, 0x00, 0xC0, 0xFF, 0x00, 0x8E, 0xFF, 0x07, 0xFE, 0x0F, 0x1E, 0xFC, 0x1F, 0x70, 0xF0, 0xFF, 0x81, 0xC1, 0xFF, 0x0F, 0x06, 0x83, 0xFF, 0x18, 0xFC, 0xF7, 0x77, 0xF0, 0x1F, 0xFF, 0x81, 0x3F, 0xF8, 0x03, 0x7E, 0x80, 0x1F, 0x00, 0xC0, 0x7F, 0x00, 0xC0, 0xFF, 0x01, 0x00, 0x7F, 0x07,  // &
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x03, 0x00, 0xC0, 0x1F, 0x00, 0x00, 0x7F, 0x00, 0x00, 0xFC, 0x01, 0x00, 0xF0, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // '
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x80, 0xFF, 0x1F, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x0F, 0xFC, 0x81, 0x3F, 0xF8, 0x00, 0xF0, 0xF1, 0x00, 0x00, 0xCF, 0x01, 0x00, 0x38, 0x03, 0x00, 0xC0, 0x0D, 0x00, 0x00, 0x17, 0x00, 0x00, 0x58, 0x00, 0x00, 0x60,  // (
+0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x16, 0x00, 0x00, 0xD8, 0x00, 0x00, 0x70, 0x03, 0x00, 0xC0, 0x1D, 0x00, 0x80, 0xF3, 0x00, 0x00, 0x8F, 0x0F, 0x00, 0x1F, 0xFC, 0x81, 0x3F, 0xF0, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xF8, 0xFF, 0x01, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // )
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x03, 0x00, 0x00, 0x0E, 0x01, 0x00, 0x38, 0x06, 0x00, 0xC0, 0x3C, 0x00, 0x30, 0xFF, 0x00, 0xC0, 0xFF, 0x01, 0x00, 0x1F, 0x01, 0x00, 0xFC, 0x0E, 0x00, 0x10, 0xFF, 0x00, 0x00, 0xEC, 0x03, 0x00, 0x38, 0x0F, 0x00, 0xE0, 0x10, 0x00, 0x80, 0x03, 0x00, 0x00, 0x0C, 0x00, 0x00,  // *
+0x00, 0x60, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x06, 0x00, 0x00, 0x18, 0x00, 0x00, 0x60, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x06, 0x00, 0xF0, 0xFF, 0x07, 0xC0, 0xFF, 0x1F, 0x00, 0xFF, 0x7F, 0x00, 0x00, 0x06, 0x00, 0x00, 0x18, 0x00, 0x00, 0x60, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x06, 0x00, 0x00, 0x18, 0x00,  // +
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x21, 0x00, 0x80, 0xFF, 0x00, 0x00, 0xFE, 0x03, 0x00, 0xF8, 0x07, 0x00, 0xE0, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // ,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x06, 0x00, 0x00, 0x18, 0x00, 0x00, 0x60, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x06, 0x00, 0x00, 0x18, 0x00, 0x00, 0x60, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x06, 0x00, 0x00, 0x18, 0x00, 0x00, 0x60, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00,  // -
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x01, 0x00, 0x80, 0x07, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x78, 0x00, 0x00, 0xE0, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // .
+0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x07, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x7F, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFC, 0x00, 0x00, 0xF0, 0x00, 0x00, 0xC0, 0x00, 0x00, 0x00,  // /
+0x00, 0x00, 0x00, 0x80, 0xFF, 0x03, 0x80, 0xFF, 0x3F, 0x00, 0xFF, 0xFF, 0x01, 0xFE, 0xFF, 0x0F, 0xFC, 0x01, 0x7F, 0xF0, 0x00, 0xE0, 0xC1, 0x01, 0x00, 0x07, 0x03, 0x00, 0x18, 0x1C, 0x00, 0x70, 0xF0, 0x00, 0xE0, 0xC1, 0x1F, 0xF0, 0x07, 0xFE, 0xFF, 0x0F, 0xF0, 0xFF, 0x1F, 0x80, 0xFF, 0x3F, 0x00, 0xF8, 0x3F, 0x00,  // 0
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x00, 0x80, 0x01, 0x03, 0x00, 0x06, 0x0C, 0x00, 0x18, 0x38, 0x00, 0x60, 0xE0, 0x00, 0x80, 0x81, 0xFF, 0xFF, 0x07, 0xFF, 0xFF, 0x1F, 0xFC, 0xFF, 0x7F, 0xF0, 0xFF, 0xFF, 0xC1, 0xFF, 0xFF, 0x07, 0x00, 0x00, 0x18, 0x00, 0x00, 0x60, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x06,  // 1
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x00, 0xE0, 0x81, 0x01, 0xC0, 0x07, 0x07, 0x80, 0x1F, 0x1C, 0x80, 0x7F, 0x30, 0x00, 0xBF, 0xC1, 0x00, 0x3E, 0x06, 0x03, 0x7C, 0x18, 0x1C, 0xF8, 0x60, 0xF0, 0xFF, 0x81, 0x81, 0xFF, 0x03, 0x06, 0xFE, 0x07, 0x18, 0xF0, 0x0F, 0x60, 0x00, 0x07, 0x80, 0x01, 0x00, 0x00, 0x00,  // 2
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0x00, 0x07, 0x07, 0x06, 0x1C, 0x1C, 0x18, 0x70, 0x30, 0x60, 0x80, 0xC1, 0x80, 0x01, 0x06, 0x03, 0x07, 0x18, 0x1C, 0x3C, 0x70, 0xF0, 0xFF, 0xE1, 0xC1, 0xFF, 0xFF, 0x03, 0xFE, 0xFD, 0x0F, 0xF0, 0xE3, 0x1F, 0x80, 0x03, 0x3F, 0x00, 0x00, 0x00, 0x00,  // 3
+0x00, 0x60, 0x00, 0x00, 0xE0, 0x01, 0x00, 0xC0, 0x07, 0x00, 0xC0, 0x1F, 0x00, 0x80, 0x7F, 0x00, 0x80, 0x9F, 0x01, 0x00, 0x3F, 0x06, 0x00, 0x3E, 0x18, 0x00, 0x7E, 0x60, 0x00, 0xFC, 0xFF, 0x7F, 0xF0, 0xFF, 0xFF, 0xC1, 0xFF, 0xFF, 0x07, 0xFF, 0xFF, 0x1F, 0x00, 0x80, 0x01, 0x00, 0x00, 0x06, 0x00, 0x00, 0x18, 0x00,  // 4
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xFF, 0x00, 0x07, 0xFF, 0x03, 0x1C, 0xFC, 0x0F, 0x70, 0xF0, 0x3F, 0x80, 0xC1, 0xC1, 0x00, 0x06, 0x07, 0x07, 0x18, 0x1C, 0x3C, 0x70, 0x70, 0xF0, 0xFB, 0xC1, 0x81, 0xFF, 0x03, 0x07, 0xFE, 0x0F, 0x1C, 0xF0, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00, 0x00,  // 5
+0x00, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0xFE, 0x1F, 0x00, 0xFE, 0xFF, 0x01, 0xFC, 0xFF, 0x0F, 0xF8, 0xFF, 0x3F, 0xE0, 0xE3, 0xF0, 0xC1, 0xC3, 0x01, 0x07, 0x07, 0x03, 0x18, 0x0C, 0x0C, 0x60, 0x30, 0x70, 0xC0, 0xC1, 0xC0, 0x83, 0x07, 0x07, 0xFF, 0x0F, 0x1C, 0xF8, 0x3F, 0x60, 0xC0, 0x7F, 0x00, 0x00, 0xFE, 0x00,  // 6
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0xC0, 0x01, 0x00, 0x06, 0x07, 0x00, 0x1F, 0x1C, 0x00, 0x7E, 0x70, 0x00, 0xFE, 0xC1, 0x01, 0xFE, 0x07, 0x07, 0xFE, 0x03, 0x1C, 0xFC, 0x01, 0x70, 0xFC, 0x01, 0xC0, 0xFD, 0x01, 0x00, 0xFF, 0x01, 0x00, 0xFC, 0x01, 0x00, 0xF0, 0x03, 0x00, 0xC0, 0x03, 0x00, 0x00,  // 7
+0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x00, 0x03, 0x7F, 0x00, 0x3F, 0xFE, 0x03, 0xFE, 0xFD, 0x0F, 0xFC, 0xFF, 0x7F, 0xF0, 0xFF, 0xC1, 0xC1, 0xE1, 0x01, 0x07, 0x03, 0x0F, 0x18, 0x0C, 0x3C, 0x60, 0x70, 0xF8, 0xC1, 0xC1, 0xFF, 0x9F, 0x07, 0xFF, 0xFD, 0x0F, 0xF8, 0xE3, 0x3F, 0xC0, 0x07, 0x7F, 0x00, 0x00, 0xF8, 0x00,  // 8
+0x00, 0x00, 0x00, 0x80, 0x07, 0x00, 0x80, 0x7F, 0xC0, 0x00, 0xFF, 0x03, 0x07, 0xFE, 0x0F, 0x1C, 0xFC, 0x7F, 0x60, 0x70, 0xC0, 0x81, 0xC1, 0x00, 0x06, 0x06, 0x03, 0x18, 0x1C, 0x1C, 0x60, 0x70, 0xF0, 0xC0, 0xF1, 0xC1, 0xFF, 0xFB, 0x03, 0xFE, 0xFF, 0x07, 0xF0, 0xFF, 0x0F, 0x80, 0xFF, 0x1F, 0x00, 0xF8, 0x0F, 0x00,  // 9
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0xE0, 0x01, 0xF0, 0x80, 0x07, 0xC0, 0x03, 0x1E, 0x00, 0x0F, 0x78, 0x00, 0x3C, 0xE0, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // :
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0xE0, 0x31, 0xF0, 0x80, 0xFF, 0xC0, 0x03, 0xFE, 0x03, 0x0F, 0xF8, 0x07, 0x3C, 0xE0, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // ;
+0x00, 0x20, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x1C, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xE0, 0x03, 0x00, 0xC0, 0x1F, 0x00, 0x00, 0x77, 0x00, 0x00, 0x8E, 0x03, 0x00, 0x38, 0x0E, 0x00, 0x70, 0x70, 0x00, 0xC0, 0xC1, 0x01, 0x80, 0x03, 0x0E, 0x00, 0x0E, 0x38, 0x00, 0x1C, 0xC0, 0x01, 0x70, 0x00, 0x07,  // <
+0x00, 0x8C, 0x01, 0x00, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x00, 0x00, 0x63, 0x00, 0x00, 0x8C, 0x01, 0x00, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x00, 0x00, 0x63, 0x00, 0x00, 0x8C, 0x01, 0x00, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x00, 0x00, 0x63, 0x00, 0x00, 0x8C, 0x01, 0x00, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x00, 0x00, 0x63, 0x00,  // =
+0xC0, 0x00, 0x18, 0x00, 0x07, 0x70, 0x00, 0x1C, 0xC0, 0x01, 0xE0, 0x80, 0x03, 0x80, 0x03, 0x0E, 0x00, 0x1C, 0x1C, 0x00, 0x70, 0x70, 0x00, 0x80, 0xE3, 0x00, 0x00, 0x8E, 0x03, 0x00, 0x70, 0x07, 0x00, 0xC0, 0x1D, 0x00, 0x00, 0x3E, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xC0, 0x01, 0x00, 0x00, 0x07, 0x00, 0x00, 0x08, 0x00,  // >
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x01, 0x00, 0xC0, 0x07, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x0C, 0x80, 0x71, 0x30, 0x80, 0xC7, 0xC1, 0x00, 0x1F, 0x07, 0x03, 0x7E, 0x1C, 0x0C, 0xFC, 0x71, 0x70, 0x78, 0x00, 0xC0, 0xFF, 0x00, 0x00, 0xFE, 0x01, 0x00, 0xF8, 0x03, 0x00, 0xC0, 0x07, 0x00, 0x00, 0x06, 0x00, 0x00,  // ?
+0x00, 0x3F, 0x00, 0x80, 0xFF, 0x07, 0x80, 0xFF, 0x3F, 0x00, 0xFF, 0xFF, 0x01, 0x7E, 0x80, 0x0F, 0x78, 0x00, 0x38, 0xF0, 0xF8, 0xCF, 0xC1, 0xF1, 0x7F, 0x07, 0xE3, 0xFF, 0x19, 0xCC, 0x07, 0x67, 0x30, 0x07, 0x9C, 0xC1, 0x0D, 0x7C, 0x07, 0x7F, 0xFE, 0x1C, 0xF8, 0xFF, 0x37, 0xE0, 0xFF, 0x1F, 0x00, 0xFE, 0x7F, 0x00,  // @
+0x00, 0x00, 0x1C, 0x00, 0x00, 0x7C, 0x00, 0x00, 0xFE, 0x01, 0x00, 0xFE, 0x07, 0x00, 0xFF, 0x03, 0x80, 0xFF, 0x03, 0x80, 0xFF, 0x0D, 0x00, 0xFE, 0x30, 0x00, 0xF8, 0xC0, 0x00, 0xE0, 0x1F, 0x03, 0x80, 0xFF, 0x0F, 0x00, 0xF8, 0x7F, 0x00, 0x00, 0xFF, 0x07, 0x00, 0xF0, 0x7F, 0x00, 0x00, 0xFE, 0x01, 0x00, 0xE0, 0x07,  // A
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xFF, 0xFF, 0x01, 0xFE, 0xFF, 0x07, 0xF8, 0xFF, 0x1F, 0xE0, 0xFF, 0x7F, 0x80, 0x81, 0x81, 0x01, 0x06, 0x06, 0x06, 0x18, 0x18, 0x18, 0x60, 0xF0, 0x60, 0x80, 0xE3, 0x83, 0x01, 0xFE, 0x3F, 0x07, 0xF8, 0xF7, 0x1F, 0xC0, 0x9F, 0x3F, 0x00, 0x3E, 0xFE, 0x00, 0x00, 0xF0, 0x01,  // B
+0x00, 0x00, 0x00, 0x00, 0xFC, 0x03, 0x00, 0xFC, 0x3F, 0x00, 0xF8, 0xFF, 0x01, 0xE0, 0xFF, 0x07, 0xC0, 0x07, 0x3F, 0x00, 0x07, 0xF0, 0x00, 0x0E, 0x80, 0x07, 0x38, 0x00, 0x1C, 0x60, 0x00, 0x60, 0x80, 0x01, 0x80, 0x01, 0x06, 0x00, 0x06, 0x18, 0x00, 0x18, 0xE0, 0x00, 0x60, 0x80, 0x03, 0xC0, 0x01, 0x0E, 0x00, 0x07,  // C
+0x00, 0x00, 0x00, 0xE0, 0xFF, 0x7F, 0x80, 0xFF, 0xFF, 0x01, 0xFE, 0xFF, 0x07, 0xF8, 0xFF, 0x1F, 0x60, 0x00, 0x60, 0x80, 0x01, 0x80, 0x01, 0x06, 0x00, 0x06, 0x18, 0x00, 0x18, 0xE0, 0x00, 0x70, 0x80, 0x03, 0xC0, 0x01, 0x3E, 0xC0, 0x03, 0xF0, 0xFF, 0x0F, 0xC0, 0xFF, 0x1F, 0x00, 0xFE, 0x7F, 0x00, 0xF0, 0x7F, 0x00,  // D
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xFF, 0xFF, 0x01, 0xFE, 0xFF, 0x07, 0xF8, 0xFF, 0x1F, 0xE0, 0xFF, 0x7F, 0x80, 0xFF, 0xFF, 0x01, 0x06, 0x06, 0x06, 0x18, 0x18, 0x18, 0x60, 0x60, 0x60, 0x80, 0x81, 0x81, 0x01, 0x06, 0x06, 0x06, 0x18, 0x18, 0x18, 0x60, 0x60, 0x60, 0x80, 0x81, 0x81, 0x01, 0x06, 0x00, 0x06,  // E
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFE, 0xFF, 0x07, 0xF8, 0xFF, 0x1F, 0xE0, 0xFF, 0x7F, 0x80, 0xFF, 0xFF, 0x01, 0x06, 0x06, 0x00, 0x18, 0x18, 0x00, 0x60, 0x60, 0x00, 0x80, 0x81, 0x01, 0x00, 0x06, 0x06, 0x00, 0x18, 0x18, 0x00, 0x60, 0x60, 0x00, 0x80, 0x81, 0x01, 0x00, 0x06, 0x06, 0x00,  // F
+0x00, 0x3C, 0x00, 0x00, 0xFE, 0x07, 0x00, 0xFC, 0x3F, 0x00, 0xF8, 0xFF, 0x01, 0xF0, 0xFF, 0x0F, 0xC0, 0x07, 0x3E, 0x80, 0x07, 0xE0, 0x01, 0x0E, 0x00, 0x07, 0x38, 0x00, 0x1C, 0x60, 0xC0, 0x60, 0x80, 0x01, 0x83, 0x01, 0x06, 0x0C, 0x06, 0x18, 0xF0, 0x1F, 0xE0, 0xC0, 0x7F, 0x80, 0x03, 0xFF, 0x01, 0x0C, 0xFC, 0x03,  // G
+0x00, 0x00, 0x00, 0xE0, 0xFF, 0x7F, 0x80, 0xFF, 0xFF, 0x01, 0xFE, 0xFF, 0x07, 0xF8, 0xFF, 0x1F, 0xE0, 0xFF, 0x7F, 0x00, 0x80, 0x01, 0x00, 0x00, 0x06, 0x00, 0x00, 0x18, 0x00, 0x00, 0x60, 0x00, 0x00, 0x80, 0x01, 0x00, 0xFE, 0xFF, 0x07, 0xF8, 0xFF, 0x1F, 0xE0, 0xFF, 0x7F, 0x80, 0xFF, 0xFF, 0x01, 0xFE, 0xFF, 0x07,  // H
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0x80, 0x01, 0x06, 0x00, 0x06, 0x18, 0x00, 0x18, 0x60, 0x00, 0x60, 0x80, 0xFF, 0xFF, 0x01, 0xFE, 0xFF, 0x07, 0xF8, 0xFF, 0x1F, 0xE0, 0xFF, 0x7F, 0x80, 0xFF, 0xFF, 0x01, 0x06, 0x00, 0x06, 0x18, 0x00, 0x18, 0x60, 0x00, 0x60, 0x80, 0x01, 0x80, 0x01, 0x06, 0x00, 0x06,  // I
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x01, 0x06, 0x00, 0x07, 0x18, 0x00, 0x1C, 0x60, 0x00, 0x60, 0x80, 0x01, 0x80, 0x01, 0x06, 0x00, 0x06, 0x18, 0x00, 0x1C, 0xE0, 0xFF, 0x7F, 0x80, 0xFF, 0xFF, 0x00, 0xFE, 0xFF, 0x03, 0xF8, 0xFF, 0x07, 0xE0, 0xFF, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // J
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xFF, 0xFF, 0x01, 0xFE, 0xFF, 0x07, 0xF8, 0xFF, 0x1F, 0xE0, 0xFF, 0x7F, 0x00, 0xE0, 0x03, 0x00, 0xC0, 0x1F, 0x00, 0x80, 0xFF, 0x00, 0x00, 0xDF, 0x0F, 0x00, 0x3E, 0x7E, 0x00, 0x3E, 0xF0, 0x03, 0x78, 0x00, 0x1F, 0xE0, 0x00, 0x78, 0x80, 0x01, 0xC0, 0x01, 0x02, 0x00, 0x06,  // K
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xFF, 0xFF, 0x01, 0xFE, 0xFF, 0x07, 0xF8, 0xFF, 0x1F, 0xE0, 0xFF, 0x7F, 0x80, 0xFF, 0xFF, 0x01, 0x00, 0x00, 0x06, 0x00, 0x00, 0x18, 0x00, 0x00, 0x60, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x06, 0x00, 0x00, 0x18, 0x00, 0x00, 0x60, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x06,  // L
+0xF8, 0xFF, 0x1F, 0xE0, 0xFF, 0x7F, 0x80, 0xFF, 0xFF, 0x01, 0xFE, 0xFF, 0x07, 0xF8, 0x0F, 0x00, 0xC0, 0xFF, 0x00, 0x00, 0xFC, 0x1F, 0x00, 0x80, 0x7F, 0x00, 0x00, 0xF0, 0x01, 0x00, 0xF8, 0x07, 0x00, 0xFC, 0x0F, 0x00, 0xFE, 0x07, 0x00, 0xF8, 0x03, 0x00, 0xE0, 0xFF, 0x7F, 0x80, 0xFF, 0xFF, 0x01, 0xFE, 0xFF, 0x07,  // M
+0x00, 0x00, 0x00, 0xE0, 0xFF, 0x7F, 0x80, 0xFF, 0xFF, 0x01, 0xFE, 0xFF, 0x07, 0xF8, 0xFF, 0x1F, 0xE0, 0x1F, 0x00, 0x00, 0xFE, 0x00, 0x00, 0xF0, 0x0F, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xF0, 0x07, 0x00, 0x80, 0x7F, 0x00, 0x00, 0xF8, 0x07, 0xF8, 0xFF, 0x1F, 0xE0, 0xFF, 0x7F, 0x80, 0xFF, 0xFF, 0x01, 0xFE, 0xFF, 0x07,  // N
+0x00, 0x7E, 0x00, 0x00, 0xFF, 0x0F, 0x00, 0xFE, 0x7F, 0x00, 0xFC, 0xFF, 0x03, 0xF0, 0xFF, 0x0F, 0xE0, 0x01, 0x78, 0x80, 0x03, 0xC0, 0x01, 0x06, 0x00, 0x06, 0x18, 0x00, 0x18, 0x60, 0x00, 0x60, 0x80, 0x03, 0xC0, 0x01, 0x1E, 0x80, 0x07, 0xF0, 0xFF, 0x0F, 0xC0, 0xFF, 0x3F, 0x00, 0xFE, 0x7F, 0x00, 0xF0, 0xFF, 0x00,  // O
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xFF, 0xFF, 0x01, 0xFE, 0xFF, 0x07, 0xF8, 0xFF, 0x1F, 0xE0, 0xFF, 0x7F, 0x80, 0xFF, 0xFF, 0x01, 0x06, 0x0C, 0x00, 0x18, 0x30, 0x00, 0x60, 0xC0, 0x00, 0x80, 0x81, 0x03, 0x00, 0x0E, 0x0F, 0x00, 0xF8, 0x1F, 0x00, 0xE0, 0x7F, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFC, 0x03, 0x00,  // P
+0x00, 0x7E, 0x00, 0x00, 0xFF, 0x0F, 0x00, 0xFE, 0x7F, 0x00, 0xFC, 0xFF, 0x03, 0xF0, 0xFF, 0x0F, 0xE0, 0x01, 0x78, 0x80, 0x03, 0xC0, 0x01, 0x06, 0x00, 0x06, 0x18, 0x00, 0x18, 0x60, 0x00, 0xE0, 0x80, 0x03, 0xC0, 0x07, 0x1E, 0x80, 0x1F, 0xF0, 0xFF, 0xFF, 0xC0, 0xFF, 0xBF, 0x03, 0xFE, 0x7F, 0x1C, 0xF0, 0xFF, 0x70,  // Q
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xFF, 0xFF, 0x01, 0xFE, 0xFF, 0x07, 0xF8, 0xFF, 0x1F, 0xE0, 0xFF, 0x7F, 0x80, 0x01, 0x03, 0x00, 0x06, 0x1C, 0x00, 0x18, 0xF8, 0x00, 0xE0, 0xE0, 0x07, 0x80, 0xE7, 0x3F, 0x00, 0xFE, 0xF7, 0x03, 0xF0, 0x8F, 0x1F, 0xC0, 0x3F, 0x7C, 0x00, 0x3E, 0xE0, 0x01, 0x00, 0x00, 0x06,  // R
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3E, 0xE0, 0x00, 0xFC, 0x01, 0x07, 0xF0, 0x0F, 0x1C, 0xE0, 0x3F, 0x70, 0x80, 0xE3, 0x81, 0x01, 0x06, 0x07, 0x06, 0x18, 0x1C, 0x18, 0x60, 0xF0, 0x60, 0x80, 0x81, 0xC3, 0x01, 0x06, 0x9E, 0x07, 0x38, 0xF8, 0x0F, 0xE0, 0xC0, 0x3F, 0x00, 0x03, 0x7F, 0x00, 0x00, 0xF8, 0x00,  // S
+0x18, 0x00, 0x00, 0x60, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x06, 0x00, 0x00, 0x18, 0x00, 0x00, 0x60, 0x00, 0x00, 0x80, 0xFF, 0xFF, 0x01, 0xFE, 0xFF, 0x07, 0xF8, 0xFF, 0x1F, 0xE0, 0xFF, 0x7F, 0x80, 0xFF, 0xFF, 0x01, 0x06, 0x00, 0x00, 0x18, 0x00, 0x00, 0x60, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x06, 0x00, 0x00,  // T
+0x00, 0x00, 0x00, 0xE0, 0xFF, 0x03, 0x80, 0xFF, 0x7F, 0x00, 0xFE, 0xFF, 0x03, 0xF8, 0xFF, 0x0F, 0xE0, 0xFF, 0x7F, 0x00, 0x00, 0xC0, 0x01, 0x00, 0x00, 0x06, 0x00, 0x00, 0x18, 0x00, 0x00, 0x60, 0x00, 0x00, 0xC0, 0x01, 0x00, 0xC0, 0x07, 0xF8, 0xFF, 0x0F, 0xE0, 0xFF, 0x3F, 0x80, 0xFF, 0x7F, 0x00, 0xFE, 0x3F, 0x00,  // U
+0x38, 0x00, 0x00, 0xE0, 0x03, 0x00, 0x80, 0x7F, 0x00, 0x00, 0xFE, 0x0F, 0x00, 0xE0, 0xFF, 0x00, 0x00, 0xFE, 0x1F, 0x00, 0xC0, 0xFF, 0x01, 0x00, 0xFC, 0x07, 0x00, 0x80, 0x1F, 0x00, 0x80, 0x7F, 0x00, 0x80, 0xFF, 0x01, 0xC0, 0xFF, 0x01, 0xC0, 0xFF, 0x00, 0xE0, 0x7F, 0x00, 0x80, 0x7F, 0x00, 0x00, 0x3E, 0x00, 0x00,  // V
+0xF8, 0x03, 0x00, 0xE0, 0xFF, 0x07, 0x80, 0xFF, 0xFF, 0x01, 0xFC, 0xFF, 0x07, 0x00, 0xF8, 0x1F, 0x00, 0xC0, 0x7F, 0x00, 0xF8, 0xFF, 0x01, 0xE0, 0xFF, 0x00, 0x80, 0x3F, 0x00, 0x00, 0xFE, 0x0F, 0x00, 0xF8, 0xFF, 0x01, 0x00, 0xFE, 0x07, 0x00, 0xE0, 0x1F, 0x00, 0xFF, 0x7F, 0x80, 0xFF, 0xFF, 0x01, 0xFE, 0x3F, 0x00,  // W
+0x08, 0x00, 0x10, 0x60, 0x00, 0x70, 0x80, 0x07, 0xE0, 0x01, 0x3E, 0xC0, 0x07, 0xF8, 0xC1, 0x0F, 0xC0, 0x9F, 0x0F, 0x00, 0xFE, 0x1F, 0x00, 0xE0, 0x3F, 0x00, 0x00, 0x7F, 0x00, 0x00, 0xFC, 0x07, 0x00, 0xFC, 0x3F, 0x00, 0xF8, 0xF8, 0x01, 0xF0, 0xC1, 0x1F, 0xE0, 0x03, 0x7E, 0x80, 0x07, 0xE0, 0x01, 0x06, 0x00, 0x07,  // X
+0x08, 0x00, 0x00, 0xE0, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x7E, 0x00, 0x00, 0xF8, 0x07, 0x00, 0x80, 0x3F, 0x00, 0x00, 0xF8, 0xFF, 0x01, 0xC0, 0xFF, 0x07, 0x00, 0xFC, 0x1F, 0x00, 0xF8, 0x7F, 0x00, 0xF0, 0xFF, 0x01, 0xF0, 0x03, 0x00, 0xE0, 0x07, 0x00, 0xE0, 0x07, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x0E, 0x00, 0x00,  // Y
+0x00, 0x00, 0x00, 0x60, 0x00, 0x70, 0x80, 0x01, 0xE0, 0x01, 0x06, 0xC0, 0x07, 0x18, 0xC0, 0x1F, 0x60, 0x80, 0x7F, 0x80, 0x01, 0xBF, 0x01, 0x06, 0x3E, 0x06, 0x18, 0x7E, 0x18, 0x60, 0xFC, 0x60, 0x80, 0xF9, 0x81, 0x01, 0xF6, 0x01, 0x06, 0xF8, 0x03, 0x18, 0xE0, 0x07, 0x60, 0x80, 0x0F, 0x80, 0x01, 0x1E, 0x00, 0x06,  // Z
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0xFF, 0xFF, 0xF7, 0xFF, 0xFF, 0xDF, 0xFF, 0xFF, 0x7F, 0xFF, 0xFF, 0xFF, 0x05, 0x00, 0x00, 0x16, 0x00, 0x00, 0x58, 0x00, 0x00, 0x60, 0x01, 0x00, 0x80, 0x05, 0x00, 0x00, 0x16, 0x00, 0x00, 0x58, 0x00, 0x00, 0x60,  // [
+0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0xF0, 0x00, 0x00, 0xC0, 0x0F, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xF0, 0x0F, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xF0, 0x0F, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xF0, 0x0F, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xF0, 0x0F, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xF0, 0x07, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x70,  // 0x5C
+0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x16, 0x00, 0x00, 0x58, 0x00, 0x00, 0x60, 0x01, 0x00, 0x80, 0x05, 0x00, 0x00, 0x16, 0x00, 0x00, 0x58, 0x00, 0x00, 0x60, 0xFF, 0xFF, 0xFF, 0xFD, 0xFF, 0xFF, 0xF7, 0xFF, 0xFF, 0xDF, 0xFF, 0xFF, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // ]
+0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x7F, 0x00, 0x00, 0xFF, 0x01, 0x80, 0xFF, 0x00, 0x80, 0xFF, 0x00, 0x80, 0xFF, 0x00, 0x00, 0x7F, 0x00, 0x00, 0xFC, 0x07, 0x00, 0x80, 0xFF, 0x00, 0x00, 0xF8, 0x0F, 0x00, 0x80, 0xFF, 0x00, 0x00, 0xF0, 0x07, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x70, 0x00,  // ^
+0x00, 0x00, 0x60, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x06, 0x00, 0x00, 0x18, 0x00, 0x00, 0x60, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x06, 0x00, 0x00, 0x18, 0x00, 0x00, 0x60, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x06, 0x00, 0x00, 0x18, 0x00, 0x00, 0x60, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x06, 0x00, 0x00, 0x18,  // _
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x04, 0x00, 0x00, 0x10, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // `
+0x00, 0x00, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x18, 0xFC, 0x00, 0x60, 0xF8, 0x07, 0xC0, 0xE1, 0x1F, 0x00, 0xC7, 0x7B, 0x00, 0x0C, 0x87, 0x01, 0x30, 0x0C, 0x06, 0xC0, 0x30, 0x18, 0x00, 0xC7, 0x70, 0x00, 0xFC, 0xFF, 0x00, 0xF0, 0xFF, 0x03, 0xC0, 0xFF, 0x1F, 0x00, 0xFE, 0x7F, 0x00, 0xE0, 0xFF, 0x01, 0x00, 0x00, 0x06,  // a
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0xFF, 0xFF, 0xC1, 0xFF, 0xFF, 0x07, 0xFF, 0xFF, 0x1F, 0xFC, 0xFF, 0x3F, 0x00, 0x38, 0xC0, 0x01, 0x70, 0x00, 0x07, 0xC0, 0x00, 0x18, 0x00, 0x03, 0x60, 0x00, 0x1C, 0xC0, 0x01, 0xF0, 0xC0, 0x07, 0xC0, 0xFF, 0x0F, 0x00, 0xFE, 0x3F, 0x00, 0xF8, 0x7F, 0x00, 0x80, 0x7F, 0x00,  // b
+0x00, 0x00, 0x00, 0x00, 0xC0, 0x01, 0x00, 0xE0, 0x3F, 0x00, 0xC0, 0xFF, 0x01, 0x80, 0xFF, 0x0F, 0x00, 0xFE, 0x3F, 0x00, 0x7C, 0xF0, 0x01, 0x70, 0x00, 0x07, 0xC0, 0x01, 0x1C, 0x00, 0x03, 0x60, 0x00, 0x0C, 0x80, 0x01, 0x30, 0x00, 0x06, 0xC0, 0x00, 0x18, 0x00, 0x07, 0x70, 0x00, 0x1C, 0xC0, 0x01, 0x60, 0x00, 0x03,  // c
+0x00, 0x00, 0x00, 0x00, 0xF0, 0x07, 0x00, 0xF0, 0x7F, 0x00, 0xE0, 0xFF, 0x03, 0x80, 0xFF, 0x1F, 0x00, 0x7F, 0x7E, 0x00, 0x1C, 0xC0, 0x01, 0x30, 0x00, 0x06, 0xC0, 0x00, 0x18, 0x00, 0x03, 0x70, 0x00, 0x1C, 0xE0, 0xC0, 0xFF, 0xFF, 0x07, 0xFF, 0xFF, 0x1F, 0xFC, 0xFF, 0x7F, 0xF0, 0xFF, 0xFF, 0xC1, 0xFF, 0xFF, 0x07,  // d
+0x00, 0x00, 0x00, 0x00, 0xE0, 0x03, 0x00, 0xE0, 0x3F, 0x00, 0xC0, 0xFF, 0x01, 0x80, 0xFF, 0x0F, 0x00, 0xFE, 0x3F, 0x00, 0x3C, 0xE3, 0x01, 0x70, 0x0C, 0x07, 0xC0, 0x30, 0x18, 0x00, 0xC3, 0x60, 0x00, 0x1C, 0x83, 0x01, 0xF0, 0x0F, 0x06, 0xC0, 0x3F, 0x18, 0x00, 0xFE, 0x70, 0x00, 0xF0, 0xC3, 0x01, 0x00, 0x0F, 0x03,  // e
+0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x30, 0x00, 0x00, 0xC0, 0x00, 0x00, 0xE0, 0xFF, 0x7F, 0xE0, 0xFF, 0xFF, 0xC1, 0xFF, 0xFF, 0x07, 0xFF, 0xFF, 0x1F, 0xFC, 0xFF, 0x7F, 0x30, 0x0C, 0x00, 0x40, 0x30, 0x00, 0x00, 0xC1, 0x00, 0x00, 0x04, 0x03, 0x00, 0x10, 0x0C, 0x00, 0xC0, 0x30, 0x00, 0x00,  // f
+0x00, 0x00, 0x00, 0x00, 0xF0, 0x07, 0x00, 0xF0, 0x7F, 0x30, 0xE0, 0xFF, 0xC3, 0x80, 0xFF, 0x1F, 0x03, 0x3F, 0x7E, 0x08, 0x1C, 0xC0, 0x21, 0x30, 0x00, 0x86, 0xC0, 0x00, 0x18, 0x02, 0x07, 0x70, 0x0C, 0x1C, 0xE0, 0x30, 0xE0, 0xFF, 0xFF, 0xC0, 0xFF, 0xFF, 0x03, 0xFF, 0xFF, 0x07, 0xFC, 0xFF, 0x0F, 0xF0, 0xFF, 0x07,  // g
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0xFF, 0xFF, 0xC1, 0xFF, 0xFF, 0x07, 0xFF, 0xFF, 0x1F, 0xFC, 0xFF, 0x7F, 0x00, 0x78, 0x00, 0x00, 0xF0, 0x00, 0x00, 0xC0, 0x01, 0x00, 0x00, 0x03, 0x00, 0x00, 0x0C, 0x00, 0x00, 0xF0, 0xFF, 0x07, 0xC0, 0xFF, 0x1F, 0x00, 0xFF, 0x7F, 0x00, 0xF8, 0xFF, 0x01, 0x80, 0xFF, 0x07,  // h
+0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x30, 0x00, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x0C, 0x00, 0xC0, 0xF0, 0xFF, 0x07, 0xC3, 0xFF, 0x1F, 0x0C, 0xFF, 0x7F, 0x30, 0xFC, 0xFF, 0xC1, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // i
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00, 0x30, 0x30, 0x00, 0xC0, 0xC0, 0x00, 0x00, 0x02, 0x03, 0x00, 0x08, 0x0C, 0x00, 0x20, 0x30, 0x00, 0xC0, 0xC3, 0xFF, 0xFF, 0x0F, 0xFF, 0xFF, 0x3F, 0xFC, 0xFF, 0xFF, 0xF0, 0xFF, 0x7F, 0xC3, 0xFF, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // j
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0xFF, 0xFF, 0xC1, 0xFF, 0xFF, 0x07, 0xFF, 0xFF, 0x1F, 0xFC, 0xFF, 0x7F, 0x00, 0x00, 0x07, 0x00, 0x00, 0x3F, 0x00, 0x00, 0xFE, 0x01, 0x00, 0xFC, 0x0F, 0x00, 0xF8, 0x7C, 0x00, 0xF0, 0xE1, 0x07, 0xC0, 0x03, 0x1F, 0x00, 0x07, 0x78, 0x00, 0x0C, 0xC0, 0x01, 0x10, 0x00, 0x06,  // k
+0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x10, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x04, 0x00, 0x00, 0x10, 0x00, 0x00, 0xC0, 0xFF, 0xFF, 0x07, 0xFF, 0xFF, 0x1F, 0xFC, 0xFF, 0x7F, 0xF0, 0xFF, 0xFF, 0xC1, 0xFF, 0xFF, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // l
+0xC0, 0xFF, 0x1F, 0x00, 0xFF, 0x7F, 0x00, 0xFC, 0xFF, 0x01, 0xF0, 0xFF, 0x07, 0x80, 0x0F, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x7C, 0x00, 0x00, 0xF0, 0xFF, 0x07, 0xC0, 0xFF, 0x1F, 0x00, 0xFE, 0x7F, 0x00, 0xF8, 0x00, 0x00, 0xF0, 0x00, 0x00, 0xC0, 0x03, 0x00, 0x00, 0xFF, 0x7F, 0x00, 0xFC, 0xFF, 0x01, 0xE0, 0xFF, 0x07,  // m
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0xFF, 0x01, 0xF0, 0xFF, 0x07, 0xC0, 0xFF, 0x1F, 0x00, 0xFF, 0x7F, 0x00, 0x78, 0x00, 0x00, 0xF0, 0x00, 0x00, 0xC0, 0x01, 0x00, 0x00, 0x03, 0x00, 0x00, 0x0C, 0x00, 0x00, 0xF0, 0xFF, 0x07, 0xC0, 0xFF, 0x1F, 0x00, 0xFF, 0x7F, 0x00, 0xF8, 0xFF, 0x01, 0x80, 0xFF, 0x07,  // n
+0x00, 0x00, 0x00, 0x00, 0xF0, 0x07, 0x00, 0xF0, 0x7F, 0x00, 0xE0, 0xFF, 0x03, 0x80, 0xFF, 0x0F, 0x00, 0x1F, 0x7C, 0x00, 0x1C, 0xC0, 0x01, 0x30, 0x00, 0x06, 0xC0, 0x00, 0x18, 0x00, 0x03, 0x60, 0x00, 0x1C, 0xC0, 0x01, 0xF0, 0xC1, 0x07, 0x80, 0xFF, 0x0F, 0x00, 0xFE, 0x3F, 0x00, 0xF0, 0x7F, 0x00, 0x80, 0xFF, 0x00,  // o
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0xFF, 0x3F, 0xF0, 0xFF, 0xFF, 0xC0, 0xFF, 0xFF, 0x03, 0xFF, 0xFF, 0x0F, 0x38, 0xE0, 0x01, 0x70, 0x00, 0x07, 0xC0, 0x00, 0x18, 0x00, 0x03, 0x60, 0x00, 0x1C, 0xC0, 0x01, 0xF0, 0xC0, 0x07, 0xC0, 0xFF, 0x1F, 0x00, 0xFE, 0x3F, 0x00, 0xF8, 0x7F, 0x00, 0x80, 0x7F, 0x00,  // p
+0x00, 0x00, 0x00, 0x00, 0xF0, 0x0F, 0x00, 0xF0, 0x7F, 0x00, 0xE0, 0xFF, 0x03, 0x80, 0xFF, 0x1F, 0x00, 0x1F, 0x7C, 0x00, 0x1C, 0xC0, 0x01, 0x30, 0x00, 0x06, 0xC0, 0x00, 0x18, 0x00, 0x07, 0x70, 0x00, 0x1C, 0xE0, 0x00, 0xE0, 0xFF, 0xFF, 0xC0, 0xFF, 0xFF, 0x03, 0xFF, 0xFF, 0x0F, 0xFC, 0xFF, 0x3F, 0x00, 0x00, 0x00,  // q
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0xFF, 0x07, 0xC0, 0xFF, 0x1F, 0x00, 0xFF, 0x7F, 0x00, 0xFC, 0xFF, 0x01, 0xF0, 0xFF, 0x07, 0x80, 0x07, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x30, 0x00, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x7C, 0x00, 0x00, 0xF0, 0x01, 0x00,  // r
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0xC0, 0x00, 0xE0, 0x07, 0x07, 0x80, 0x1F, 0x1C, 0x00, 0xFF, 0x70, 0x00, 0xFC, 0x83, 0x01, 0x30, 0x0E, 0x06, 0xC0, 0x70, 0x18, 0x00, 0xC3, 0x61, 0x00, 0x0C, 0xCF, 0x01, 0x30, 0xF8, 0x07, 0xC0, 0xE1, 0x0F, 0x00, 0x87, 0x3F, 0x00, 0x18, 0x7C, 0x00, 0x00, 0x00, 0x00,  // s
+0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x30, 0x00, 0x00, 0xC0, 0x00, 0x00, 0xE0, 0xFF, 0x1F, 0x80, 0xFF, 0xFF, 0x00, 0xFE, 0xFF, 0x07, 0xF8, 0xFF, 0x1F, 0x00, 0x03, 0x70, 0x00, 0x0C, 0x80, 0x01, 0x30, 0x00, 0x06, 0xC0, 0x00, 0x18, 0x00, 0x03, 0x60, 0x00, 0x0C, 0x80, 0x01, 0x30, 0x00, 0x06,  // t
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0x7F, 0x00, 0xF0, 0xFF, 0x03, 0xC0, 0xFF, 0x1F, 0x00, 0xFF, 0x7F, 0x00, 0x00, 0xC0, 0x01, 0x00, 0x00, 0x06, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x78, 0x00, 0x00, 0xF0, 0x00, 0xF0, 0xFF, 0x07, 0xC0, 0xFF, 0x1F, 0x00, 0xFF, 0x7F, 0x00, 0xFC, 0xFF, 0x01, 0x00, 0x00, 0x00,  // u
+0x40, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0xFC, 0x00, 0x00, 0xF0, 0x0F, 0x00, 0x80, 0xFF, 0x01, 0x00, 0xF8, 0x1F, 0x00, 0x80, 0xFF, 0x01, 0x00, 0xF0, 0x07, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x7F, 0x00, 0x00, 0xFF, 0x01, 0x80, 0xFF, 0x01, 0x80, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFC, 0x00, 0x00, 0x70, 0x00, 0x00,  // v
+0xC0, 0x0F, 0x00, 0x00, 0xFF, 0x07, 0x00, 0xFC, 0xFF, 0x01, 0xF0, 0xFF, 0x07, 0x00, 0xF0, 0x1F, 0x00, 0xC0, 0x7F, 0x00, 0xF0, 0xFF, 0x01, 0xE0, 0x7F, 0x00, 0x80, 0x1F, 0x00, 0x00, 0xFE, 0x07, 0x00, 0xF8, 0xFF, 0x01, 0x00, 0xFF, 0x07, 0x00, 0xC0, 0x1F, 0x00, 0xF8, 0x7F, 0x00, 0xFC, 0xFF, 0x01, 0xF0, 0x7F, 0x00,  // w
+0x00, 0x00, 0x00, 0x00, 0x01, 0x40, 0x00, 0x1C, 0xC0, 0x01, 0xF0, 0x80, 0x07, 0xC0, 0x07, 0x1F, 0x00, 0x7F, 0x3F, 0x00, 0xF8, 0x7F, 0x00, 0x80, 0x7F, 0x00, 0x00, 0xFC, 0x01, 0x00, 0xF0, 0x0F, 0x00, 0xF0, 0x7F, 0x00, 0xE0, 0xF7, 0x07, 0xC0, 0x87, 0x1F, 0x00, 0x0F, 0x78, 0x00, 0x0C, 0xC0, 0x01, 0x10, 0x00, 0x06,  // x
+0x40, 0x00, 0x00, 0x00, 0x07, 0x00, 0x08, 0x7C, 0x00, 0x20, 0xF0, 0x0F, 0x80, 0xC0, 0xFF, 0x00, 0x03, 0xFC, 0x0F, 0x0E, 0x80, 0xFF, 0x3F, 0x00, 0xF8, 0xFF, 0x00, 0x80, 0xFF, 0x01, 0x00, 0xFF, 0x01, 0x80, 0xFF, 0x00, 0x80, 0xFF, 0x00, 0x80, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x7C, 0x00, 0x00, 0x70, 0x00, 0x00,  // y
+0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x00, 0x0C, 0xC0, 0x01, 0x30, 0xC0, 0x07, 0xC0, 0x80, 0x1F, 0x00, 0x03, 0x7F, 0x00, 0x0C, 0xBE, 0x01, 0x30, 0x7C, 0x06, 0xC0, 0xF8, 0x18, 0x00, 0xF3, 0x61, 0x00, 0xEC, 0x83, 0x01, 0xF0, 0x07, 0x06, 0xC0, 0x0F, 0x18, 0x00, 0x1F, 0x60, 0x00, 0x3C, 0x80, 0x01, 0x70, 0x00, 0x06,  // z
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x06, 0x00, 0x00, 0x18, 0x00, 0x00, 0x60, 0x00, 0xE0, 0xC3, 0xC3, 0xC7, 0xFF, 0xFF, 0x3F, 0xFF, 0xFF, 0xFF, 0xFC, 0x9F, 0xFF, 0x37, 0x1C, 0x38, 0x5C, 0x00, 0x00, 0x60, 0x01, 0x00, 0x80, 0x05, 0x00, 0x00, 0x16, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00,  // {
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xFF, 0xFF, 0x7F, 0xFF, 0xFF, 0xFF, 0xFD, 0xFF, 0xFF, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // |
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x58, 0x00, 0x00, 0x60, 0x01, 0x00, 0x80, 0x05, 0x00, 0x00, 0x36, 0x18, 0x18, 0xDC, 0xFF, 0xF9, 0x7F, 0xFF, 0xFF, 0xFF, 0xFC, 0xFF, 0xFF, 0xE3, 0xC3, 0xC3, 0x07, 0x00, 0x06, 0x00, 0x00, 0x18, 0x00, 0x00, 0x60, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00,  // }
+0x00, 0xC0, 0x00, 0x00, 0xC0, 0x03, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x3E, 0x00, 0x00, 0x18, 0x00, 0x00, 0x60, 0x00, 0x00, 0x80, 0x03, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x70, 0x00, 0x00, 0xC0, 0x03, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x30, 0x00, 0x00, 0xC0, 0x00, 0x00, 0xE0, 0x03, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x1E, 0x00,  // ~
 };
 
 
 FontDef_t Font_7x10 = {
 	7,
 	10,
-	Font7x10
+	NULL,
+	Font7x10,
+	Font7x10_Ranges,
+	sizeof(Font7x10_Ranges) / sizeof(Font7x10_Ranges[0]),
+	'?' - 32
 };
 
 FontDef_t Font_11x18 = {
 	11,
 	18,
+	NULL,
 	Font11x18
 };
 
 FontDef_t Font_16x26 = {
 	16,
 	26,
+	NULL,
 	Font16x26
 };
 
+uint16_t FONTS_GetGlyph(const FontDef_t* Font, uint32_t cp) {
+	const FONTS_RANGE_t* r;
+	uint16_t lo = 0, hi = Font->rangeCount, mid;
+
+	if (!Font->ranges) {
+		/* Plain ASCII font */
+		return (cp >= 32 && cp <= 126) ? cp - 32 : '?' - 32;
+	}
+
+	/* Ranges are sorted, most text hits first one */
+	r = Font->ranges;
+	if (cp - r->First < r->Count) {
+		return r->Glyph + (cp - r->First);
+	}
+	while (lo < hi) {
+		mid = (lo + hi) >> 1;
+		r = &Font->ranges[mid];
+		if (cp < r->First) {
+			hi = mid;
+		} else if (cp - r->First >= r->Count) {
+			lo = mid + 1;
+		} else {
+			return r->Glyph + (cp - r->First);
+		}
+	}
+
+	return Font->fallback;
+}
+
 char* FONTS_GetStringSize(char* str, FONTS_SIZE_t* SizeStruct, FontDef_t* Font) {
 	/* Fill settings */
 	SizeStruct->Height = Font->FontHeight;
@@ -51,13 +51,34 @@
  * @{
  */
 
+/**
+ * @brief  Code point range of font, glyphs of range are consecutive in glyph table
+ */
+typedef struct {
+	uint16_t First;          /*!< First code point of range */
+	uint16_t Count;          /*!< Number of code points in range */
+	uint16_t Glyph;          /*!< Glyph index of First */
+} FONTS_RANGE_t;
+
 /**
  * @brief  Font structure used on my LCD libraries
+ * @note   Glyphs are kept in one of two layouts, packed one is used when it is set:
+ *          - data: FontHeight rows of uint16_t per glyph, MSB is the left pixel
+ *          - packed: FontWidth * FontHeight bits per glyph, column after column from the left,
+ *            every column from the top pixel, LSB of byte first. Glyph i starts at byte
+ *            i * ((FontWidth * FontHeight + 7) / 8). Made from data layout by tools/ssd1306_fontpack.c
+ *
+ *         Without ranges glyph table holds ASCII 32 - 126 and other characters are drawn as '?'.
+ *         With ranges only listed code points have glyphs, others are drawn with fallback glyph
  */
 typedef struct {
-	uint8_t FontWidth;    /*!< Font width in pixels */
-	uint8_t FontHeight;   /*!< Font height in pixels */
-	const uint16_t *data; /*!< Pointer to data font data array */
+	uint8_t FontWidth;              /*!< Font width in pixels, up to 16 */
+	uint8_t FontHeight;             /*!< Font height in pixels, up to 32 */
+	const uint16_t *data;           /*!< Pointer to data font data array, NULL for packed font */
+	const uint8_t *packed;          /*!< Pointer to packed font data array, NULL for data font */
+	const FONTS_RANGE_t *ranges;    /*!< Code point ranges sorted by First, NULL for ASCII 32 - 126 */
+	uint8_t rangeCount;             /*!< Number of ranges */
+	uint16_t fallback;              /*!< Glyph index drawn for code points without glyph, used with ranges */
 } FontDef_t;
 
 /**
@@ -79,7 +100,7 @@ typedef struct {
  */
 
 /**
- * @brief  7 x 10 pixels font size structure
+ * @brief  7 x 10 pixels font size structure, has degree, plus-minus, micro and arrow glyphs too
  */
 extern FontDef_t Font_7x10;
 
@@ -100,6 +121,14 @@ extern FontDef_t Font_16x26;
  * @{
  */
 
+/**
+ * @brief  Finds glyph of code point, binary search over ranges of font
+ * @param  *Font: Pointer to @ref FontDef_t font
+ * @param  cp: Unicode code point
+ * @retval Glyph index, fallback glyph when font has no glyph for cp
+ */
+uint16_t FONTS_GetGlyph(const FontDef_t* Font, uint32_t cp);
+
 /**
  * @brief  Calculates string length and height in units of pixels depending on string and font used
  * @param  *str: String to be checked for length and height
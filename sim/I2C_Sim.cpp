@@ -0,0 +1,651 @@
+/*
+ * I2C_Sim.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ */
+#include "I2C_Sim.h"
+
+/* Register indexes, same order as I2C_RegDef_t */
+enum {
+	REG_CR1, REG_CR2, REG_OAR1, REG_OAR2, REG_DR, REG_SR1, REG_SR2, REG_CCR, REG_TRISE
+};
+
+/* Bits used by the model */
+#define CR1_PE				(1UL << 0)
+#define CR1_START			(1UL << 8)
+#define CR1_STOP			(1UL << 9)
+#define CR1_ACK				(1UL << 10)
+#define CR1_POS				(1UL << 11)
+#define CR1_SWRST			(1UL << 15)
+#define CR2_ITERREN			(1UL << 8)
+#define CR2_ITEVTEN			(1UL << 9)
+#define CR2_ITBUFEN			(1UL << 10)
+#define SR1_SB				(1UL << 0)
+#define SR1_ADDR			(1UL << 1)
+#define SR1_BTF				(1UL << 2)
+#define SR1_STOPF			(1UL << 4)
+#define SR1_RXNE			(1UL << 6)
+#define SR1_TXE				(1UL << 7)
+#define SR1_BERR			(1UL << 8)
+#define SR1_AF				(1UL << 10)
+#define SR1_ERRORS			(0xFUL << 8)		//BERR, ARLO, AF, OVR ARE rc_w0
+#define SR1_EVENTS			(SR1_SB | SR1_ADDR | SR1_BTF | SR1_STOPF)
+#define SR1_BUFFER			(SR1_RXNE | SR1_TXE)
+#define SR2_MSL				(1UL << 0)
+#define SR2_BUSY			(1UL << 1)
+#define SR2_TRA				(1UL << 2)
+#define SR2_DUALF			(1UL << 7)
+#define OAR2_ENDUAL			(1UL << 0)
+#define CCR_FS				(1UL << 15)
+#define CCR_DUTY			(1UL << 14)
+
+/* What SCL/SDA are doing now */
+enum Activity {
+	ACT_IDLE, ACT_START, ACT_ADDRESS, ACT_TX, ACT_RX, ACT_STOP
+};
+
+/* Where master is in its transaction */
+enum Phase {
+	PHASE_NONE,			//NO TRANSACTION
+	PHASE_START,		//SB SET, ADDRESS EXPECTED IN DR
+	PHASE_ADDRESSED,	//ADDR SET, WAITING FOR SR1/SR2 READ
+	PHASE_TX,			//MASTER TRANSMITTER
+	PHASE_RX,			//MASTER RECEIVER
+	PHASE_FAILED		//NACK, WAITING FOR STOP OR START
+};
+
+/* Model state of one peripheral and its bus */
+struct I2C_SimState {
+	u32 Cr1, Cr2, Oar1, Oar2, Ccr, Trise, Sr1, Sr2;
+	u8 Dr;
+	u8 DrFull;			//TRANSMIT BYTE WAITING IN DR
+	u8 Shift;
+	u8 ShiftFull;		//RECEIVED BYTE WAITING IN SHIFT REGISTER, BTF
+	u8 Address;			//ADDRESS BYTE OF CURRENT TRANSACTION
+	u8 RxAck;			//ACK BIT WHEN BYTE RECEPTION STARTED, USED WITH POS
+	u8 RxDone;			//NACK WAS SENT, SLAVE STOPPED DRIVING SDA
+	u8 Sr1Read;			//FIRST HALF OF CLEAR SEQUENCES
+	Activity Act;
+	u64 ActEnd;
+	Phase Step;
+	I2C_SimDevice *Devices[I2C_SIM_DEVICES];
+	u8 DeviceCount;
+	I2C_SimDevice *Target;
+	I2C_SimStats Stats;
+};
+
+#define I2C_SIM_BLOCK(bus)	{ {bus, REG_CR1}, {bus, REG_CR2}, {bus, REG_OAR1}, \
+		{bus, REG_OAR2}, {bus, REG_DR}, {bus, REG_SR1}, {bus, REG_SR2}, \
+		{bus, REG_CCR}, {bus, REG_TRISE} }
+
+I2C_RegDef_t I2C_SimRegs[2] = { I2C_SIM_BLOCK(0), I2C_SIM_BLOCK(1) };
+volatile u32 I2C_SimCore[5];
+I2C_SimSetReg I2C_SimIser[2] = { &I2C_SimCore[0], &I2C_SimCore[1] };
+
+static I2C_SimState I2C_SimBus[2];
+static u32 I2C_SimCable[2];	//FASTEST CLOCK IN KHZ WHICH WIRING CARRIES, 0 ANY
+static u64 I2C_SimTime;		//PICOSECONDS
+
+/* Handlers of I2C_Program.c, compiled as C++ as well */
+void I2C1_EV_IRQHandler(void);
+void I2C1_ER_IRQHandler(void);
+void I2C2_EV_IRQHandler(void);
+void I2C2_ER_IRQHandler(void);
+
+/* Event and error handlers of both buses, IRQ numbers 31 to 34 */
+static void (*const I2C_SimHandlers[2][2])(void) = {
+	{ I2C1_EV_IRQHandler, I2C1_ER_IRQHandler },
+	{ I2C2_EV_IRQHandler, I2C2_ER_IRQHandler }
+};
+
+/* Handler calls in a row before the model gives up, a handler which does not
+ * clear its flag would hang the core the same way */
+#define I2C_SIM_IRQ_LIMIT	64
+
+/* Length of one SCL period from FREQ, CCR and duty */
+static u64 I2C_SimBitPs(const I2C_SimState &b) {
+	u64 freq = b.Cr2 & 0x3F;
+	u64 ccr = b.Ccr & 0xFFF;
+	u64 clocks;
+
+	if (freq < 2) {
+		freq = 2;
+	}
+	if (b.Ccr & CCR_FS) {
+		if (ccr < 1) {
+			ccr = 1;
+		}
+		clocks = (b.Ccr & CCR_DUTY) ? 25 * ccr : 3 * ccr;
+	} else {
+		if (ccr < 4) {
+			ccr = 4;
+		}
+		clocks = 2 * ccr;
+	}
+	return clocks * 1000000 / freq;
+}
+
+/* Byte of current activity was clocked faster than cable carries */
+static u8 I2C_SimGlitch(const I2C_SimState &b) {
+	u32 khz = I2C_SimCable[&b - I2C_SimBus];
+
+	return khz && 1000000000ULL / I2C_SimBitPs(b) > khz;
+}
+
+/* Starts bus activity at time t */
+static void I2C_SimBegin(I2C_SimState &b, Activity act, u64 t, u64 bits) {
+	u64 length = bits * I2C_SimBitPs(b);
+
+	b.Act = act;
+	b.ActEnd = t + length;
+	b.Stats.BusPs += length;
+}
+
+/* Picks next bus activity once bus is idle at time t */
+static void I2C_SimNext(I2C_SimState &b, u64 t) {
+	if (b.Act != ACT_IDLE) {
+		return;
+	}
+
+	if (b.Cr1 & CR1_STOP) {
+		if (b.Sr2 & SR2_MSL) {
+			/* After current byte, byte waiting in DR is not sent */
+			I2C_SimBegin(b, ACT_STOP, t, 1);
+		} else {
+			b.Cr1 &= ~CR1_STOP;
+		}
+	} else if (b.Cr1 & CR1_START) {
+		I2C_SimBegin(b, ACT_START, t, 1);
+	} else if (b.Step == PHASE_TX && b.DrFull) {
+		/* DR moves to shift register, DR is empty again */
+		b.Shift = b.Dr;
+		b.DrFull = 0;
+		b.Sr1 |= SR1_TXE;
+		b.Sr1 &= ~SR1_BTF;
+		I2C_SimBegin(b, ACT_TX, t, 9);
+	} else if (b.Step == PHASE_RX && !b.RxDone && !b.ShiftFull) {
+		b.RxAck = (b.Cr1 & CR1_ACK) != 0;
+		I2C_SimBegin(b, ACT_RX, t, 9);
+	}
+}
+
+/* Finishes bus activity which ended at b.ActEnd */
+static void I2C_SimComplete(I2C_SimState &b) {
+	u64 t = b.ActEnd;
+	Activity act = b.Act;
+	u8 data;
+	u8 ack;
+	u8 i;
+
+	b.Act = ACT_IDLE;
+	if ((act == ACT_ADDRESS || act == ACT_TX || act == ACT_RX) && I2C_SimGlitch(b)) {
+		/* Slave saw a misplaced START or STOP, byte is lost and master waits for STOP */
+		b.Sr1 |= SR1_BERR;
+		b.Step = PHASE_FAILED;
+		b.Stats.Bytes++;
+		b.Stats.Berrs++;
+		I2C_SimNext(b, t);
+		return;
+	}
+	switch (act) {
+	case ACT_START:
+		b.Cr1 &= ~CR1_START;
+		b.Sr1 |= SR1_SB;
+		b.Sr1 &= ~(SR1_TXE | SR1_BTF);
+		b.Sr2 |= SR2_MSL | SR2_BUSY;
+		b.DrFull = 0;
+		b.Target = 0;
+		b.Step = PHASE_START;
+		b.Stats.Starts++;
+		break;
+
+	case ACT_ADDRESS:
+		b.Stats.Bytes++;
+		for (i = 0; i < b.DeviceCount; i++) {
+			if ((b.Devices[i]->Address & 0xFE) == (b.Address & 0xFE)) {
+				b.Target = b.Devices[i];
+			}
+		}
+		if (b.Target && b.Target->Start(b.Target->Context, b.Address & 1)) {
+			b.Sr1 |= SR1_ADDR;
+			b.Sr2 = (b.Address & 1) ? (b.Sr2 & ~SR2_TRA) : (b.Sr2 | SR2_TRA);
+			b.Step = PHASE_ADDRESSED;
+		} else {
+			b.Sr1 |= SR1_AF;
+			b.Target = 0;
+			b.Step = PHASE_FAILED;
+			b.Stats.Nacks++;
+		}
+		break;
+
+	case ACT_TX:
+		b.Stats.Bytes++;
+		if (!b.Target->Write(b.Target->Context, b.Shift)) {
+			b.Sr1 |= SR1_AF;
+			b.Step = PHASE_FAILED;
+			b.Stats.Nacks++;
+		} else if (!b.DrFull) {
+			/* Nothing to send, SCL is stretched */
+			b.Sr1 |= SR1_BTF;
+		}
+		break;
+
+	case ACT_RX:
+		b.Stats.Bytes++;
+		data = b.Target->Read(b.Target->Context);
+		/* With POS, ACK bit of the time reception started applies */
+		ack = (b.Cr1 & CR1_POS) ? b.RxAck : ((b.Cr1 & CR1_ACK) != 0);
+		if (!(b.Sr1 & SR1_RXNE)) {
+			b.Dr = data;
+			b.Sr1 |= SR1_RXNE;
+		} else {
+			b.Shift = data;
+			b.ShiftFull = 1;
+			b.Sr1 |= SR1_BTF;
+		}
+		if (!ack) {
+			b.RxDone = 1;
+		}
+		break;
+
+	case ACT_STOP:
+		b.Cr1 &= ~CR1_STOP;
+		b.Sr1 &= ~(SR1_TXE | SR1_BTF);
+		b.Sr2 &= ~(SR2_MSL | SR2_BUSY | SR2_TRA);
+		b.DrFull = 0;
+		if (b.Target && b.Target->Stop) {
+			b.Target->Stop(b.Target->Context);
+		}
+		b.Target = 0;
+		b.Step = PHASE_NONE;
+		b.Stats.Stops++;
+		break;
+
+	default:
+		break;
+	}
+
+	I2C_SimNext(b, t);
+}
+
+/* CPU spends time on register access, buses catch up */
+static void I2C_SimTick(void) {
+	u8 i;
+
+	I2C_SimTime += (u64) I2C_SIM_ACCESS_CYCLES * 1000000000000ULL / I2C_SIM_CPU_HZ;
+	for (i = 0; i < 2; i++) {
+		while (I2C_SimBus[i].Act != ACT_IDLE && I2C_SimBus[i].ActEnd <= I2C_SimTime) {
+			I2C_SimComplete(I2C_SimBus[i]);
+		}
+	}
+}
+
+/* Interrupt request of bus, 0 event, 1 error, -1 none */
+static int I2C_SimRequest(u8 bus) {
+	const I2C_SimState &b = I2C_SimBus[bus];
+	u8 irq = 31 + bus * 2;
+
+	if ((b.Cr2 & CR2_ITERREN) && (b.Sr1 & SR1_ERRORS)
+			&& (I2C_SimCore[(irq + 1) >> 5] & (1UL << ((irq + 1) & 31)))) {
+		return 1;
+	}
+	if ((b.Cr2 & CR2_ITEVTEN)
+			&& ((b.Sr1 & SR1_EVENTS) || ((b.Cr2 & CR2_ITBUFEN) && (b.Sr1 & SR1_BUFFER)))
+			&& (I2C_SimCore[irq >> 5] & (1UL << (irq & 31)))) {
+		return 0;
+	}
+	return -1;
+}
+
+/* Runs handlers while requests are pending, handlers do not nest */
+static void I2C_SimInterrupts(void) {
+	static u8 active;
+	int line;
+	u8 i, n;
+
+	if (active) {
+		return;
+	}
+	active = 1;
+	for (n = 0; n < I2C_SIM_IRQ_LIMIT; n++) {
+		for (i = 0; i < 2; i++) {
+			line = I2C_SimRequest(i);
+			if (line >= 0) {
+				I2C_SimHandlers[i][line]();
+				break;
+			}
+		}
+		if (i == 2) {
+			break;
+		}
+	}
+	active = 0;
+}
+
+/* Clears registers and transaction of one bus */
+static void I2C_SimClear(I2C_SimState &b) {
+	I2C_SimDevice *devices[I2C_SIM_DEVICES];
+	u8 count = b.DeviceCount;
+	u8 i;
+
+	for (i = 0; i < count; i++) {
+		devices[i] = b.Devices[i];
+	}
+	b = I2C_SimState();
+	for (i = 0; i < count; i++) {
+		b.Devices[i] = devices[i];
+	}
+	b.DeviceCount = count;
+}
+
+static u32 I2C_SimRead(u8 bus, u8 reg) {
+	I2C_SimState &b = I2C_SimBus[bus];
+	u32 value;
+
+	I2C_SimTick();
+	switch (reg) {
+	case REG_CR1:
+		return b.Cr1;
+	case REG_CR2:
+		return b.Cr2;
+	case REG_OAR1:
+		return b.Oar1;
+	case REG_OAR2:
+		return b.Oar2;
+	case REG_CCR:
+		return b.Ccr;
+	case REG_TRISE:
+		return b.Trise;
+	case REG_SR1:
+		b.Sr1Read = 1;
+		return b.Sr1;
+	case REG_SR2:
+		value = b.Sr2;
+		if (b.Sr1Read && (b.Sr1 & SR1_ADDR)) {
+			/* SR1 then SR2 read clears ADDR, data phase begins */
+			b.Sr1 &= ~SR1_ADDR;
+			if (!(b.Sr2 & SR2_MSL)) {
+				/* Slave transmitter wants its first byte */
+				if (b.Sr2 & SR2_TRA) {
+					b.Sr1 |= SR1_TXE;
+				}
+			} else if (b.Address & 1) {
+				b.Step = PHASE_RX;
+				b.RxDone = 0;
+				b.ShiftFull = 0;
+			} else {
+				b.Step = PHASE_TX;
+				b.Sr1 |= SR1_TXE;
+			}
+			I2C_SimNext(b, I2C_SimTime);
+		}
+		b.Sr1Read = 0;
+		return value;
+	case REG_DR:
+		value = b.Dr;
+		if (b.Sr1 & SR1_RXNE) {
+			b.Sr1 &= ~SR1_RXNE;
+			if (b.ShiftFull) {
+				b.Dr = b.Shift;
+				b.ShiftFull = 0;
+				b.Sr1 |= SR1_RXNE;
+				b.Sr1 &= ~SR1_BTF;
+			}
+			I2C_SimNext(b, I2C_SimTime);
+		}
+		return value;
+	default:
+		return 0;
+	}
+}
+
+static void I2C_SimWrite(u8 bus, u8 reg, u32 value) {
+	I2C_SimState &b = I2C_SimBus[bus];
+
+	I2C_SimTick();
+	switch (reg) {
+	case REG_CR1:
+		if (value & CR1_SWRST) {
+			I2C_SimClear(b);
+			b.Cr1 = CR1_SWRST;
+			return;
+		}
+		b.Cr1 = value;
+		if (b.Sr1Read && (b.Sr1 & SR1_STOPF)) {
+			/* SR1 read then CR1 write clears STOPF */
+			b.Sr1 &= ~SR1_STOPF;
+		}
+		if (!(value & CR1_PE)) {
+			/* Disabled peripheral releases the bus */
+			b.Cr1 = value & ~(CR1_START | CR1_STOP);
+			b.Sr1 = 0;
+			b.Sr2 = 0;
+			b.Act = ACT_IDLE;
+			b.Step = PHASE_NONE;
+			b.Target = 0;
+			return;
+		}
+		I2C_SimNext(b, I2C_SimTime);
+		break;
+	case REG_CR2:
+		b.Cr2 = value;
+		break;
+	case REG_OAR1:
+		b.Oar1 = value;
+		break;
+	case REG_OAR2:
+		b.Oar2 = value;
+		break;
+	case REG_CCR:
+		b.Ccr = value;
+		break;
+	case REG_TRISE:
+		b.Trise = value;
+		break;
+	case REG_SR1:
+		b.Sr1 &= value | ~SR1_ERRORS;
+		break;
+	case REG_DR:
+		if (b.Step == PHASE_START && (b.Sr1 & SR1_SB)) {
+			/* SR1 read then DR write clears SB, address goes out */
+			b.Sr1 &= ~SR1_SB;
+			b.Address = value;
+			I2C_SimBegin(b, ACT_ADDRESS, I2C_SimTime, 9);
+		} else if (b.Step == PHASE_TX) {
+			b.Dr = value;
+			b.DrFull = 1;
+			b.Sr1 &= ~(SR1_TXE | SR1_BTF);
+			I2C_SimNext(b, I2C_SimTime);
+		} else if ((b.Sr2 & (SR2_MSL | SR2_TRA)) == SR2_TRA) {
+			/* Slave transmitter */
+			b.Dr = value;
+			b.DrFull = 1;
+			b.Sr1 &= ~SR1_TXE;
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+I2C_SimReg::operator u32() const {
+	u32 value = I2C_SimRead(Bus, Reg);
+
+	I2C_SimInterrupts();
+	return value;
+}
+
+I2C_SimReg &I2C_SimReg::operator=(u64 value) {
+	I2C_SimWrite(Bus, Reg, (u32) value);
+	I2C_SimInterrupts();
+	return *this;
+}
+
+void I2C_SimAttach(u8 I2Cx, I2C_SimDevice *device) {
+	I2C_SimState &b = I2C_SimBus[I2Cx];
+
+	if (b.DeviceCount < I2C_SIM_DEVICES) {
+		b.Devices[b.DeviceCount++] = device;
+	}
+}
+
+/* START or repeated START and address of external master, 1 when peripheral took ADDR */
+static u8 I2C_SimExternalAddress(I2C_SimState &b, u8 address) {
+	u32 dual;
+
+	if ((address & 0xFE) == (b.Oar1 & 0xFE)) {
+		dual = 0;
+	} else if ((b.Oar2 & OAR2_ENDUAL) && (address & 0xFE) == (b.Oar2 & 0xFE)) {
+		dual = SR2_DUALF;
+	} else {
+		return 0;
+	}
+	if (!(b.Cr1 & CR1_PE) || !(b.Cr1 & CR1_ACK) || (b.Sr2 & SR2_MSL)) {
+		return 0;
+	}
+
+	b.Stats.Starts++;
+	b.Stats.Bytes++;
+	b.DrFull = 0;
+	b.Sr1 &= ~(SR1_TXE | SR1_RXNE);
+	b.Sr1 |= SR1_ADDR;
+	b.Sr2 = SR2_BUSY | dual | ((address & 1) ? SR2_TRA : 0);
+	I2C_SimInterrupts();
+	return !(b.Sr1 & SR1_ADDR);
+}
+
+/* STOP of external master */
+static void I2C_SimExternalStop(I2C_SimState &b) {
+	b.Stats.Stops++;
+	b.Sr1 |= SR1_STOPF;
+	b.Sr2 = 0;
+	I2C_SimInterrupts();
+}
+
+u8 I2C_SimExternalWrite(u8 I2Cx, u8 address, const u8 *data, u8 length, u8 stop) {
+	I2C_SimState &b = I2C_SimBus[I2Cx];
+	u8 i;
+
+	if (!I2C_SimExternalAddress(b, address & 0xFE)) {
+		return 0;
+	}
+	for (i = 0; i < length; i++) {
+		b.Stats.Bytes++;
+		b.Dr = data[i];
+		b.Sr1 |= SR1_RXNE;
+		I2C_SimInterrupts();
+		if (b.Sr1 & SR1_RXNE) {
+			/* Nobody took the byte, SCL would stay stretched */
+			break;
+		}
+	}
+	if (stop) {
+		I2C_SimExternalStop(b);
+	}
+	return i;
+}
+
+u8 I2C_SimExternalRead(u8 I2Cx, u8 address, u8 *data, u8 length, u8 stop) {
+	I2C_SimState &b = I2C_SimBus[I2Cx];
+	u8 i;
+
+	if (!I2C_SimExternalAddress(b, address | 1)) {
+		return 0;
+	}
+	for (i = 0; i < length; i++) {
+		if (!b.DrFull) {
+			/* Nothing loaded, SCL would stay stretched */
+			break;
+		}
+		/* DR moves to shift register, slave loads next byte while this one goes out */
+		b.Stats.Bytes++;
+		data[i] = b.Dr;
+		b.DrFull = 0;
+		b.Sr1 |= SR1_TXE;
+		I2C_SimInterrupts();
+	}
+	/* Master NACKs last byte */
+	b.Sr1 |= SR1_AF;
+	b.Sr1 &= ~SR1_TXE;
+	I2C_SimInterrupts();
+	if (stop) {
+		I2C_SimExternalStop(b);
+	}
+	return i;
+}
+
+void I2C_SimSetCable(u8 I2Cx, u32 khz) {
+	I2C_SimCable[I2Cx] = khz;
+}
+
+void I2C_SimReset(void) {
+	I2C_SimClear(I2C_SimBus[0]);
+	I2C_SimClear(I2C_SimBus[1]);
+	I2C_SimTime = 0;
+}
+
+void I2C_SimDrain(void) {
+	u8 i;
+
+	for (i = 0; i < 2; i++) {
+		while (I2C_SimBus[i].Act != ACT_IDLE) {
+			if (I2C_SimBus[i].ActEnd > I2C_SimTime) {
+				I2C_SimTime = I2C_SimBus[i].ActEnd;
+			}
+			I2C_SimComplete(I2C_SimBus[i]);
+		}
+	}
+}
+
+void I2C_SimStep(void) {
+	u64 access = (u64) I2C_SIM_ACCESS_CYCLES * 1000000000000ULL / I2C_SIM_CPU_HZ;
+	u64 next = 0;
+	u8 i;
+
+	/* Core sleeps until next bus activity ends */
+	for (i = 0; i < 2; i++) {
+		if (I2C_SimBus[i].Act != ACT_IDLE && (!next || I2C_SimBus[i].ActEnd < next)) {
+			next = I2C_SimBus[i].ActEnd;
+		}
+	}
+	if (next > I2C_SimTime + access) {
+		I2C_SimTime = next - access;
+	}
+	I2C_SimTick();
+	I2C_SimInterrupts();
+}
+
+void I2C_SimIdle(u64 ps) {
+	u64 end = I2C_SimTime + ps;
+	u8 i;
+
+	for (i = 0; i < 2; i++) {
+		while (I2C_SimBus[i].Act != ACT_IDLE && I2C_SimBus[i].ActEnd <= end) {
+			if (I2C_SimBus[i].ActEnd > I2C_SimTime) {
+				I2C_SimTime = I2C_SimBus[i].ActEnd;
+			}
+			I2C_SimComplete(I2C_SimBus[i]);
+		}
+	}
+	if (end > I2C_SimTime) {
+		I2C_SimTime = end;
+	}
+	I2C_SimInterrupts();
+}
+
+u64 I2C_SimNowPs(void) {
+	return I2C_SimTime;
+}
+
+u32 I2C_SimCycles(void) {
+	return (u32) (I2C_SimTime / 1000 * (I2C_SIM_CPU_HZ / 1000) / 1000000);
+}
+
+void I2C_SimGetStats(u8 I2Cx, I2C_SimStats *stats) {
+	*stats = I2C_SimBus[I2Cx].Stats;
+}
+
+void I2C_SimResetStats(u8 I2Cx) {
+	I2C_SimBus[I2Cx].Stats = I2C_SimStats();
+}
@@ -0,0 +1,170 @@
+/*
+ * I2C_Sim.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ */
+
+#ifndef I2C_SIM_H_
+#define I2C_SIM_H_
+
+/*
+ * Host model of I2C1/I2C2 for Linux builds of the driver.
+ *
+ * I2C_Private.h includes this header instead of its fixed addresses when I2C_SIM is defined.
+ * I2C_Program.c is then compiled as C++, so every register of I2C_RegDef_t is a proxy whose reads
+ * and writes drive a model of CR1/SR1/SR2/DR state transitions (RM0008 master sequences).
+ *
+ * Time is virtual. Every register access costs I2C_SIM_ACCESS_CYCLES CPU cycles, bus activity
+ * (START, address, data bytes, STOP) takes the time given by FREQ in CR2 and CCR/duty in CCR.
+ * Devices on the bus are attached with I2C_SimAttach. In slave mode the peripheral is addressed by
+ * an external master through I2C_SimExternalWrite and I2C_SimExternalRead, which take no bus time.
+ * Cable limit of I2C_SimSetCable turns bytes clocked too fast into bus errors.
+ *
+ * Event and error interrupts are requested like RM0008 describes them (ITEVTEN, ITBUFEN, ITERREN
+ * and NVIC enable bits). Their handlers run after the register access which raised them, or from
+ * I2C_SimStep, which stands for the core waiting in WFI.
+ */
+
+#include "stdtypes.h"
+
+/* CPU clock used to convert virtual time to cycles */
+#ifndef I2C_SIM_CPU_HZ
+#define I2C_SIM_CPU_HZ				72000000UL
+#endif
+/* CPU cycles consumed by one register access, including loop overhead */
+#ifndef I2C_SIM_ACCESS_CYCLES
+#define I2C_SIM_ACCESS_CYCLES		8
+#endif
+/* Devices per bus */
+#define I2C_SIM_DEVICES				4
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Device on simulated bus, every callback gets Context */
+typedef struct {
+	u8 Address;							//LEFT ALIGNED 7 BIT ADDRESS
+	void *Context;
+	u8 (*Start)(void *context, u8 read);	//ADDRESSED, RETURNS 1 TO ACK
+	u8 (*Write)(void *context, u8 data);	//BYTE FROM MASTER, RETURNS 1 TO ACK
+	u8 (*Read)(void *context);			//BYTE TO MASTER
+	void (*Stop)(void *context);		//STOP, MAY BE NULL
+} I2C_SimDevice;
+
+/* Bus counters since last I2C_SimReset */
+typedef struct {
+	u64 BusPs;							//TIME SCL WAS DRIVEN, PICOSECONDS
+	u32 Starts;
+	u32 Stops;
+	u32 Bytes;							//ADDRESS AND DATA BYTES
+	u32 Nacks;
+	u32 Berrs;							//BYTES LOST TO BUS ERRORS
+} I2C_SimStats;
+
+/* Attaches device to bus I2Cx, 0 for I2C1 and 1 for I2C2 */
+void I2C_SimAttach(u8 I2Cx, I2C_SimDevice *device);
+
+/* Bytes clocked faster than khz on bus I2Cx end with a bus error, like a long cable
+ * whose edges rise too slowly. 0 removes the limit, it survives I2C_SimReset */
+void I2C_SimSetCable(u8 I2Cx, u32 khz);
+
+/* External master writes length bytes to the peripheral in slave mode, address is left aligned.
+ * STOP follows when stop is 1, otherwise next call begins with a repeated START.
+ * Returns bytes the peripheral took, 0 when it did not answer its address */
+u8 I2C_SimExternalWrite(u8 I2Cx, u8 address, const u8 *data, u8 length, u8 stop);
+
+/* External master reads length bytes from the peripheral in slave mode and NACKs the last one.
+ * Returns bytes read, fewer when the peripheral did not load DR */
+u8 I2C_SimExternalRead(u8 I2Cx, u8 address, u8 *data, u8 length, u8 stop);
+
+/* Resets registers, bus state and counters of both buses, devices stay attached */
+void I2C_SimReset(void);
+
+/* Lets time pass until both buses are idle, I2C_Stop returns before STOP went out */
+void I2C_SimDrain(void);
+
+/* Lets time pass until next bus activity ends, then runs pending interrupts */
+void I2C_SimStep(void);
+
+/* Core idles for ps picoseconds, bus activities ending meanwhile are completed */
+void I2C_SimIdle(u64 ps);
+
+/* Virtual time */
+u64 I2C_SimNowPs(void);
+u32 I2C_SimCycles(void);
+
+/* Counters of bus I2Cx */
+void I2C_SimGetStats(u8 I2Cx, I2C_SimStats *stats);
+void I2C_SimResetStats(u8 I2Cx);
+
+#ifdef __cplusplus
+}
+
+/* One register, reads and writes go to the model */
+class I2C_SimReg {
+public:
+	I2C_SimReg(u8 bus, u8 reg) : Bus(bus), Reg(reg) {
+	}
+	/* Operands are 64 bit wide, driver masks like ~(1UL << n) are long on host */
+	operator u32() const;
+	I2C_SimReg &operator=(u64 value);
+	I2C_SimReg &operator=(const I2C_SimReg &other) {
+		return *this = (u64) (u32) other;
+	}
+	I2C_SimReg &operator|=(u64 value) {
+		return *this = (u32) *this | value;
+	}
+	I2C_SimReg &operator&=(u64 value) {
+		return *this = (u32) *this & value;
+	}
+private:
+	u8 Bus;
+	u8 Reg;
+};
+
+/* Write 1 to set register like NVIC ISER, zero bits leave their bit alone */
+class I2C_SimSetReg {
+public:
+	I2C_SimSetReg(volatile u32 *word) : Word(word) {
+	}
+	operator u32() const {
+		return *Word;
+	}
+	I2C_SimSetReg &operator=(u64 value) {
+		*Word |= (u32) value;
+		return *this;
+	}
+private:
+	volatile u32 *Word;
+};
+
+/* Same layout and names as real register block */
+typedef struct I2C_RegDef_t {
+	I2C_SimReg CR1;
+	I2C_SimReg CR2;
+	I2C_SimReg OAR1;
+	I2C_SimReg OAR2;
+	I2C_SimReg DR;
+	I2C_SimReg SR1;
+	I2C_SimReg SR2;
+	I2C_SimReg CCR;
+	I2C_SimReg TRISE;
+} I2C_RegDef_t;
+
+extern I2C_RegDef_t I2C_SimRegs[2];
+extern volatile u32 I2C_SimCore[5];
+extern I2C_SimSetReg I2C_SimIser[2];
+
+#define I2C_REGS(I2Cx)			(&I2C_SimRegs[I2Cx])
+
+/* Core registers are plain memory on host, ISER words are set only */
+#define I2C_NVIC_ISER			(I2C_SimIser)		//TWO WORDS
+#define I2C_DEMCR				(&I2C_SimCore[2])
+#define I2C_DWT_CTRL			(&I2C_SimCore[3])
+#define I2C_DWT_CYCCNT			(&I2C_SimCore[4])
+
+#endif /* __cplusplus */
+
+#endif /* I2C_SIM_H_ */
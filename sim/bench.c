@@ -0,0 +1,448 @@
+/*
+ * bench.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ *
+ *  Rendering benchmarks of drawing primitives, text and whole screens.
+ *
+ *  Every workload renders one frame into the framebuffer. It is repeated for
+ *  at least BENCH_RUN_NS, best of BENCH_RUNS runs is kept. Report gives calls
+ *  per frame, microseconds per frame and pixels per microsecond.
+ *
+ *  Host speed differs between machines, so the baseline stores cost relative
+ *  to a fixed reference loop measured in the same process. A workload fails
+ *  when its relative cost grows by more than the tolerance, also after it was
+ *  measured again BENCH_RETRIES times.
+ *
+ *  Usage: ssd1306_bench [-u] [-t tolerance] [baseline]
+ *    -u  write baseline instead of comparing
+ *    -t  allowed slowdown, 0.25 is 25 % (default)
+ */
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306.h"
+#include "ssd1306_chart.h"
+#include "ssd1306_text.h"
+
+/* Core registers of stm32f1xx.h stand-in */
+DWT_TypeDef SimDWT;
+CoreDebug_TypeDef SimCoreDebug;
+
+#define BENCH_RUNS       15
+#define BENCH_RUN_NS     5000000LL
+#define BENCH_RETRIES    2
+#define BENCH_MAX        32
+
+/* One workload, renders a frame and returns number of drawing calls */
+typedef struct {
+	const char* Name;
+	uint32_t (*Frame)(void);
+	uint8_t Lit;     /* Pixels are counted as lit pixels of the frame, otherwise whole screen */
+} BENCH_t;
+
+/* Result of one workload */
+typedef struct {
+	const char* Name;
+	uint32_t Calls;
+	uint32_t Pixels;
+	double Ns;
+	double Cost;     /* Ns relative to reference loop */
+} BENCH_RESULT_t;
+
+static uint32_t bench_seed;
+static volatile uint32_t bench_sink;
+
+/* Same pseudo random sequence in every frame */
+static uint16_t bench_rand(uint16_t n) {
+	bench_seed = bench_seed * 1103515245u + 12345u;
+	return (bench_seed >> 16) % n;
+}
+
+static long long bench_now(void) {
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+
+/* Reference loop, independent of the driver: plots pixels of pseudo random
+ * steps into a local page buffer, mixes branches, bit and memory operations
+ * like the drawing code does. Aligned so that code placement of other
+ * functions does not change its speed */
+__attribute__((noinline, aligned(64)))
+static uint32_t bench_reference(void) {
+	static uint8_t buf[1024];
+	uint32_t h = 1;
+	uint16_t i, x = 0, y = 0;
+
+	for (i = 0; i < 4096; i++) {
+		h = h * 1103515245u + 12345u;
+		x = (h & 0x10000) ? (x + 1) & 127 : (x - 1) & 127;
+		y = (h & 0x20000) ? (y + 1) & 63 : (y - 1) & 63;
+		if (h & 0x40000) {
+			buf[x + (y / 8) * 128] |= 1 << (y % 8);
+		} else {
+			buf[x + (y / 8) * 128] &= ~(1 << (y % 8));
+		}
+	}
+	bench_sink = buf[h & 1023];
+	return 1;
+}
+
+static uint32_t bench_pixel(void) {
+	uint16_t x, y;
+
+	for (y = 0; y < 64; y++) {
+		for (x = 0; x < 128; x++) {
+			SSD1306_DrawPixel(x, y, (SSD1306_COLOR_t)((x ^ y) & 1));
+		}
+	}
+	return 128 * 64;
+}
+
+static uint32_t bench_line(void) {
+	uint16_t i;
+
+	bench_seed = 1;
+	for (i = 0; i < 64; i++) {
+		SSD1306_DrawLine(bench_rand(128), bench_rand(64), bench_rand(128), bench_rand(64), SSD1306_COLOR_WHITE);
+	}
+	return 64;
+}
+
+static uint32_t bench_line_hv(void) {
+	uint16_t i;
+
+	for (i = 0; i < 64; i++) {
+		SSD1306_DrawLine(0, i, 127, i, (SSD1306_COLOR_t)(i & 1));
+		SSD1306_DrawLine(i * 2, 0, i * 2, 63, (SSD1306_COLOR_t)(i & 1));
+	}
+	return 128;
+}
+
+static uint32_t bench_filled_rectangle(void) {
+	uint16_t i;
+
+	bench_seed = 2;
+	for (i = 0; i < 32; i++) {
+		SSD1306_DrawFilledRectangle(bench_rand(96), bench_rand(48), 4 + bench_rand(28), 4 + bench_rand(14), (SSD1306_COLOR_t)(i & 1));
+	}
+	return 32;
+}
+
+static uint32_t bench_filled_circle(void) {
+	uint16_t i;
+
+	bench_seed = 3;
+	for (i = 0; i < 16; i++) {
+		SSD1306_DrawFilledCircle(bench_rand(128), bench_rand(64), 3 + bench_rand(20), (SSD1306_COLOR_t)(i & 1));
+	}
+	return 16;
+}
+
+static uint32_t bench_filled_triangle(void) {
+	uint16_t i;
+
+	bench_seed = 4;
+	for (i = 0; i < 16; i++) {
+		SSD1306_DrawFilledTriangle(bench_rand(128), bench_rand(64), bench_rand(128), bench_rand(64),
+			bench_rand(128), bench_rand(64), (SSD1306_COLOR_t)(i & 1));
+	}
+	return 16;
+}
+
+static uint32_t bench_putc(void) {
+	uint16_t i;
+
+	SSD1306_GotoXY(0, 0);
+	for (i = 0; i < 18 * 6; i++) {
+		if (i % 18 == 0) {
+			SSD1306_GotoXY(0, (i / 18) * 10);
+		}
+		SSD1306_Putc(' ' + 1 + i % 94, &Font_7x10, SSD1306_COLOR_WHITE);
+	}
+	return 18 * 6;
+}
+
+static uint32_t bench_puts_page(void) {
+	static char* lines[6] = {
+		"Temperature 23.5C",
+		"Humidity    41 %",
+		"Pressure 1013 hPa",
+		"Wind    12 km/h N",
+		"Battery    87 %",
+		"Uptime 12:04:33"
+	};
+	uint8_t i;
+
+	SSD1306_Fill(SSD1306_COLOR_BLACK);
+	for (i = 0; i < 6; i++) {
+		SSD1306_GotoXY(0, i * 10);
+		SSD1306_Puts(lines[i], &Font_7x10, SSD1306_COLOR_WHITE);
+	}
+	return 7;
+}
+
+static uint32_t bench_puts_large(void) {
+	SSD1306_Fill(SSD1306_COLOR_BLACK);
+	SSD1306_GotoXY(0, 4);
+	SSD1306_Puts("12:34", &Font_16x26, SSD1306_COLOR_WHITE);
+	SSD1306_GotoXY(0, 38);
+	SSD1306_Puts("READY", &Font_11x18, SSD1306_COLOR_WHITE);
+	return 3;
+}
+
+static uint32_t bench_fill(void) {
+	SSD1306_Fill(SSD1306_COLOR_WHITE);
+	SSD1306_Fill(SSD1306_COLOR_BLACK);
+	return 2;
+}
+
+static uint32_t bench_invert(void) {
+	SSD1306_ToggleInvert();
+	SSD1306_ToggleInvert();
+	return 2;
+}
+
+/* Gauges, bars and values of an instrument panel */
+static uint32_t bench_dashboard(void) {
+	uint8_t i;
+
+	SSD1306_Fill(SSD1306_COLOR_BLACK);
+	SSD1306_DrawRectangle(0, 0, 127, 63, SSD1306_COLOR_WHITE);
+	SSD1306_DrawCircle(32, 34, 24, SSD1306_COLOR_WHITE);
+	SSD1306_DrawFilledCircle(32, 34, 3, SSD1306_COLOR_WHITE);
+	SSD1306_DrawLine(32, 34, 48, 18, SSD1306_COLOR_WHITE);
+	for (i = 0; i < 4; i++) {
+		SSD1306_DrawRectangle(64 + i * 15, 8, 11, 40, SSD1306_COLOR_WHITE);
+		SSD1306_DrawFilledRectangle(66 + i * 15, 46 - i * 9, 7, i * 9, SSD1306_COLOR_WHITE);
+	}
+	SSD1306_DrawFilledTriangle(100, 50, 110, 50, 105, 58, SSD1306_COLOR_WHITE);
+	SSD1306_GotoXY(64, 52);
+	SSD1306_Puts("87%", &Font_7x10, SSD1306_COLOR_WHITE);
+	return 16;
+}
+
+/* Six changing readouts drawn in place */
+static uint32_t bench_numbers(void) {
+	static const SSD1306_NUMFMT_t integer = {6, SSD1306_ALIGN_RIGHT, 0, 0, 0};
+	static const SSD1306_NUMFMT_t fixed = {7, SSD1306_ALIGN_RIGHT, SSD1306_NUM_PLUS, 0, 2};
+	static const SSD1306_NUMFMT_t hex = {8, SSD1306_ALIGN_RIGHT, 0, 8, 0};
+	static uint32_t k;
+	uint8_t i;
+
+	k += 7919;
+	for (i = 0; i < 2; i++) {
+		SSD1306_DrawInt(0, i * 30, (int32_t)(k >> i) - 50000, &integer, &Font_7x10, SSD1306_COLOR_WHITE);
+		SSD1306_DrawFixed(0, i * 30 + 10, (int32_t)(k % 20000) - 10000, &fixed, &Font_7x10, SSD1306_COLOR_WHITE);
+		SSD1306_DrawHex(0, i * 30 + 20, k * 2654435761u, &hex, &Font_7x10, SSD1306_COLOR_WHITE);
+	}
+	return 6;
+}
+
+/* Same readouts formatted with snprintf, for comparison */
+static uint32_t bench_numbers_printf(void) {
+	static uint32_t k;
+	char str[16];
+	int32_t v;
+	uint8_t i;
+
+	k += 7919;
+	for (i = 0; i < 2; i++) {
+		snprintf(str, sizeof(str), "%6ld", (long)((int32_t)(k >> i) - 50000));
+		SSD1306_GotoXY(0, i * 30);
+		SSD1306_Puts(str, &Font_7x10, SSD1306_COLOR_WHITE);
+		v = (int32_t)(k % 20000) - 10000;
+		snprintf(str, sizeof(str), "%s%ld.%02ld", v < 0 ? "-" : "+", labs(v) / 100, labs(v) % 100);
+		SSD1306_GotoXY(0, i * 30 + 10);
+		SSD1306_Puts(str, &Font_7x10, SSD1306_COLOR_WHITE);
+		snprintf(str, sizeof(str), "%08lX", (unsigned long)(k * 2654435761u));
+		SSD1306_GotoXY(0, i * 30 + 20);
+		SSD1306_Puts(str, &Font_7x10, SSD1306_COLOR_WHITE);
+	}
+	return 6;
+}
+
+/* Sweep chart with one new sample per frame */
+static uint32_t bench_chart(void) {
+	static int16_t samples[96];
+	static SSD1306_CHART_t chart;
+	static uint8_t ready;
+	static uint16_t k;
+
+	if (!ready) {
+		SSD1306_Fill(SSD1306_COLOR_BLACK);
+		SSD1306_Chart_Init(&chart, 30, 0, 96, 64, samples, &Font_7x10, SSD1306_CHART_SWEEP);
+		SSD1306_Chart_SetRange(&chart, -100, 100);
+		ready = 1;
+	}
+	SSD1306_Chart_Push(&chart, (int16_t)((k++ * 37) % 200) - 100, 0);
+	return 1;
+}
+
+static const BENCH_t bench_list[] = {
+	{"pixel",            bench_pixel,            0},
+	{"line",             bench_line,             1},
+	{"line-hv",          bench_line_hv,          0},
+	{"filled-rectangle", bench_filled_rectangle, 1},
+	{"filled-circle",    bench_filled_circle,    1},
+	{"filled-triangle",  bench_filled_triangle,  1},
+	{"putc",             bench_putc,             1},
+	{"puts-page",        bench_puts_page,        1},
+	{"puts-large",       bench_puts_large,       1},
+	{"fill",             bench_fill,             0},
+	{"invert",           bench_invert,           0},
+	{"dashboard",        bench_dashboard,        1},
+	{"numbers",          bench_numbers,          1},
+	{"numbers-printf",   bench_numbers_printf,   1},
+	{"chart",            bench_chart,            1},
+};
+
+/* Lit pixels of framebuffer */
+static uint32_t bench_lit(void) {
+	static uint8_t buf[128 * 64 / 8];
+	uint32_t n = 0;
+	uint16_t i;
+	uint8_t b;
+
+	SSD1306_ReadBitmap(0, 0, 128, 64, buf);
+	for (i = 0; i < sizeof(buf); i++) {
+		for (b = buf[i]; b; b &= b - 1) {
+			n++;
+		}
+	}
+	return n;
+}
+
+/* Time of one frame of a run in nanoseconds */
+static double bench_run(uint32_t (*frame)(void)) {
+	long long start, t;
+	uint32_t frames = 0;
+
+	start = bench_now();
+	do {
+		frame();
+		frames++;
+		t = bench_now() - start;
+	} while (t < BENCH_RUN_NS);
+	return (double)t / frames;
+}
+
+/* Best frame time of workload and of reference loop, runs of both alternate
+ * so that both see the same load of the host */
+static double bench_measure(uint32_t (*frame)(void), double* reference) {
+	double best = 0, ref = 0, ns;
+	uint8_t run;
+
+	for (run = 0; run < BENCH_RUNS; run++) {
+		ns = bench_run(bench_reference);
+		if (!run || ns < ref) {
+			ref = ns;
+		}
+		ns = bench_run(frame);
+		if (!run || ns < best) {
+			best = ns;
+		}
+	}
+	*reference = ref;
+	return best;
+}
+
+/* Reads baseline cost of workload, 0 when it is not there */
+static double bench_baseline(const char* path, const char* name) {
+	char line[128], key[64];
+	double cost = 0, value;
+	FILE* f = fopen(path, "r");
+
+	if (!f) {
+		return 0;
+	}
+	while (fgets(line, sizeof(line), f)) {
+		if (line[0] != '#' && sscanf(line, "%63s %lf", key, &value) == 2 && !strcmp(key, name)) {
+			cost = value;
+		}
+	}
+	fclose(f);
+	return cost;
+}
+
+int main(int argc, char** argv) {
+	BENCH_RESULT_t results[BENCH_MAX];
+	const char* path = "bench_baseline.txt";
+	double tolerance = 0.25, reference, base, ns;
+	uint8_t update = 0, retry, count = sizeof(bench_list) / sizeof(bench_list[0]);
+	int i, failures = 0;
+	FILE* f;
+
+	for (i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-u")) {
+			update = 1;
+		} else if (!strcmp(argv[i], "-t") && i + 1 < argc) {
+			tolerance = atof(argv[++i]);
+		} else {
+			path = argv[i];
+		}
+	}
+
+	printf("%-18s %8s %10s %10s %8s %9s\n", "workload", "calls", "us/frame", "pixels/us", "cost", "baseline");
+
+	for (i = 0; i < count; i++) {
+		const BENCH_t* b = &bench_list[i];
+		BENCH_RESULT_t* r = &results[i];
+
+		/* Pixels of one frame rendered on black screen */
+		SSD1306_Fill(SSD1306_COLOR_BLACK);
+		r->Calls = b->Frame();
+		r->Pixels = b->Lit ? bench_lit() : 128 * 64;
+
+		r->Name = b->Name;
+		base = bench_baseline(path, b->Name);
+		for (retry = 0; retry <= BENCH_RETRIES; retry++) {
+			ns = bench_measure(b->Frame, &reference);
+			if (!retry || ns / reference < r->Cost) {
+				r->Ns = ns;
+				r->Cost = ns / reference;
+			}
+			/* Measure again only what looks slower, host load comes in bursts */
+			if (update || base <= 0 || r->Cost <= base * (1 + tolerance)) {
+				break;
+			}
+		}
+
+		printf("%-18s %8lu %10.2f %10.1f %8.3f", r->Name, (unsigned long)r->Calls, r->Ns / 1000,
+			r->Pixels / (r->Ns / 1000), r->Cost);
+		if (!update && base > 0) {
+			printf(" %+8.0f%%", (r->Cost / base - 1) * 100);
+			if (r->Cost > base * (1 + tolerance)) {
+				printf("  REGRESSION");
+				failures++;
+			}
+		}
+		printf("\n");
+	}
+
+	if (update) {
+		f = fopen(path, "w");
+		if (!f) {
+			printf("cannot write %s\n", path);
+			return 1;
+		}
+		fprintf(f, "# workload cost, frame time relative to reference loop\n");
+		for (i = 0; i < count; i++) {
+			fprintf(f, "%s %.6g\n", results[i].Name, results[i].Cost);
+		}
+		fclose(f);
+		printf("baseline written to %s\n", path);
+		return 0;
+	}
+
+	if (failures) {
+		printf("%d workloads slower than baseline by more than %.0f %%\n", failures, tolerance * 100);
+		return 1;
+	}
+	return 0;
+}
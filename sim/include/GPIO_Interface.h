@@ -0,0 +1,25 @@
+/*
+ * GPIO_Interface.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ *
+ *  Host stand-in of GPIO driver for the simulator build, pins are not modelled.
+ */
+
+#ifndef GPIO_INTERFACE_H_
+#define GPIO_INTERFACE_H_
+
+#define GPIO_U8_PORTA				0
+#define GPIO_U8_PORTB				1
+
+#define GPIO_U8_P6					6
+#define GPIO_U8_P7					7
+#define GPIO_U8_P10					10
+#define GPIO_U8_P11					11
+
+#define GPIO_U8_OUT_10MHZ_AF_OD		0xD
+
+#define GPIO_u8SetPinMode(port, pin, mode)	((void) (port), (void) (pin), (void) (mode))
+
+#endif /* GPIO_INTERFACE_H_ */
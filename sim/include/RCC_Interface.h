@@ -0,0 +1,25 @@
+/*
+ * RCC_Interface.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ *
+ *  Host stand-in of RCC driver for the simulator build, clocks are always on.
+ */
+
+#ifndef RCC_INTERFACE_H_
+#define RCC_INTERFACE_H_
+
+/* APB2 enable bits */
+#define AFIOEN		0
+#define PORTA_EN	2
+#define PORTB_EN	3
+
+/* APB1 enable bits */
+#define I2C1_EN		21
+#define I2C2_EN		22
+
+#define RCC_APB1_EnableCLK(bit)		((void) (bit))
+#define RCC_APB2_EnableCLK(bit)		((void) (bit))
+
+#endif /* RCC_INTERFACE_H_ */
@@ -0,0 +1,18 @@
+/*
+ * bitmath.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ *
+ *  Host stand-in of LIB layer bit macros for the simulator build.
+ */
+
+#ifndef BITMATH_H_
+#define BITMATH_H_
+
+#define SET(REG, BIT)		((REG) |= (1UL << (BIT)))
+#define RESET(REG, BIT)		((REG) &= ~(1UL << (BIT)))
+#define TOGGLE(REG, BIT)	((REG) ^= (1UL << (BIT)))
+#define GET(REG, BIT)		(((REG) >> (BIT)) & 1UL)
+
+#endif /* BITMATH_H_ */
@@ -0,0 +1,23 @@
+/*
+ * stdtypes.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ *
+ *  Host stand-in of LIB layer types for the simulator build.
+ */
+
+#ifndef STDTYPES_H_
+#define STDTYPES_H_
+
+#include <stdint.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int8_t s8;
+typedef int16_t s16;
+typedef int32_t s32;
+
+#endif /* STDTYPES_H_ */
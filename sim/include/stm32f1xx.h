@@ -0,0 +1,37 @@
+/*
+ * stm32f1xx.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ *
+ *  Host stand-in of CMSIS device header for the simulator build. Only the
+ *  core registers and intrinsics used by the display driver exist, registers
+ *  as plain memory.
+ */
+
+#ifndef STM32F1XX_H_
+#define STM32F1XX_H_
+
+#include <stdint.h>
+
+typedef struct {
+	volatile uint32_t CTRL;
+	volatile uint32_t CYCCNT;
+} DWT_TypeDef;
+
+typedef struct {
+	volatile uint32_t DEMCR;
+} CoreDebug_TypeDef;
+
+extern DWT_TypeDef SimDWT;
+extern CoreDebug_TypeDef SimCoreDebug;
+
+#define DWT							(&SimDWT)
+#define CoreDebug					(&SimCoreDebug)
+#define DWT_CTRL_CYCCNTENA_Msk		(1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk	(1UL << 24)
+
+/* Memory barrier of CMSIS core */
+#define __DMB()						__sync_synchronize()
+
+#endif /* STM32F1XX_H_ */
@@ -0,0 +1,1032 @@
+/*
+ * main.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ *
+ *  Runs the driver against the I2C register model and the SSD1306 model:
+ *  draws scenes, checks that the panel shows what the framebuffer holds,
+ *  checks number formatting and glyph lookup, register reads of all lengths, slave frames with
+ *  repeated START, draws commands
+ *  queued the way an interrupt would queue them, updates a retained text
+ *  field, runs the same reads and a flush as interrupt driven tasks, XOR
+ *  draws every primitive once and twice, fills triangles against their outline,
+ *  moves sprites over a background, streams an image made by the host converter,
+ *  sends grayscale planes on time,
+ *  lets bus speed adapt to a bad cable and prints bus time of every flush.
+ *  Frames are saved as PBM into the directory given as first argument.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "stdtypes.h"
+#include "I2C_Interface.h"
+#include "I2C_Config.h"
+#include "I2C_Sim.h"
+#include "Async_Interface.h"
+#include "ssd1306.h"
+#include "ssd1306_chart.h"
+#include "ssd1306_cmdq.h"
+#include "ssd1306_field.h"
+#include "ssd1306_gray.h"
+#include "ssd1306_sprite.h"
+#include "ssd1306_text.h"
+#include "ssd1306_model.h"
+
+/* Core registers of stm32f1xx.h stand-in */
+DWT_TypeDef SimDWT;
+CoreDebug_TypeDef SimCoreDebug;
+
+/* Made by tools/ssd1306_imgconv.c at build time, columns lit as a,b,b */
+extern const SSD1306_IMAGE_t imgconv_abb;
+
+/* Register file device, first written byte selects register */
+typedef struct {
+	uint8_t Regs[256];
+	uint8_t Pointer;
+	uint8_t First;
+	I2C_SimDevice Device;
+} REGFILE_t;
+
+static uint8_t regfile_Start(void* context, uint8_t read) {
+	REGFILE_t* r = context;
+
+	r->First = !read;
+	return 1;
+}
+
+static uint8_t regfile_Write(void* context, uint8_t data) {
+	REGFILE_t* r = context;
+
+	if (r->First) {
+		r->Pointer = data;
+		r->First = 0;
+	} else {
+		r->Regs[r->Pointer++] = data;
+	}
+	return 1;
+}
+
+static uint8_t regfile_Read(void* context) {
+	REGFILE_t* r = context;
+
+	return r->Regs[r->Pointer++];
+}
+
+static SSD1306_MODEL_t lcd;
+static REGFILE_t regfile;
+/* Device on I2C2 for master transactions of the slave peripheral */
+static REGFILE_t peer;
+static const char* outdir = ".";
+static int failures;
+
+/* Compares panel with framebuffer, logical pixel (x, y) of rotation r */
+static void check_frame(const char* name, SSD1306_ROTATION_t r) {
+	uint16_t w = SSD1306_GetWidth(), h = SSD1306_GetHeight();
+	static uint8_t shown[128 * 64];
+	static uint8_t buffer[128 * 64 / 8];
+	char path[256];
+	int x, y, dx, dy, lit, bad = 0;
+
+	I2C_SimDrain();
+	SSD1306_Model_Frame(&lcd, shown);
+	SSD1306_ReadBitmap(0, 0, w, h, buffer);
+
+	for (y = 0; y < h; y++) {
+		for (x = 0; x < w; x++) {
+			lit = (buffer[x + (y / 8) * w] >> (y % 8)) & 1;
+			switch (r) {
+			case SSD1306_ROTATION_90:  dx = 127 - y; dy = x;      break;
+			case SSD1306_ROTATION_180: dx = 127 - x; dy = 63 - y; break;
+			case SSD1306_ROTATION_270: dx = y;       dy = 63 - x; break;
+			default:                   dx = x;       dy = y;      break;
+			}
+			if (shown[dy * 128 + dx] != lit) {
+				bad++;
+			}
+		}
+	}
+
+	snprintf(path, sizeof(path), "%s/%s.pbm", outdir, name);
+	if (!SSD1306_Model_WritePbm(&lcd, path)) {
+		printf("%-22s cannot write %s\n", name, path);
+		failures++;
+	}
+	if (bad) {
+		printf("%-22s FAIL, %d pixels differ\n", name, bad);
+		failures++;
+	}
+}
+
+/* Flushes and reports bus usage of the flush */
+static void flush(const char* name, uint8_t dirty, SSD1306_ROTATION_t r) {
+	I2C_SimStats bus;
+	SSD1306_FLUSH_STATS_t stats;
+
+	I2C_SimDrain();
+	I2C_SimResetStats(0);
+	if (dirty) {
+		SSD1306_UpdateDirty();
+	} else {
+		SSD1306_UpdateScreen();
+	}
+	I2C_SimDrain();
+	I2C_SimGetStats(0, &bus);
+	SSD1306_GetFlushStats(&stats);
+
+	printf("%-22s bus %8.1f us  flush %8lu cycles  %4lu bytes  %2lu transactions\n",
+		name, bus.BusPs / 1e6, (unsigned long)stats.LastTransmit,
+		(unsigned long)bus.Bytes, (unsigned long)bus.Stops);
+	check_frame(name, r);
+}
+
+/* Number formats against expected text */
+static void check_numbers(void) {
+	static const struct {
+		char Kind;
+		int32_t Value;
+		SSD1306_NUMFMT_t Fmt;
+		const char* Text;
+	} cases[] = {
+		{'i', 0,           {0, SSD1306_ALIGN_RIGHT, 0, 0, 0},                  "0"},
+		{'i', -2147483647 - 1, {0, SSD1306_ALIGN_RIGHT, 0, 0, 0},              "-2147483648"},
+		{'i', 4294967,     {0, SSD1306_ALIGN_RIGHT, 0, 0, 0},                  "4294967"},
+		{'i', -42,         {6, SSD1306_ALIGN_RIGHT, 0, 0, 0},                  "   -42"},
+		{'i', -42,         {6, SSD1306_ALIGN_RIGHT, SSD1306_NUM_ZEROS, 0, 0},  "-00042"},
+		{'i', 42,          {6, SSD1306_ALIGN_LEFT, SSD1306_NUM_PLUS, 0, 0},    "+42   "},
+		{'i', 7,           {5, SSD1306_ALIGN_CENTER, 0, 3, 0},                 " 007 "},
+		{'i', 123456,      {4, SSD1306_ALIGN_RIGHT, 0, 0, 0},                  "####"},
+		{'f', -1234,       {0, SSD1306_ALIGN_RIGHT, 0, 0, 2},                  "-12.34"},
+		{'f', 5,           {6, SSD1306_ALIGN_RIGHT, 0, 0, 3},                  " 0.005"},
+		{'f', -5,          {0, SSD1306_ALIGN_RIGHT, 0, 0, 1},                  "-0.5"},
+		{'f', 1000,        {0, SSD1306_ALIGN_RIGHT, SSD1306_NUM_PLUS, 0, 3},   "+1.000"},
+		{'i', -5,          {0, SSD1306_ALIGN_RIGHT, 0, 16, 0},                 "-000000000000005"},
+		{'i', 5,           {0, SSD1306_ALIGN_RIGHT, SSD1306_NUM_PLUS, 16, 0},  "+000000000000005"},
+		{'f', -5,          {0, SSD1306_ALIGN_RIGHT, 0, 16, 1},                 "-0000000000000.5"},
+		{'x', 0xBEEF,      {0, SSD1306_ALIGN_RIGHT, 0, 0, 0},                  "BEEF"},
+		{'x', 0x1F,        {6, SSD1306_ALIGN_RIGHT, SSD1306_NUM_LOWER, 4, 0},  "  001f"},
+		{'x', 0xFFFFFFFF,  {0, SSD1306_ALIGN_RIGHT, 0, 0, 0},                  "FFFFFFFF"},
+	};
+	char str[SSD1306_NUM_MAX + 1];
+	uint8_t i, len;
+
+	for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+		if (cases[i].Kind == 'i') {
+			len = SSD1306_FormatInt(str, cases[i].Value, &cases[i].Fmt);
+		} else if (cases[i].Kind == 'f') {
+			len = SSD1306_FormatFixed(str, cases[i].Value, &cases[i].Fmt);
+		} else {
+			len = SSD1306_FormatHex(str, (uint32_t)cases[i].Value, &cases[i].Fmt);
+		}
+		if (strcmp(str, cases[i].Text) || len != strlen(cases[i].Text)) {
+			printf("%-22s FAIL, \"%s\" instead of \"%s\"\n", "numbers", str, cases[i].Text);
+			failures++;
+		}
+	}
+}
+
+/* Sparse glyph lookup and UTF-8 text with glyphs above ASCII */
+static void check_glyphs(void) {
+	static const struct {
+		FontDef_t* Font;
+		uint32_t Cp;
+		uint16_t Glyph;
+	} cases[] = {
+		{&Font_7x10,  ' ',    0},
+		{&Font_7x10,  '~',    94},
+		{&Font_7x10,  0xB0,   95},
+		{&Font_7x10,  0xB5,   97},
+		{&Font_7x10,  0x2193, 101},
+		{&Font_7x10,  0xB4,   '?' - 32},
+		{&Font_7x10,  0x2194, '?' - 32},
+		{&Font_7x10,  0x1F600, '?' - 32},
+		{&Font_7x10,  0,      '?' - 32},
+		{&Font_11x18, 0xB0,   '?' - 32},
+		{&Font_11x18, 127,    '?' - 32},
+	};
+	SSD1306_TEXTBOX_t box = {0, 0, 128, 64, &Font_7x10, SSD1306_ALIGN_LEFT, SSD1306_TEXT_WRAP, 2};
+	uint8_t i;
+
+	for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+		if (FONTS_GetGlyph(cases[i].Font, cases[i].Cp) != cases[i].Glyph) {
+			printf("%-22s FAIL, U+%04lX is glyph %u instead of %u\n", "glyphs", (unsigned long)cases[i].Cp,
+				FONTS_GetGlyph(cases[i].Font, cases[i].Cp), cases[i].Glyph);
+			failures++;
+		}
+	}
+
+	SSD1306_Fill(SSD1306_COLOR_BLACK);
+	SSD1306_DrawText(&box, "23.5\xC2\xB0" "C \xC2\xB1" "0.1 \xC2\xB5s\n"
+		"\xE2\x86\x90 \xE2\x86\x91 \xE2\x86\x92 \xE2\x86\x93\nno glyph \xE2\x82\xAC", SSD1306_COLOR_WHITE);
+	flush("glyphs", 0, SSD1306_ROTATION_0);
+}
+
+/* Command queue filled past its size, drained by main loop */
+static void check_cmdq(void) {
+	static SSD1306_CMDQ_t q;
+	static const uint8_t icon[8] = {0x3C, 0x42, 0xA5, 0x81, 0xA5, 0x99, 0x42, 0x3C};
+	SSD1306_CMDQ_STATS_t stats;
+	uint16_t x, y, n;
+	uint8_t k;
+
+	SSD1306_CmdQ_Init(&q);
+	SSD1306_Fill(SSD1306_COLOR_BLACK);
+	SSD1306_UpdateScreen();
+	SSD1306_GotoXY(3, 5);
+
+	SSD1306_CmdQ_Text(&q, 0, 0, "IRQ text cut", &Font_7x10, SSD1306_COLOR_WHITE);
+	SSD1306_CmdQ_Number(&q, 0, 12, -4096, 7, &Font_7x10, SSD1306_COLOR_WHITE);
+	SSD1306_CmdQ_Number(&q, 0, 24, 123456, 3, &Font_7x10, SSD1306_COLOR_WHITE);
+	SSD1306_CmdQ_Rect(&q, 80, 40, 20, 10, SSD1306_COLOR_WHITE);
+	SSD1306_CmdQ_Bitmap(&q, 110, 2, 8, 8, icon, SSD1306_ROP_XOR);
+	for (k = 0; k < 20; k++) {
+		SSD1306_CmdQ_Pixel(&q, 2 * k, 60, SSD1306_COLOR_WHITE);
+	}
+
+	n = SSD1306_CmdQ_Drain(&q, 0);
+	SSD1306_CmdQ_GetStats(&q, &stats);
+	SSD1306_GetXY(&x, &y);
+	if (n != SSD1306_CMDQ_SIZE || stats.Posted != SSD1306_CMDQ_SIZE ||
+		stats.Dropped != 25 - SSD1306_CMDQ_SIZE || stats.HighWater != SSD1306_CMDQ_SIZE) {
+		printf("%-22s FAIL, drained %u posted %lu dropped %lu\n", "cmdq", n,
+			(unsigned long)stats.Posted, (unsigned long)stats.Dropped);
+		failures++;
+	}
+	if (x != 3 || y != 5) {
+		printf("%-22s FAIL, cursor moved\n", "cmdq");
+		failures++;
+	}
+	flush("cmdq", 1, SSD1306_ROTATION_0);
+}
+
+/* Retained field redraws changed cells only */
+static void check_field(void) {
+	static SSD1306_FIELD_t field;
+	static char shown[12];
+	SSD1306_NUMFMT_t fmt = {4, SSD1306_ALIGN_RIGHT, 0, 0, 1};
+	char str[24], num[SSD1306_NUM_MAX + 1];
+	uint8_t n;
+
+	SSD1306_Fill(SSD1306_COLOR_BLACK);
+	SSD1306_UpdateScreen();
+	SSD1306_Field_Init(&field, 10, 20, sizeof(shown), shown, &Font_7x10, SSD1306_COLOR_WHITE);
+
+	SSD1306_FormatFixed(num, 234, &fmt);
+	snprintf(str, sizeof(str), "Temp: %sC", num);
+	n = SSD1306_Field_Set(&field, str);
+	if (n != sizeof(shown)) {
+		printf("%-22s FAIL, %u cells drawn first\n", "field", n);
+		failures++;
+	}
+	flush("field", 1, SSD1306_ROTATION_0);
+
+	SSD1306_FormatFixed(num, 235, &fmt);
+	snprintf(str, sizeof(str), "Temp: %sC", num);
+	n = SSD1306_Field_Set(&field, str);
+	if (n != 1 || SSD1306_Field_Set(&field, str) != 0) {
+		printf("%-22s FAIL, %u cells drawn on update\n", "field", n);
+		failures++;
+	}
+	flush("field-update", 1, SSD1306_ROTATION_0);
+
+	/* Widest field, mostly off screen */
+	{
+		static SSD1306_FIELD_t wide;
+		static char cells[255];
+
+		SSD1306_Field_Init(&wide, 0, 54, sizeof(cells), cells, &Font_7x10, SSD1306_COLOR_WHITE);
+		n = SSD1306_Field_Set(&wide, "wide");
+		if (n != sizeof(cells) || SSD1306_Field_Set(&wide, "wide") != 0) {
+			printf("%-22s FAIL, %u cells drawn\n", "field-wide", n);
+			failures++;
+		}
+		flush("field-wide", 1, SSD1306_ROTATION_0);
+	}
+}
+
+/* XOR drawing twice restores background, ANDNOT clears ink */
+/* Draws shape n of the raster op scene, returns 0 past the last one */
+static uint8_t rop_shape(uint8_t n) {
+	static const SSD1306_POINT_t star[5] = {{64, 2}, {76, 60}, {30, 22}, {98, 22}, {52, 60}};
+
+	switch (n) {
+	case 0: SSD1306_DrawPixel(3, 3, SSD1306_COLOR_WHITE); break;
+	case 1: SSD1306_DrawLine(0, 63, 127, 0, SSD1306_COLOR_WHITE); break;
+	case 2: SSD1306_DrawLine(10, 5, 10, 50, SSD1306_COLOR_WHITE); break;
+	case 3: SSD1306_DrawRectangle(4, 4, 60, 30, SSD1306_COLOR_WHITE); break;
+	case 4: SSD1306_DrawRectangle(20, 40, 0, 10, SSD1306_COLOR_WHITE); break;
+	case 5: SSD1306_DrawTriangle(5, 20, 40, 30, 20, 60, SSD1306_COLOR_WHITE); break;
+	case 6: SSD1306_DrawTriangle(10, 10, 100, 50, 30, 60, SSD1306_COLOR_WHITE); break;
+	case 7: SSD1306_DrawTriangle(10, 10, 100, 12, 50, 11, SSD1306_COLOR_WHITE); break;
+	case 8: SSD1306_DrawTriangle(7, 7, 7, 7, 7, 7, SSD1306_COLOR_WHITE); break;
+	case 9: SSD1306_DrawFilledTriangle(70, 10, 120, 20, 90, 60, SSD1306_COLOR_WHITE); break;
+	case 10: SSD1306_DrawCircle(64, 32, 20, SSD1306_COLOR_WHITE); break;
+	case 11: SSD1306_DrawCircle(64, 32, 0, SSD1306_COLOR_WHITE); break;
+	case 12: SSD1306_DrawFilledCircle(100, 40, 14, SSD1306_COLOR_WHITE); break;
+	case 13: SSD1306_DrawFilledRectangle(30, 8, 40, 12, SSD1306_COLOR_WHITE); break;
+	case 14: SSD1306_DrawFilledPolygon(star, 5, SSD1306_COLOR_WHITE); break;
+	case 15:
+		SSD1306_GotoXY(12, 44);
+		SSD1306_Puts("XOR", &Font_11x18, SSD1306_COLOR_WHITE);
+		break;
+	default: return 0;
+	}
+	return 1;
+}
+
+static void rop_shapes(void) {
+	uint8_t n;
+
+	for (n = 0; rop_shape(n); n++) {
+	}
+}
+
+static void check_rop(void) {
+	static uint8_t before[128 * 8], after[128 * 8];
+	uint8_t inv, n;
+
+	/* One XOR draw on black is the COPY draw, no pixel of a shape is toggled twice */
+	for (n = 0; ; n++) {
+		SSD1306_Fill(SSD1306_COLOR_BLACK);
+		if (!rop_shape(n)) {
+			break;
+		}
+		SSD1306_ReadBitmap(0, 0, 128, 64, before);
+		SSD1306_Fill(SSD1306_COLOR_BLACK);
+		SSD1306_SetRop(SSD1306_ROP_XOR);
+		rop_shape(n);
+		SSD1306_SetRop(SSD1306_ROP_COPY);
+		SSD1306_ReadBitmap(0, 0, 128, 64, after);
+		if (memcmp(before, after, sizeof(before))) {
+			printf("%-22s FAIL, shape %u toggles pixels twice\n", "rop", n);
+			failures++;
+		}
+	}
+
+	for (inv = 0; inv < 2; inv++) {
+		SSD1306_Fill(SSD1306_COLOR_BLACK);
+		SSD1306_GotoXY(2, 2);
+		SSD1306_Puts("background", &Font_7x10, SSD1306_COLOR_WHITE);
+		SSD1306_DrawFilledCircle(32, 40, 16, SSD1306_COLOR_WHITE);
+		if (inv) {
+			SSD1306_ToggleInvert();
+		}
+		SSD1306_ReadBitmap(0, 0, 128, 64, before);
+
+		SSD1306_SetRop(SSD1306_ROP_XOR);
+		rop_shapes();
+		SSD1306_ReadBitmap(0, 0, 128, 64, after);
+		if (!memcmp(before, after, sizeof(before))) {
+			printf("%-22s FAIL, XOR drew nothing\n", "rop");
+			failures++;
+		}
+		if (!inv) {
+			flush("rop", 0, SSD1306_ROTATION_0);
+		}
+		rop_shapes();
+		SSD1306_ReadBitmap(0, 0, 128, 64, after);
+		if (memcmp(before, after, sizeof(before))) {
+			printf("%-22s FAIL, XOR twice changed background%s\n", "rop", inv ? " of inverted LCD" : "");
+			failures++;
+		}
+
+		/* Black ink draws nothing outside of COPY */
+		SSD1306_DrawFilledRectangle(0, 0, 127, 63, SSD1306_COLOR_BLACK);
+		SSD1306_SetRop(SSD1306_ROP_ANDNOT);
+		SSD1306_DrawFilledRectangle(0, 0, 127, 63, SSD1306_COLOR_WHITE);
+		SSD1306_ReadBitmap(0, 0, 128, 64, after);
+		memset(before, 0, sizeof(before));
+		if (SSD1306_SetRop(SSD1306_ROP_COPY) != SSD1306_ROP_ANDNOT || memcmp(before, after, sizeof(before))) {
+			printf("%-22s FAIL, ANDNOT left pixels lit\n", "rop");
+			failures++;
+		}
+		if (inv) {
+			SSD1306_ToggleInvert();
+		}
+	}
+}
+
+/* Filled triangle covers every column of its outline from top to bottom pixel, FNV-1a hash of
+ * all of them pins the rendering */
+#define TRIANGLE_GOLDEN 0x9ECBF1BDu
+
+static void check_triangles(void) {
+	static uint8_t outline[128 * 8], filled[128 * 8];
+	uint32_t seed = 1, hash = 2166136261u;
+	uint16_t p[6], i, x, y, bad = 0;
+	uint8_t top, bottom, lit;
+
+	for (i = 0; i < 500; i++) {
+		for (x = 0; x < 6; x++) {
+			seed = seed * 1103515245u + 12345u;
+			p[x] = (seed >> 16) % (x & 1 ? 64 : 128);
+		}
+		SSD1306_Fill(SSD1306_COLOR_BLACK);
+		SSD1306_DrawTriangle(p[0], p[1], p[2], p[3], p[4], p[5], SSD1306_COLOR_WHITE);
+		SSD1306_ReadBitmap(0, 0, 128, 64, outline);
+		SSD1306_Fill(SSD1306_COLOR_BLACK);
+		SSD1306_DrawFilledTriangle(p[0], p[1], p[2], p[3], p[4], p[5], SSD1306_COLOR_WHITE);
+		SSD1306_ReadBitmap(0, 0, 128, 64, filled);
+
+		for (x = 0; x < 128; x++) {
+			top = 0xFF;
+			bottom = 0;
+			for (y = 0; y < 64; y++) {
+				if ((outline[x + (y / 8) * 128] >> (y % 8)) & 1) {
+					top = y < top ? y : top;
+					bottom = y;
+				}
+			}
+			for (y = 0; y < 64; y++) {
+				lit = (filled[x + (y / 8) * 128] >> (y % 8)) & 1;
+				if (lit != (y >= top && y <= bottom)) {
+					bad++;
+				}
+			}
+		}
+		for (x = 0; x < sizeof(filled); x++) {
+			hash = (hash ^ filled[x]) * 16777619u;
+		}
+	}
+
+	if (bad) {
+		printf("%-22s FAIL, %u pixels outside of outline columns\n", "filled-triangle", bad);
+		failures++;
+	}
+	if (hash != TRIANGLE_GOLDEN) {
+		printf("%-22s FAIL, hash %08lX instead of %08lX\n", "filled-triangle",
+			(unsigned long)hash, (unsigned long)TRIANGLE_GOLDEN);
+		failures++;
+	}
+}
+
+/* Sprite in both modes over a background: shown, moved partly off screen and hidden again */
+static void check_sprites(void) {
+	static const uint8_t ball[8] = {0x3C, 0x7E, 0xE7, 0xC3, 0xC3, 0xE7, 0x7E, 0x3C};
+	static const uint8_t disc[8] = {0x3C, 0x7E, 0xFF, 0xFF, 0xFF, 0xFF, 0x7E, 0x3C};
+	static uint8_t background[128 * 8], now[128 * 8];
+	uint8_t under[8];
+	SSD1306_SPRITE_t sprite;
+	SSD1306_SPRITE_MODE_t mode;
+	const char* name;
+
+	for (mode = SSD1306_SPRITE_XOR; mode <= SSD1306_SPRITE_SAVE_UNDER; mode++) {
+		name = mode == SSD1306_SPRITE_XOR ? "sprite-xor" : "sprite-save";
+
+		SSD1306_Fill(SSD1306_COLOR_BLACK);
+		SSD1306_GotoXY(2, 2);
+		SSD1306_Puts("sprites", &Font_7x10, SSD1306_COLOR_WHITE);
+		SSD1306_DrawFilledCircle(64, 36, 20, SSD1306_COLOR_WHITE);
+		SSD1306_DrawLine(0, 63, 127, 14, SSD1306_COLOR_WHITE);
+		SSD1306_UpdateScreen();
+		SSD1306_ReadBitmap(0, 0, 128, 64, background);
+
+		/* Unaligned Y spans two LCD pages */
+		SSD1306_Sprite_Init(&sprite, ball, mode == SSD1306_SPRITE_XOR ? NULL : disc, 8, 8, mode, under);
+		SSD1306_Sprite_Show(&sprite, 50, 21);
+		SSD1306_ReadBitmap(0, 0, 128, 64, now);
+		if (!memcmp(background, now, sizeof(now))) {
+			printf("%-22s FAIL, sprite not drawn\n", name);
+			failures++;
+		}
+		SSD1306_Sprite_Move(&sprite, 90, 30);
+		flush(name, 1, SSD1306_ROTATION_0);
+		SSD1306_Sprite_Move(&sprite, -3, 60);
+		SSD1306_Sprite_Hide(&sprite);
+		flush(mode == SSD1306_SPRITE_XOR ? "sprite-xor-hidden" : "sprite-save-hidden", 1, SSD1306_ROTATION_0);
+
+		SSD1306_ReadBitmap(0, 0, 128, 64, now);
+		if (memcmp(background, now, sizeof(now))) {
+			printf("%-22s FAIL, background not restored\n", name);
+			failures++;
+		}
+	}
+}
+
+/* Converted image decoded straight to the panel */
+static void check_image(void) {
+	static uint8_t shown[128 * 64];
+	int x, y, bad = 0;
+
+	SSD1306_Fill(SSD1306_COLOR_BLACK);
+	SSD1306_UpdateScreen();
+	SSD1306_StreamImage(0, 0, &imgconv_abb);
+	I2C_SimDrain();
+	SSD1306_Model_Frame(&lcd, shown);
+
+	for (y = 0; y < 64; y++) {
+		for (x = 0; x < 128; x++) {
+			if (shown[y * 128 + x] != (x % 3 != 0)) {
+				bad++;
+			}
+		}
+	}
+	if (bad) {
+		printf("%-22s FAIL, %d pixels differ\n", "image-abb", bad);
+		failures++;
+	}
+}
+
+/* Virtual time in microseconds */
+static uint32_t now_us(void) {
+	return (uint32_t)(I2C_SimNowPs() / 1000000);
+}
+
+/* Sends gray frames for run_us, panel must show plane sequence level >= 1, >= 2, == 3.
+ * Returns frames sent, shortest and longest send time */
+static uint32_t gray_Run(uint32_t run_us, uint32_t* fastest, uint32_t* slowest) {
+	static uint8_t shown[128 * 64];
+	SSD1306_GRAY_STATS_t stats;
+	uint32_t start = now_us(), t, sent = 0;
+	uint16_t x, y, bad;
+	uint8_t frame;
+
+	*fastest = 0xFFFFFFFF;
+	*slowest = 0;
+	while (now_us() - start < run_us) {
+		t = now_us();
+		if (!SSD1306_Gray_Process(t)) {
+			I2C_SimIdle(100000000);
+			continue;
+		}
+		I2C_SimDrain();
+		t = now_us() - t;
+		*fastest = t < *fastest ? t : *fastest;
+		*slowest = t > *slowest ? t : *slowest;
+		sent++;
+
+		/* Band of level n is 32 columns wide, frame f lights levels above f */
+		SSD1306_Gray_GetStats(&stats);
+		frame = (stats.Frames - 1) % 3;
+		SSD1306_Model_Frame(&lcd, shown);
+		for (bad = 0, y = 0; y < 64; y++) {
+			for (x = 0; x < 128; x++) {
+				bad += shown[y * 128 + x] != (x / 32 > frame);
+			}
+		}
+		if (bad) {
+			printf("%-22s FAIL, frame %lu plane %u, %u pixels differ\n", "gray",
+				(unsigned long)stats.Frames, frame, bad);
+			failures++;
+		}
+	}
+	return sent;
+}
+
+/* Grayscale planes and refresh statistics against virtual time */
+static void check_gray(void) {
+	SSD1306_GRAY_STATS_t stats;
+	uint32_t sent, fastest, slowest, late;
+	uint8_t level;
+
+	SSD1306_Gray_Init(now_us());
+	for (level = 0; level < 4; level++) {
+		SSD1306_Gray_DrawFilledRectangle(level * 32, 0, 32, 64, level);
+	}
+
+	/* Bus keeps up with 60 ms frames, 16 frames per second */
+	SSD1306_Gray_SetFrameTime(60000);
+	sent = gray_Run(2500000, &fastest, &slowest);
+	SSD1306_Gray_GetStats(&stats);
+	printf("%-22s %lu frames  %lu fps  %lu late  %lu-%lu us per frame\n", "gray-60ms",
+		(unsigned long)stats.Frames, (unsigned long)stats.FrameRate, (unsigned long)stats.Late,
+		(unsigned long)fastest, (unsigned long)slowest);
+	if (stats.Frames != sent || stats.Late || slowest > 60000 ||
+		stats.FrameRate < 16 || stats.FrameRate > 17 ||
+		stats.CycleRate != stats.FrameRate / 3) {
+		printf("%-22s FAIL, %lu fps %lu late\n", "gray-60ms", (unsigned long)stats.FrameRate, (unsigned long)stats.Late);
+		failures++;
+	}
+
+	/* 5 ms is shorter than one frame on the bus, every frame is late and frame rate is
+	 * what the bus manages */
+	late = stats.Late;
+	SSD1306_Gray_SetFrameTime(5000);
+	sent = gray_Run(2500000, &fastest, &slowest);
+	SSD1306_Gray_GetStats(&stats);
+	printf("%-22s %lu frames  %lu fps  %lu late  %lu-%lu us per frame\n", "gray-5ms",
+		(unsigned long)stats.Frames, (unsigned long)stats.FrameRate, (unsigned long)stats.Late,
+		(unsigned long)fastest, (unsigned long)slowest);
+	if (slowest < 5000 || stats.Late - late < sent - 1 ||
+		stats.FrameRate < 1000000 / (slowest + 100) || stats.FrameRate > 1000000 / fastest) {
+		printf("%-22s FAIL, %lu fps %lu late of %lu\n", "gray-5ms", (unsigned long)stats.FrameRate,
+			(unsigned long)(stats.Late - late), (unsigned long)sent);
+		failures++;
+	}
+
+	SSD1306_Gray_DeInit();
+	flush("gray-deinit", 0, SSD1306_ROTATION_0);
+}
+
+/* Register reads of every receive sequence: 1, 2 and more bytes */
+static void check_reads(void) {
+	static const uint8_t pattern[8] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+	uint8_t reg = 0x40;
+	uint8_t rx[8];
+	uint16_t n;
+
+	I2C_WriteMulti(I2C1, regfile.Device.Address, reg, (u8*)pattern, sizeof(pattern));
+	for (n = 1; n <= sizeof(rx); n++) {
+		memset(rx, 0, sizeof(rx));
+		if (I2C_WriteRead(I2C1, regfile.Device.Address, &reg, 1, rx, n) || memcmp(rx, pattern, n)) {
+			printf("%-22s FAIL, %u bytes\n", "write-read", n);
+			failures++;
+		}
+	}
+	if (I2C_IsDeviceConnected(I2C1, 0x50)) {
+		printf("%-22s FAIL, absent device answered\n", "connected");
+		failures++;
+	}
+}
+
+/* Write frames reported by slave callback */
+static struct {
+	uint8_t Calls;
+	uint8_t Dual;
+	uint16_t Length;
+} slave_Frames;
+
+static void slave_Callback(u8 dual, u16 length) {
+	slave_Frames.Calls++;
+	slave_Frames.Dual = dual;
+	slave_Frames.Length = length;
+}
+
+static void slave_Done(void* context, u8 error) {
+	*(uint8_t*)context = error ? 2 : 1;
+}
+
+/* External write and read after a successful master transaction on I2C2 */
+static void slave_check_master(const char* name, uint8_t done, uint8_t calls) {
+	static const uint8_t frame[3] = {0x04, 0x05, 0x06};
+	static const uint8_t reply[2] = {0xB0, 0xB1};
+	uint8_t rx[4], w, r;
+
+	w = I2C_SimExternalWrite(1, 0x42, frame, sizeof(frame), 1);
+	if (slave_Frames.Calls != calls || I2C_SlaveRead(I2C2, rx, sizeof(rx)) != sizeof(frame) ||
+		memcmp(rx, frame, sizeof(frame))) {
+		w = 0;
+	}
+	I2C_SlaveWrite(I2C2, reply, sizeof(reply));
+	r = I2C_SimExternalRead(1, 0x42, rx, sizeof(reply), 1);
+	if (memcmp(rx, reply, sizeof(reply))) {
+		r = 0;
+	}
+	if (done != 1 || w != sizeof(frame) || r != sizeof(reply)) {
+		printf("%-22s FAIL, master %s, %u of %u bytes written, %u of %u read\n", name,
+			done == 1 ? "done" : "failed", w, (unsigned)sizeof(frame), r, (unsigned)sizeof(reply));
+		failures++;
+	}
+}
+
+/* Slave on I2C2: write with STOP, register write then repeated START read of second address,
+ * then both directions again after master transactions of the same peripheral */
+static void check_slave(void) {
+	static const uint8_t frame[3] = {0x01, 0x02, 0x03};
+	static const uint8_t reply[2] = {0xA0, 0xA1};
+	uint8_t reg = 0x10, rx[4];
+	volatile uint8_t done = 0;
+	uint8_t n;
+
+	I2C_SlaveInit(I2C2, 0x42, DUAL_EN, 0x44, slave_Callback);
+
+	n = I2C_SimExternalWrite(1, 0x42, frame, sizeof(frame), 1);
+	if (n != sizeof(frame) || slave_Frames.Calls != 1 || slave_Frames.Dual || slave_Frames.Length != 3 ||
+		I2C_SlaveRead(I2C2, rx, sizeof(rx)) != 3 || memcmp(rx, frame, 3)) {
+		printf("%-22s FAIL, %u bytes %u frames\n", "slave-write", n, slave_Frames.Calls);
+		failures++;
+	}
+
+	/* Write frame ends at ADDR of the read, not at STOP */
+	I2C_SlaveWrite(I2C2, reply, sizeof(reply));
+	I2C_SimExternalWrite(1, 0x44, &reg, 1, 0);
+	if (slave_Frames.Calls != 1) {
+		printf("%-22s FAIL, frame reported before it ended\n", "slave-restart");
+		failures++;
+	}
+	n = I2C_SimExternalRead(1, 0x44, rx, sizeof(reply), 1);
+	if (n != sizeof(reply) || memcmp(rx, reply, sizeof(reply)) ||
+		slave_Frames.Calls != 2 || !slave_Frames.Dual || slave_Frames.Length != 1 ||
+		I2C_SlaveRead(I2C2, rx, sizeof(rx)) != 1 || rx[0] != reg) {
+		printf("%-22s FAIL, %u frames, last %u bytes\n", "slave-restart", slave_Frames.Calls, slave_Frames.Length);
+		failures++;
+	}
+
+	/* Read alone is no write frame, other addresses are not answered */
+	I2C_SimExternalRead(1, 0x42, rx, 1, 1);
+	if (slave_Frames.Calls != 2 || I2C_SimExternalWrite(1, 0x50, frame, 1, 1)) {
+		printf("%-22s FAIL, %u frames\n", "slave-read", slave_Frames.Calls);
+		failures++;
+	}
+
+	/* Background master transaction on the same peripheral leaves slave working */
+	I2C_WriteReadAsync(I2C2, 0x50, frame, 1, rx, 2, slave_Done, (void*)&done);
+	while (!done) {
+		I2C_SimStep();
+	}
+	I2C_SimDrain();
+	n = I2C_SimExternalWrite(1, 0x42, frame, sizeof(frame), 1);
+	if (done != 2 || n != sizeof(frame) || slave_Frames.Calls != 3 || I2C_SlaveRead(I2C2, rx, sizeof(rx)) != 3) {
+		printf("%-22s FAIL, slave deaf after master transaction\n", "slave-master");
+		failures++;
+	}
+
+	/* Successful write and multi-byte read end with buffer interrupt off, slave needs it back */
+	done = 0;
+	I2C_WriteMultiAsync(I2C2, peer.Device.Address, 0x20, frame, sizeof(frame), slave_Done, (void*)&done);
+	while (!done) {
+		I2C_SimStep();
+	}
+	I2C_SimDrain();
+	slave_check_master("slave-master-write", done, 4);
+
+	done = 0;
+	reg = 0x20;
+	I2C_WriteReadAsync(I2C2, peer.Device.Address, &reg, 1, rx, sizeof(frame), slave_Done, (void*)&done);
+	while (!done) {
+		I2C_SimStep();
+	}
+	I2C_SimDrain();
+	if (memcmp(rx, frame, sizeof(frame))) {
+		printf("%-22s FAIL, wrong bytes read\n", "slave-master-read");
+		failures++;
+	}
+	slave_check_master("slave-master-read", done, 5);
+}
+
+/* State of interrupt driven tasks */
+typedef struct {
+	Async_Task Reader;
+	Async_Task Worker;
+	Async_Op Op;
+	uint8_t Reg;
+	uint8_t Len;
+	uint8_t Rx[8];
+	uint32_t Work;
+	char Text[8];
+} ASYNC_APP_t;
+
+static const uint8_t async_pattern[8] = {0xA1, 0xB2, 0xC3, 0xD4, 0xE5, 0xF6, 0x07, 0x18};
+
+/* Writes pattern, reads it back with every receive sequence, draws and flushes in background */
+static Async_State async_Reader(Async_Task* task) {
+	ASYNC_APP_t* app = task->Context;
+
+	ASYNC_BEGIN(task);
+	app->Reg = 0x80;
+	ASYNC_AWAIT_OP(task, &app->Op, I2C_WriteMultiAsync(I2C1, regfile.Device.Address, app->Reg,
+		async_pattern, sizeof(async_pattern), Async_OpDone, &app->Op));
+	if (app->Op.Error) {
+		printf("%-22s FAIL, write\n", "async-write");
+		failures++;
+	}
+
+	for (app->Len = 1; app->Len <= sizeof(app->Rx); app->Len++) {
+		memset(app->Rx, 0, sizeof(app->Rx));
+		ASYNC_AWAIT_OP(task, &app->Op, I2C_WriteReadAsync(I2C1, regfile.Device.Address, &app->Reg, 1,
+			app->Rx, app->Len, Async_OpDone, &app->Op));
+		if (app->Op.Error || memcmp(app->Rx, async_pattern, app->Len)) {
+			printf("%-22s FAIL, %u bytes\n", "async-write-read", app->Len);
+			failures++;
+		}
+
+		/* Value of this read on screen, sent while next read waits */
+		snprintf(app->Text, sizeof(app->Text), "%02X", app->Rx[app->Len - 1]);
+		SSD1306_GotoXY((app->Len - 1) * 16, 50);
+		SSD1306_Puts(app->Text, &Font_7x10, SSD1306_COLOR_WHITE);
+		SSD1306_MarkDirty((app->Len - 1) * 16, 50, 14, 10);
+		ASYNC_AWAIT(task, SSD1306_UpdateDirtyAsync());
+	}
+
+	/* NACK ends operation with error */
+	ASYNC_AWAIT_OP(task, &app->Op, I2C_WriteReadAsync(I2C1, 0x50, &app->Reg, 1, app->Rx, 2,
+		Async_OpDone, &app->Op));
+	if (!app->Op.Error) {
+		printf("%-22s FAIL, absent device answered\n", "async-connected");
+		failures++;
+	}
+	ASYNC_END(task);
+}
+
+/* Other work done while reader waits for bus */
+static Async_State async_Worker(Async_Task* task) {
+	ASYNC_APP_t* app = task->Context;
+
+	ASYNC_BEGIN(task);
+	while (Async_Running(&app->Reader)) {
+		app->Work++;
+		ASYNC_YIELD(task);
+	}
+	ASYNC_END(task);
+}
+
+/* Runs reader and worker, core sleeps until next bus event between runs */
+static void check_async(void) {
+	static ASYNC_APP_t app;
+	I2C_SimStats bus;
+	uint32_t runs = 0;
+
+	I2C_SimDrain();
+	I2C_SimResetStats(0);
+	Async_Start(&app.Reader, async_Reader, &app);
+	Async_Start(&app.Worker, async_Worker, &app);
+	while (Async_Run() && ++runs < 100000) {
+		I2C_SimStep();
+	}
+	if (Async_Running(&app.Reader) || Async_Running(&app.Worker)) {
+		printf("%-22s FAIL, tasks did not finish\n", "async");
+		failures++;
+		return;
+	}
+	I2C_SimGetStats(0, &bus);
+	printf("%-22s bus %8.1f us  %4lu bytes  %2lu transactions  %lu worker runs\n",
+		"async", bus.BusPs / 1e6, (unsigned long)bus.Bytes, (unsigned long)bus.Stops,
+		(unsigned long)app.Work);
+	check_frame("async", SSD1306_ROTATION_0);
+}
+
+/* Background transaction ended */
+static void speed_Done(void* context, u8 error) {
+	*(uint8_t*)context = error ? 2 : 1;
+}
+
+/* Register reads through a cable limit, returns number of failed ones */
+static uint16_t speed_Reads(uint16_t count) {
+	uint8_t reg = 0x40, rx[2];
+	uint16_t failed = 0;
+
+	while (count--) {
+		failed += I2C_WriteRead(I2C1, regfile.Device.Address, &reg, 1, rx, sizeof(rx));
+	}
+	return failed;
+}
+
+/* Master settles at the fastest speed the cable carries */
+static void check_speed(void) {
+	static const uint8_t pattern[4] = {0x12, 0x34, 0x56, 0x78};
+	volatile uint8_t done = 0;
+	I2C_Errors e;
+	uint16_t failed;
+
+	/* Speed level and probing state left by other scenarios do not count */
+	I2C_SimDrain();
+	I2C_Init(I2C1);
+
+	/* Probes of 400 kHz fail, each one costs one read */
+	I2C_ResetErrors(I2C1);
+	I2C_SimSetCable(0, 250);
+	failed = speed_Reads(4000);
+	I2C_GetErrors(I2C1, &e);
+	printf("%-22s %3u kHz  %u failed reads  %lu bus errors  %lu down  %lu up\n", "speed-250k",
+		I2C_GetSpeed(I2C1), failed, (unsigned long)e.Berr, (unsigned long)e.StepsDown, (unsigned long)e.StepsUp);
+	if (I2C_GetSpeed(I2C1) != 200 || !failed || failed != e.StepsDown || e.Berr < failed) {
+		printf("%-22s FAIL, did not settle at 200 kHz\n", "speed-250k");
+		failures++;
+	}
+
+	/* Worse cable, steps down to 50 kHz */
+	I2C_SimSetCable(0, 80);
+	failed = speed_Reads(100);
+	if (I2C_GetSpeed(I2C1) != 50 || failed != 2 * I2C_SPEED_FAULTS || speed_Reads(10)) {
+		printf("%-22s FAIL, %u kHz after %u failed reads\n", "speed-80k", I2C_GetSpeed(I2C1), failed);
+		failures++;
+	}
+
+	/* Cable fixed, climbs back to 400 kHz */
+	I2C_SimSetCable(0, 0);
+	I2C_ResetErrors(I2C1);
+	failed = speed_Reads(4000);
+	I2C_GetErrors(I2C1, &e);
+	if (I2C_GetSpeed(I2C1) != 400 || failed || e.StepsUp != 3 || e.StepsDown) {
+		printf("%-22s FAIL, %u kHz after %lu steps up\n", "speed-recover", I2C_GetSpeed(I2C1),
+			(unsigned long)e.StepsUp);
+		failures++;
+	}
+
+	/* Bus error ends background transaction through error interrupt */
+	I2C_SimSetCable(0, 250);
+	I2C_WriteMultiAsync(I2C1, regfile.Device.Address, 0x40, pattern, sizeof(pattern), speed_Done, (void*)&done);
+	while (!done) {
+		I2C_SimStep();
+	}
+	I2C_GetErrors(I2C1, &e);
+	if (done != 2 || e.Berr != 1 || I2C_GetSpeed(I2C1) != 400) {
+		printf("%-22s FAIL, bus error not reported\n", "speed-async");
+		failures++;
+	}
+	I2C_SimSetCable(0, 0);
+}
+
+int main(int argc, char** argv) {
+	static int16_t samples[64];
+	uint8_t r;
+
+	if (argc > 1) {
+		outdir = argv[1];
+	}
+
+	SSD1306_Model_Init(&lcd, SSD1306_I2C_ADDR);
+	I2C_SimAttach(0, &lcd.Device);
+	memset(&regfile, 0, sizeof(regfile));
+	regfile.Device.Address = 0xA0;
+	regfile.Device.Context = &regfile;
+	regfile.Device.Start = regfile_Start;
+	regfile.Device.Write = regfile_Write;
+	regfile.Device.Read = regfile_Read;
+	I2C_SimAttach(0, &regfile.Device);
+	memset(&peer, 0, sizeof(peer));
+	peer.Device.Address = 0xA2;
+	peer.Device.Context = &peer;
+	peer.Device.Start = regfile_Start;
+	peer.Device.Write = regfile_Write;
+	peer.Device.Read = regfile_Read;
+	I2C_SimAttach(1, &peer.Device);
+
+	I2C_SetStatsClock(I2C_SimCycles);
+	SSD1306_SetStatsClock(I2C_SimCycles);
+
+	if (!SSD1306_Init()) {
+		printf("init FAIL, LCD not detected\n");
+		return 1;
+	}
+	check_frame("init", SSD1306_ROTATION_0);
+
+	/* Full frame */
+	SSD1306_GotoXY(2, 2);
+	SSD1306_Puts("SSD1306 sim", &Font_7x10, SSD1306_COLOR_WHITE);
+	SSD1306_DrawRectangle(0, 0, 127, 63, SSD1306_COLOR_WHITE);
+	SSD1306_DrawFilledCircle(96, 40, 14, SSD1306_COLOR_WHITE);
+	SSD1306_DrawLine(4, 60, 60, 16, SSD1306_COLOR_WHITE);
+	flush("full", 0, SSD1306_ROTATION_0);
+
+	/* One glyph changed */
+	SSD1306_GotoXY(2, 40);
+	SSD1306_Putc('7', &Font_7x10, SSD1306_COLOR_WHITE);
+	SSD1306_MarkDirty(2, 40, Font_7x10.FontWidth, Font_7x10.FontHeight);
+	flush("dirty-glyph", 1, SSD1306_ROTATION_0);
+
+	/* Content scroll of a strip chart */
+	for (r = 0; r < 64; r++) {
+		samples[r] = 0;
+	}
+	SSD1306_Fill(SSD1306_COLOR_BLACK);
+	SSD1306_UpdateScreen();
+	{
+		SSD1306_CHART_t chart;
+		uint8_t k;
+
+		SSD1306_Chart_Init(&chart, 48, 16, 64, 32, samples, &Font_7x10, SSD1306_CHART_SCROLL);
+		SSD1306_Chart_SetRange(&chart, -100, 100);
+		SSD1306_UpdateDirty();
+		uint32_t scrolls = lcd.Scrolls;
+
+		/* Samples 25 ms apart scroll every time, a burst sends whole plot until the LCD is ready */
+		for (k = 0; k < 80; k++) {
+			SSD1306_Chart_Push(&chart, (int16_t)((k * 37) % 200) - 100, now_us() / 1000);
+			SSD1306_UpdateDirty();
+			if (k < 40) {
+				I2C_SimIdle(25000000000ULL);
+			}
+		}
+		if (lcd.ScrollsDropped || lcd.Scrolls - scrolls < 40 || lcd.Scrolls - scrolls == 80) {
+			printf("%-22s FAIL, %lu scrolls %lu dropped\n", "chart-scroll",
+				(unsigned long)(lcd.Scrolls - scrolls), (unsigned long)lcd.ScrollsDropped);
+			failures++;
+		}
+	}
+	flush("chart-scroll", 1, SSD1306_ROTATION_0);
+
+	/* Every rotation */
+	for (r = SSD1306_ROTATION_0; r <= SSD1306_ROTATION_270; r++) {
+		char name[32];
+
+		SSD1306_SetRotation(r);
+		SSD1306_Fill(SSD1306_COLOR_BLACK);
+		SSD1306_GotoXY(1, 1);
+		SSD1306_Puts("ROT", &Font_7x10, SSD1306_COLOR_WHITE);
+		SSD1306_DrawTriangle(5, 20, 40, 30, 20, 60, SSD1306_COLOR_WHITE);
+		snprintf(name, sizeof(name), "rotation-%u", r * 90);
+		flush(name, 0, r);
+	}
+	SSD1306_SetRotation(SSD1306_ROTATION_0);
+
+	check_numbers();
+	check_glyphs();
+	check_cmdq();
+	check_field();
+	check_reads();
+	check_slave();
+	check_async();
+	check_rop();
+	check_triangles();
+	check_sprites();
+	check_image();
+	check_gray();
+	check_speed();
+
+	if (failures) {
+		printf("%d checks failed\n", failures);
+		return 1;
+	}
+	printf("all checks passed\n");
+	return 0;
+}
@@ -0,0 +1,221 @@
+/*
+ * ssd1306_model.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ */
+#include "ssd1306_model.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Parameter bytes which follow command */
+static uint8_t ssd1306_Model_Params(uint8_t cmd) {
+	switch (cmd) {
+	case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+	case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+		return 1;
+	case 0x21: case 0x22: case 0xA3:
+		return 2;
+	case 0x29: case 0x2A:
+		return 5;
+	case 0x26: case 0x27: case 0x2C: case 0x2D:
+		return 6;
+	default:
+		return 0;
+	}
+}
+
+/* Moves columns start..end of pages first..last one column, content wraps around */
+static void ssd1306_Model_Scroll(SSD1306_MODEL_t* m, uint8_t left) {
+	uint8_t first = m->Cmd[2] & 7, last = m->Cmd[4] & 7;
+	uint8_t start = m->Cmd[5] & 127, end = m->Cmd[6] & 127;
+	uint8_t p, t;
+
+	if (start >= end) {
+		return;
+	}
+	if (m->Scrolls && I2C_SimNowPs() - m->ScrollPs < 2ULL * SSD1306_MODEL_FRAME_US * 1000000) {
+		/* Previous scroll still running */
+		m->ScrollsDropped++;
+		return;
+	}
+	m->Scrolls++;
+	m->ScrollPs = I2C_SimNowPs();
+	for (p = first; p <= last; p++) {
+		if (left) {
+			t = m->Ram[p][start];
+			memmove(&m->Ram[p][start], &m->Ram[p][start + 1], end - start);
+			m->Ram[p][end] = t;
+		} else {
+			t = m->Ram[p][end];
+			memmove(&m->Ram[p][start + 1], &m->Ram[p][start], end - start);
+			m->Ram[p][start] = t;
+		}
+	}
+}
+
+/* Executes collected command */
+static void ssd1306_Model_Command(SSD1306_MODEL_t* m) {
+	uint8_t c = m->Cmd[0];
+
+	m->Commands++;
+	if (c <= 0x0F) {
+		m->Column = (m->Column & 0xF0) | c;
+	} else if (c <= 0x1F) {
+		m->Column = ((c & 0x07) << 4) | (m->Column & 0x0F);
+	} else if (c >= 0x40 && c <= 0x7F) {
+		m->StartLine = c & 0x3F;
+	} else if (c >= 0xB0 && c <= 0xB7) {
+		m->Page = c & 7;
+	} else {
+		switch (c) {
+		case 0x20: m->Mode = m->Cmd[1] & 3; break;
+		case 0x21:
+			m->ColumnStart = m->Column = m->Cmd[1] & 127;
+			m->ColumnEnd = m->Cmd[2] & 127;
+			break;
+		case 0x22:
+			m->PageStart = m->Page = m->Cmd[1] & 7;
+			m->PageEnd = m->Cmd[2] & 7;
+			break;
+		case 0x2C: ssd1306_Model_Scroll(m, 0); break;
+		case 0x2D: ssd1306_Model_Scroll(m, 1); break;
+		case 0x81: m->Contrast = m->Cmd[1]; break;
+		case 0xA0: case 0xA1: m->SegRemap = c & 1; break;
+		case 0xA4: case 0xA5: m->EntireOn = c & 1; break;
+		case 0xA6: case 0xA7: m->Inverted = c & 1; break;
+		case 0xA8: m->Multiplex = m->Cmd[1] & 0x3F; break;
+		case 0xAE: case 0xAF: m->On = c & 1; break;
+		case 0xC0: case 0xC8: m->ComRemap = (c >> 3) & 1; break;
+		case 0xD3: m->Offset = m->Cmd[1] & 0x3F; break;
+		default: break;
+		}
+	}
+}
+
+/* Writes GDDRAM byte and moves pointers like the addressing mode says */
+static void ssd1306_Model_Data(SSD1306_MODEL_t* m, uint8_t data) {
+	m->Ram[m->Page][m->Column] = data;
+	m->DataBytes++;
+
+	if (m->Mode == 1) {
+		/* Vertical: page first, then column */
+		if (m->Page++ >= m->PageEnd) {
+			m->Page = m->PageStart;
+			m->Column = (m->Column >= m->ColumnEnd) ? m->ColumnStart : m->Column + 1;
+		}
+	} else if (m->Column++ >= m->ColumnEnd) {
+		m->Column = m->ColumnStart;
+		if (m->Mode == 0) {
+			/* Horizontal: next page, page addressing stays on its page */
+			m->Page = (m->Page >= m->PageEnd) ? m->PageStart : m->Page + 1;
+		}
+	}
+}
+
+static uint8_t ssd1306_Model_Start(void* context, uint8_t read) {
+	SSD1306_MODEL_t* m = context;
+
+	/* Serial interface cannot be read, there is no status byte on I2C */
+	m->Control = 1;
+	return !read;
+}
+
+static uint8_t ssd1306_Model_Write(void* context, uint8_t data) {
+	SSD1306_MODEL_t* m = context;
+
+	if (m->Control) {
+		/* Co = 0: rest of transaction is data or commands, Co = 1: only next byte is */
+		m->Single = (data & 0x80) != 0;
+		m->Data = (data & 0x40) != 0;
+		m->Control = 0;
+		return 1;
+	}
+
+	if (m->Data) {
+		ssd1306_Model_Data(m, data);
+	} else {
+		if (m->CmdLen == 0) {
+			m->CmdNeed = ssd1306_Model_Params(data);
+		}
+		m->Cmd[m->CmdLen++] = data;
+		if (m->CmdLen > m->CmdNeed) {
+			ssd1306_Model_Command(m);
+			m->CmdLen = 0;
+		}
+	}
+
+	m->Control = m->Single;
+	return 1;
+}
+
+static uint8_t ssd1306_Model_Read(void* context) {
+	(void)context;
+	return 0xFF;
+}
+
+void SSD1306_Model_Init(SSD1306_MODEL_t* model, uint8_t address) {
+	memset(model, 0, sizeof(*model));
+	model->ColumnEnd = 127;
+	model->PageEnd = 7;
+	model->Mode = 2;
+	model->Multiplex = 63;
+	model->Contrast = 0x7F;
+
+	model->Device.Address = address;
+	model->Device.Context = model;
+	model->Device.Start = ssd1306_Model_Start;
+	model->Device.Write = ssd1306_Model_Write;
+	model->Device.Read = ssd1306_Model_Read;
+	model->Device.Stop = NULL;
+}
+
+void SSD1306_Model_Frame(const SSD1306_MODEL_t* model, uint8_t* pixels) {
+	uint8_t x, y, row, col, lit;
+
+	for (y = 0; y < 64; y++) {
+		for (x = 0; x < 128; x++) {
+			row = model->ComRemap ? y : 63 - y;
+			col = model->SegRemap ? x : 127 - x;
+			lit = 0;
+			if (row <= model->Multiplex) {
+				row = (row + model->Offset + model->StartLine) & 63;
+				lit = (model->Ram[row / 8][col] >> (row % 8)) & 1;
+			}
+			if (model->EntireOn) {
+				lit = 1;
+			}
+			lit ^= model->Inverted;
+			pixels[y * 128 + x] = model->On ? lit : 0;
+		}
+	}
+}
+
+uint8_t SSD1306_Model_WritePbm(const SSD1306_MODEL_t* model, const char* path) {
+	uint8_t pixels[128 * 64];
+	uint8_t row[16];
+	uint8_t ok;
+	FILE* f;
+	int x, y;
+
+	f = fopen(path, "wb");
+	if (!f) {
+		return 0;
+	}
+
+	SSD1306_Model_Frame(model, pixels);
+	fprintf(f, "P4\n128 64\n");
+	for (y = 0; y < 64; y++) {
+		memset(row, 0, sizeof(row));
+		for (x = 0; x < 128; x++) {
+			if (pixels[y * 128 + x]) {
+				row[x / 8] |= 0x80 >> (x % 8);
+			}
+		}
+		fwrite(row, 1, sizeof(row), f);
+	}
+
+	ok = !ferror(f);
+	fclose(f);
+	return ok;
+}
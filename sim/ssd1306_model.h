@@ -0,0 +1,88 @@
+/*
+ * ssd1306_model.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ */
+
+#ifndef SSD1306_MODEL_H_
+#define SSD1306_MODEL_H_
+
+/**
+ * Host model of SSD1306 controller behind I2C.
+ *
+ * Interprets control bytes, the fundamental, addressing, hardware configuration and content scroll
+ * commands, and writes of GDDRAM in page, horizontal and vertical addressing modes.
+ * The panel is seen as mounted upright with segment remap A1 and COM scan C8,
+ * which is what the driver sends for SSD1306_ROTATION_0.
+ * Like the controller, the model ignores a content scroll which comes less than two frame
+ * periods after the previous one.
+ */
+
+#include "I2C_Sim.h"
+
+/* Frame period of the panel in microseconds */
+#ifndef SSD1306_MODEL_FRAME_US
+#define SSD1306_MODEL_FRAME_US   8000
+#endif
+
+/**
+ * @brief  Controller state
+ */
+typedef struct {
+	uint8_t Ram[8][128];     /*!< GDDRAM, [page][column], LSB on top */
+	uint8_t Page;            /*!< Page pointer */
+	uint8_t Column;          /*!< Column pointer */
+	uint8_t ColumnStart;     /*!< Column range of horizontal and vertical modes */
+	uint8_t ColumnEnd;
+	uint8_t PageStart;       /*!< Page range of horizontal and vertical modes */
+	uint8_t PageEnd;
+	uint8_t Mode;            /*!< 0 horizontal, 1 vertical, 2 page addressing */
+	uint8_t SegRemap;        /*!< A1 was sent */
+	uint8_t ComRemap;        /*!< C8 was sent */
+	uint8_t StartLine;
+	uint8_t Offset;
+	uint8_t Multiplex;
+	uint8_t Contrast;
+	uint8_t Inverted;
+	uint8_t EntireOn;
+	uint8_t On;
+	uint8_t Control;         /*!< Next byte is a control byte */
+	uint8_t Single;          /*!< Control byte had Co set, one byte follows */
+	uint8_t Data;            /*!< D/C of following bytes */
+	uint8_t Cmd[8];          /*!< Command being collected */
+	uint8_t CmdLen;
+	uint8_t CmdNeed;
+	uint32_t Commands;       /*!< Commands executed */
+	uint32_t DataBytes;      /*!< GDDRAM bytes written */
+	uint32_t Scrolls;        /*!< Content scrolls executed */
+	uint32_t ScrollsDropped; /*!< Content scrolls ignored, too early after the previous one */
+	uint64_t ScrollPs;       /*!< Virtual time of last executed content scroll */
+	I2C_SimDevice Device;    /*!< Bus device, attach it with I2C_SimAttach */
+} SSD1306_MODEL_t;
+
+/**
+ * @brief  Resets controller to its power on state
+ * @param  *model: Model to reset
+ * @param  address: Left aligned I2C address, 0x78 or 0x7A
+ * @retval None
+ */
+void SSD1306_Model_Init(SSD1306_MODEL_t* model, uint8_t address);
+
+/**
+ * @brief  Renders what panel shows
+ * @param  *model: Model
+ * @param  *pixels: 128 * 64 bytes, row by row, 1 for lit pixel
+ * @retval None
+ */
+void SSD1306_Model_Frame(const SSD1306_MODEL_t* model, uint8_t* pixels);
+
+/**
+ * @brief  Saves what panel shows as raw PBM, lit pixels are black
+ * @param  *model: Model
+ * @param  *path: File name
+ * @retval 1 on success, 0 when file could not be written
+ */
+uint8_t SSD1306_Model_WritePbm(const SSD1306_MODEL_t* model, const char* path);
+
+#endif /* SSD1306_MODEL_H_ */
@@ -28,10 +28,10 @@
  */
 #include "ssd1306.h"
 
-/* Write command */
-#define SSD1306_WRITECOMMAND(command)      ssd1306_I2C_Write(SSD1306_I2C, SSD1306_I2C_ADDR, 0x00, (command))
-/* Write data */
-#define SSD1306_WRITEDATA(data)            ssd1306_I2C_Write(SSD1306_I2C, SSD1306_I2C_ADDR, 0x40, (data))
+/* Write command burst */
+#define SSD1306_WRITECOMMANDS(commands)    SSD1306_Transport_Command((commands), sizeof(commands))
+/* Points fetched from generator at once */
+#define SSD1306_POINT_BLOCK      32
 /* Absolute value */
 #define ABS(x)   ((x) > 0 ? (x) : -(x))
 
@@ -44,16 +44,425 @@ typedef struct {
 	uint16_t CurrentY;
 	uint8_t Inverted;
 	uint8_t Initialized;
+	SSD1306_TEXTMODE_t TextMode;
+	SSD1306_ROTATION_t Rotation;
+	SSD1306_ROP_t Rop;
 } SSD1306_t;
 
 /* Private variable */
 static SSD1306_t SSD1306;
 
+/* Drawing area, width and height are swapped in portrait rotations */
+#define SSD1306_W    ((SSD1306.Rotation & 1) ? SSD1306_HEIGHT : SSD1306_WIDTH)
+#define SSD1306_H    ((SSD1306.Rotation & 1) ? SSD1306_WIDTH : SSD1306_HEIGHT)
+
+/* Segment remap and COM scan direction of every rotation */
+static const uint8_t ssd1306_Remap[4][2] = {
+	{0xA1, 0xC8},  /* 0 */
+	{0xA0, 0xC8},  /* 90, transposed buffer mirrored left to right */
+	{0xA0, 0xC0},  /* 180 */
+	{0xA1, 0xC0}   /* 270, transposed buffer mirrored top to bottom */
+};
+
+/* Solid patterns for black and white fills */
+static const uint8_t ssd1306_Solid[2][8] = {
+	{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+	{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}
+};
+
+/* 8x8 Bayer matrix, [row][column] */
+static const uint8_t ssd1306_Bayer[8][8] = {
+	{ 0, 32,  8, 40,  2, 34, 10, 42},
+	{48, 16, 56, 24, 50, 18, 58, 26},
+	{12, 44,  4, 36, 14, 46,  6, 38},
+	{60, 28, 52, 20, 62, 30, 54, 22},
+	{ 3, 35, 11, 43,  1, 33,  9, 41},
+	{51, 19, 59, 27, 49, 17, 57, 25},
+	{15, 47,  7, 39, 13, 45,  5, 37},
+	{63, 31, 55, 23, 61, 29, 53, 21}
+};
+
+/* Changed columns of every page, page is clean when first > last */
+static uint8_t SSD1306_DirtyFirst[SSD1306_HEIGHT / 8];
+static uint8_t SSD1306_DirtyLast[SSD1306_HEIGHT / 8];
+
+/* Private background flush structure */
+typedef struct {
+	uint32_t Begin;
+	uint8_t Page;
+	uint8_t Running;
+} SSD1306_ASYNC_t;
+
+/* Private variable */
+static SSD1306_ASYNC_t SSD1306_Async;
+
+/* LCD page built from portrait buffer, kept until background transfer is over */
+static uint8_t SSD1306_Row[SSD1306_WIDTH];
+
+/* Private present governor structure */
+typedef struct {
+	uint32_t Interval;
+	uint32_t LastPresent;
+	uint8_t Pending;
+	SSD1306_PRESENT_STATS_t Stats;
+} SSD1306_GOVERNOR_t;
+
+/* Private variable */
+static SSD1306_GOVERNOR_t SSD1306_Governor = {SSD1306_PRESENT_INTERVAL};
+
+#if SSD1306_STATS_ENABLE
+/* Reads DWT cycle counter */
+static uint32_t ssd1306_DwtClock(void) {
+	return DWT->CYCCNT;
+}
+
+/* Flush statistics, time source and end of last flush */
+static SSD1306_FLUSH_STATS_t SSD1306_Stats;
+static uint32_t (*ssd1306_StatsClock)(void) = ssd1306_DwtClock;
+static uint32_t ssd1306_FlushEnd;
+#endif
+
+/* Starts timing of flush, returns its start time */
+static uint32_t ssd1306_FlushBegin(void) {
+#if SSD1306_STATS_ENABLE
+	uint32_t now = ssd1306_StatsClock();
+
+	SSD1306_Stats.LastRender = now - ssd1306_FlushEnd;
+	SSD1306_Stats.RenderCycles += SSD1306_Stats.LastRender;
+	return now;
+#else
+	return 0;
+#endif
+}
+
+/* Ends timing of flush started at begin */
+static void ssd1306_FlushDone(uint32_t begin) {
+#if SSD1306_STATS_ENABLE
+	ssd1306_FlushEnd = ssd1306_StatsClock();
+	SSD1306_Stats.LastTransmit = ssd1306_FlushEnd - begin;
+	SSD1306_Stats.TransmitCycles += SSD1306_Stats.LastTransmit;
+	if (SSD1306_Stats.LastTransmit > SSD1306_Stats.MaxTransmit) {
+		SSD1306_Stats.MaxTransmit = SSD1306_Stats.LastTransmit;
+	}
+	SSD1306_Stats.Flushes++;
+#else
+	(void)begin;
+#endif
+}
+
+/* Marks all pages clean */
+static void ssd1306_ClearDirty(void) {
+	memset(SSD1306_DirtyFirst, 0xFF, sizeof(SSD1306_DirtyFirst));
+	memset(SSD1306_DirtyLast, 0x00, sizeof(SSD1306_DirtyLast));
+	SSD1306_Governor.Pending = 0;
+}
+
+/* Applies raster operation to one LCD byte, only bits set in mask are changed */
+static void ssd1306_RopByte(uint8_t* p, uint8_t bits, uint8_t mask, SSD1306_ROP_t rop) {
+	switch (rop) {
+	case SSD1306_ROP_OR:
+		*p |= bits;
+		break;
+	case SSD1306_ROP_XOR:
+		*p ^= bits;
+		break;
+	case SSD1306_ROP_ANDNOT:
+		*p &= ~bits;
+		break;
+	default:
+		*p = (*p & ~mask) | bits;
+		break;
+	}
+}
+
+/* Resolves color and raster op mode to operation on stored bits of drawn pixels, 0 when nothing is drawn */
+static uint8_t ssd1306_InkOp(SSD1306_COLOR_t color, SSD1306_ROP_t* op) {
+	uint8_t lit = color == SSD1306_COLOR_WHITE;
+
+	switch (SSD1306.Rop) {
+	case SSD1306_ROP_XOR:
+		/* Toggling does not depend on inversion */
+		*op = SSD1306_ROP_XOR;
+		return lit;
+	case SSD1306_ROP_OR:
+		if (!lit) {
+			return 0;
+		}
+		break;
+	case SSD1306_ROP_ANDNOT:
+		if (!lit) {
+			return 0;
+		}
+		lit = 0;
+		break;
+	default:
+		break;
+	}
+
+	/* Inverted LCD stores lit pixels as zeros */
+	*op = (lit ^ SSD1306.Inverted) ? SSD1306_ROP_OR : SSD1306_ROP_ANDNOT;
+	return 1;
+}
+
+/* Applies resolved operation to one pixel, negative coordinates wrap and are clipped */
+static void ssd1306_Plot(int16_t x, int16_t y, SSD1306_ROP_t op) {
+	if ((uint16_t)x < SSD1306_W && (uint16_t)y < SSD1306_H) {
+		ssd1306_RopByte(&SSD1306_Buffer[x + (y >> 3) * SSD1306_W], 1 << (y & 7), 0, op);
+	}
+}
+
+/* Writes 8 vertical pixels to column x starting at row y, only bits set in mask are affected */
+static void ssd1306_BlitColumn(int16_t x, int16_t y, uint8_t bits, uint8_t mask, SSD1306_ROP_t rop) {
+	uint8_t* p;
+	uint8_t shift;
+
+	if (
+		x < 0 || x >= SSD1306_W ||
+		y <= -8 || y >= SSD1306_H
+	) {
+		/* Error */
+		return;
+	}
+
+	/* Cut off rows above the screen */
+	if (y < 0) {
+		bits >>= -y;
+		mask >>= -y;
+		y = 0;
+	}
+
+	bits &= mask;
+	shift = y % 8;
+	p = &SSD1306_Buffer[x + (y / 8) * SSD1306_W];
+	ssd1306_RopByte(p, bits << shift, mask << shift, rop);
+
+	/* Rest of the bits go to the top of next page */
+	if (shift && (y / 8 + 1) < SSD1306_H / 8) {
+		ssd1306_RopByte(p + SSD1306_W, bits >> (8 - shift), mask >> (8 - shift), rop);
+	}
+}
+
+/* Reads 8 vertical pixels from column x starting at row y, pixels outside the screen read as 0 */
+static uint8_t ssd1306_ReadColumn(int16_t x, int16_t y) {
+	const uint8_t* p;
+	uint8_t shift, bits;
+
+	if (
+		x < 0 || x >= SSD1306_W ||
+		y <= -8 || y >= SSD1306_H
+	) {
+		return 0;
+	}
+
+	if (y < 0) {
+		return SSD1306_Buffer[x] << -y;
+	}
+
+	shift = y % 8;
+	p = &SSD1306_Buffer[x + (y / 8) * SSD1306_W];
+	bits = *p >> shift;
+	if (shift && (y / 8 + 1) < SSD1306_H / 8) {
+		bits |= p[SSD1306_W] << (8 - shift);
+	}
+	return bits;
+}
+
+/* Fills rows y0 to y1 of column x with pattern byte, a whole page byte at a time.
+ * SSD1306_ROP_COPY pattern is in lit pixels, other operations are resolved already */
+static void ssd1306_FillColumn(int16_t x, int16_t y0, int16_t y1, uint8_t pattern, SSD1306_ROP_t op) {
+	uint8_t* p;
+	uint8_t mask;
+	int16_t page, last;
+
+	/* Clip to screen */
+	if (x < 0 || x >= SSD1306_W) {
+		return;
+	}
+	if (y0 < 0) {
+		y0 = 0;
+	}
+	if (y1 >= SSD1306_H) {
+		y1 = SSD1306_H - 1;
+	}
+	if (y0 > y1) {
+		return;
+	}
+
+	/* Check if pixels are inverted */
+	if (SSD1306.Inverted && op == SSD1306_ROP_COPY) {
+		pattern = ~pattern;
+	}
+
+	last = y1 / 8;
+	p = &SSD1306_Buffer[x + (y0 / 8) * SSD1306_W];
+	for (page = y0 / 8; page <= last; page++, p += SSD1306_W) {
+		/* Rows of this page inside the span */
+		mask = 0xFF;
+		if (page == y0 / 8) {
+			mask &= 0xFF << (y0 % 8);
+		}
+		if (page == last) {
+			mask &= 0xFF >> (7 - y1 % 8);
+		}
+		ssd1306_RopByte(p, pattern & mask, mask, op);
+	}
+}
+
+/* Fills x0..x1, y0..y1 with 8x8 pattern */
+static void ssd1306_FillRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1, const uint8_t* pattern, SSD1306_ROP_t op) {
+	if (x0 < 0) {
+		x0 = 0;
+	}
+	if (x1 >= SSD1306_W) {
+		x1 = SSD1306_W - 1;
+	}
+	for (; x0 <= x1; x0++) {
+		ssd1306_FillColumn(x0, y0, y1, pattern[x0 & 7], op);
+	}
+}
+
+/* Fills circle with 8x8 pattern column by column, every column is visited once */
+static void ssd1306_FillCircle(int16_t x0, int16_t y0, int16_t r, const uint8_t* pattern, SSD1306_ROP_t op) {
+	int16_t f = 1 - r;
+	int16_t ddF_x = 1;
+	int16_t ddF_y = -2 * r;
+	int16_t x = 0;
+	int16_t y = r;
+
+	ssd1306_FillColumn(x0, y0 - r, y0 + r, pattern[x0 & 7], op);
+
+	while (x < y) {
+		if (f >= 0) {
+			/* Columns +-y are done before y changes, unless x columns reach them */
+			if (y > x + 1) {
+				ssd1306_FillColumn(x0 + y, y0 - x, y0 + x, pattern[(x0 + y) & 7], op);
+				ssd1306_FillColumn(x0 - y, y0 - x, y0 + x, pattern[(x0 - y) & 7], op);
+			}
+			y--;
+			ddF_y += 2;
+			f += ddF_y;
+		}
+		x++;
+		ddF_x += 2;
+		f += ddF_x;
+
+		ssd1306_FillColumn(x0 + x, y0 - y, y0 + y, pattern[(x0 + x) & 7], op);
+		ssd1306_FillColumn(x0 - x, y0 - y, y0 + y, pattern[(x0 - x) & 7], op);
+	}
+}
+
+/* Transposes 8x8 pixel block: bit j of out[i] becomes bit i of in[j] */
+static void ssd1306_Transpose8(const uint8_t* in, uint8_t* out) {
+	uint32_t x = in[0] | (in[1] << 8) | (in[2] << 16) | ((uint32_t)in[3] << 24);
+	uint32_t y = in[4] | (in[5] << 8) | (in[6] << 16) | ((uint32_t)in[7] << 24);
+	uint32_t t;
+
+	/* Swap 1x1, then 2x2 blocks inside every 4x4 block, then 4x4 blocks */
+	t = (x ^ (x >> 7)) & 0x00AA00AA;
+	x ^= t ^ (t << 7);
+	t = (y ^ (y >> 7)) & 0x00AA00AA;
+	y ^= t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000CCCC;
+	x ^= t ^ (t << 14);
+	t = (y ^ (y >> 14)) & 0x0000CCCC;
+	y ^= t ^ (t << 14);
+	t = ((y << 4) & 0xF0F0F0F0) | (x & 0x0F0F0F0F);
+	y = (y & 0xF0F0F0F0) | ((x >> 4) & 0x0F0F0F0F);
+	x = t;
+
+	out[0] = x;
+	out[1] = x >> 8;
+	out[2] = x >> 16;
+	out[3] = x >> 24;
+	out[4] = y;
+	out[5] = y >> 8;
+	out[6] = y >> 16;
+	out[7] = y >> 24;
+}
+
+/* Sends columns first to last of LCD page m, data goes in background when async is set */
+static void ssd1306_SendPage(uint8_t m, uint8_t first, uint8_t last, uint8_t async) {
+	const uint8_t* data = &SSD1306_Buffer[SSD1306_WIDTH * m + first];
+	uint8_t cmd[3];
+	uint8_t col;
+
+	/* Row may still be on its way */
+	while (SSD1306_Transport_Busy())
+		;
+
+	if (SSD1306.Rotation & 1) {
+		/* Portrait buffer: LCD page m is made of pixel columns 8m..8m+7, 8 LCD columns per buffer page */
+		for (col = first & ~7; col <= last; col += 8) {
+			ssd1306_Transpose8(&SSD1306_Buffer[8 * m + (col / 8) * SSD1306_HEIGHT], &SSD1306_Row[col]);
+		}
+		data = &SSD1306_Row[first];
+	}
+
+	/* Page and start column */
+	cmd[0] = 0xB0 + m;
+	cmd[1] = first & 0x0F;
+	cmd[2] = 0x10 | (first >> 4);
+	SSD1306_WRITECOMMANDS(cmd);
+
+	/* Write multi data */
+	if (async) {
+		SSD1306_Transport_DataAsync(data, last - first + 1, NULL);
+	} else {
+		SSD1306_Transport_Data(data, last - first + 1);
+	}
+
+#if SSD1306_STATS_ENABLE
+	SSD1306_Stats.Bursts += 2;
+	SSD1306_Stats.Bytes += sizeof(cmd) + last - first + 1;
+#endif
+}
+
 uint8_t SSD1306_Init()
 	{
+	uint8_t init[] = {
+		0xAE, //display off
+		0x20, //Set Memory Addressing Mode
+		0x10, //00,Horizontal Addressing Mode;01,Vertical Addressing Mode;10,Page Addressing Mode (RESET);11,Invalid
+		0xB0, //Set Page Start Address for Page Addressing Mode,0-7
+		ssd1306_Remap[SSD1306.Rotation][1], //Set COM Output Scan Direction
+		0x00, //---set low column address
+		0x10, //---set high column address
+		0x40, //--set start line address
+		0x81, //--set contrast control register
+		0xFF,
+		ssd1306_Remap[SSD1306.Rotation][0], //--set segment re-map 0 to 127
+		0xA6, //--set normal display
+		0xA8, //--set multiplex ratio(1 to 64)
+		0x3F, //
+		0xA4, //0xa4,Output follows RAM content;0xa5,Output ignores RAM content
+		0xD3, //-set display offset
+		0x00, //-not offset
+		0xD5, //--set display clock divide ratio/oscillator frequency
+		0xF0, //--set divide ratio
+		0xD9, //--set pre-charge period
+		0x22, //
+		0xDA, //--set com pins hardware configuration
+		0x12,
+		0xDB, //--set vcomh
+		0x20, //0x20,0.77xVcc
+		0x8D, //--set DC-DC enable
+		0x14, //
+		0xAF  //--turn on SSD1306 panel
+	};
+
+#if SSD1306_STATS_ENABLE
+	if (ssd1306_StatsClock == ssd1306_DwtClock) {
+		/* Cycle counter runs only with trace enabled */
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	}
+#endif
 
-	/* Init I2C */
-	ssd1306_I2C_Init();
+	/* Init bus */
+	if (!SSD1306_Transport_Init()) {
+		/* Return false */
+		return 0;
+	}
 
 
 
@@ -62,35 +471,8 @@ uint8_t SSD1306_Init()
 	while(p>0)
 		p--;
 
-	/* Init LCD */
-	SSD1306_WRITECOMMAND(0xAE); //display off
-	SSD1306_WRITECOMMAND(0x20); //Set Memory Addressing Mode
-	SSD1306_WRITECOMMAND(0x10); //00,Horizontal Addressing Mode;01,Vertical Addressing Mode;10,Page Addressing Mode (RESET);11,Invalid
-	SSD1306_WRITECOMMAND(0xB0); //Set Page Start Address for Page Addressing Mode,0-7
-	SSD1306_WRITECOMMAND(0xC8); //Set COM Output Scan Direction
-	SSD1306_WRITECOMMAND(0x00); //---set low column address
-	SSD1306_WRITECOMMAND(0x10); //---set high column address
-	SSD1306_WRITECOMMAND(0x40); //--set start line address
-	SSD1306_WRITECOMMAND(0x81); //--set contrast control register
-	SSD1306_WRITECOMMAND(0xFF);
-	SSD1306_WRITECOMMAND(0xA1); //--set segment re-map 0 to 127
-	SSD1306_WRITECOMMAND(0xA6); //--set normal display
-	SSD1306_WRITECOMMAND(0xA8); //--set multiplex ratio(1 to 64)
-	SSD1306_WRITECOMMAND(0x3F); //
-	SSD1306_WRITECOMMAND(0xA4); //0xa4,Output follows RAM content;0xa5,Output ignores RAM content
-	SSD1306_WRITECOMMAND(0xD3); //-set display offset
-	SSD1306_WRITECOMMAND(0x00); //-not offset
-	SSD1306_WRITECOMMAND(0xD5); //--set display clock divide ratio/oscillator frequency
-	SSD1306_WRITECOMMAND(0xF0); //--set divide ratio
-	SSD1306_WRITECOMMAND(0xD9); //--set pre-charge period
-	SSD1306_WRITECOMMAND(0x22); //
-	SSD1306_WRITECOMMAND(0xDA); //--set com pins hardware configuration
-	SSD1306_WRITECOMMAND(0x12);
-	SSD1306_WRITECOMMAND(0xDB); //--set vcomh
-	SSD1306_WRITECOMMAND(0x20); //0x20,0.77xVcc
-	SSD1306_WRITECOMMAND(0x8D); //--set DC-DC enable
-	SSD1306_WRITECOMMAND(0x14); //
-	SSD1306_WRITECOMMAND(0xAF); //--turn on SSD1306 panel
+	/* Init LCD, one command burst */
+	SSD1306_WRITECOMMANDS(init);
 
 	/* Clear screen */
 	SSD1306_Fill(SSD1306_COLOR_BLACK);
@@ -110,16 +492,183 @@ uint8_t SSD1306_Init()
 }
 
 void SSD1306_UpdateScreen(void) {
+	uint32_t begin = ssd1306_FlushBegin();
 	uint8_t m;
 
 	for (m = 0; m < 8; m++) {
-		SSD1306_WRITECOMMAND(0xB0 + m);
-		SSD1306_WRITECOMMAND(0x00);
-		SSD1306_WRITECOMMAND(0x10);
+		ssd1306_SendPage(m, 0, SSD1306_WIDTH - 1, 0);
+	}
+
+	/* Everything is on LCD now */
+	ssd1306_ClearDirty();
+	ssd1306_FlushDone(begin);
+}
+
+void SSD1306_MarkDirty(int16_t x, int16_t y, uint16_t w, uint16_t h) {
+	int16_t x1 = x + w - 1;
+	int16_t y1 = y + h - 1;
+	int16_t t;
+	uint8_t p;
+
+	/* Clip to screen */
+	if (x < 0) {
+		x = 0;
+	}
+	if (y < 0) {
+		y = 0;
+	}
+	if (x1 >= SSD1306_W) {
+		x1 = SSD1306_W - 1;
+	}
+	if (y1 >= SSD1306_H) {
+		y1 = SSD1306_H - 1;
+	}
+	if (!w || !h || x > x1 || y > y1) {
+		return;
+	}
+
+	if (SSD1306.Rotation & 1) {
+		/* Portrait: rows are LCD columns, whole transposed blocks are sent */
+		t = x;
+		x = y & ~7;
+		y = t;
+		t = x1;
+		x1 = y1 | 7;
+		y1 = t;
+	}
 
-		/* Write multi data */
-		ssd1306_I2C_WriteMulti(SSD1306_I2C, SSD1306_I2C_ADDR, 0x40, &SSD1306_Buffer[SSD1306_WIDTH * m], SSD1306_WIDTH);
+	for (p = y / 8; p <= y1 / 8; p++) {
+		if (x < SSD1306_DirtyFirst[p]) {
+			SSD1306_DirtyFirst[p] = x;
+		}
+		if (x1 > SSD1306_DirtyLast[p]) {
+			SSD1306_DirtyLast[p] = x1;
+		}
 	}
+	SSD1306_Governor.Pending = 1;
+}
+
+void SSD1306_UpdateDirty(void) {
+	uint32_t begin = ssd1306_FlushBegin();
+	uint8_t m;
+
+	for (m = 0; m < SSD1306_HEIGHT / 8; m++) {
+		/* Write only changed columns */
+		if (SSD1306_DirtyFirst[m] <= SSD1306_DirtyLast[m]) {
+			ssd1306_SendPage(m, SSD1306_DirtyFirst[m], SSD1306_DirtyLast[m], 0);
+		}
+	}
+
+	ssd1306_ClearDirty();
+	ssd1306_FlushDone(begin);
+}
+
+uint8_t SSD1306_UpdateDirtyAsync(void) {
+	uint8_t m, first, last;
+
+	if (SSD1306_Transport_Busy()) {
+		/* Page before is still on its way */
+		return 0;
+	}
+
+	if (!SSD1306_Async.Running) {
+		SSD1306_Async.Begin = ssd1306_FlushBegin();
+		SSD1306_Async.Page = 0;
+		SSD1306_Async.Running = 1;
+	}
+
+	for (m = SSD1306_Async.Page; m < SSD1306_HEIGHT / 8; m++) {
+		if (SSD1306_DirtyFirst[m] <= SSD1306_DirtyLast[m]) {
+			/* Unmark first, marks made while page is sent stay for the next flush */
+			first = SSD1306_DirtyFirst[m];
+			last = SSD1306_DirtyLast[m];
+			SSD1306_DirtyFirst[m] = 0xFF;
+			SSD1306_DirtyLast[m] = 0x00;
+			SSD1306_Async.Page = m + 1;
+			ssd1306_SendPage(m, first, last, 1);
+			return 0;
+		}
+	}
+
+	/* Last page is on LCD */
+	SSD1306_Async.Running = 0;
+	for (m = 0; m < SSD1306_HEIGHT / 8 && SSD1306_DirtyFirst[m] > SSD1306_DirtyLast[m]; m++)
+		;
+	if (m == SSD1306_HEIGHT / 8) {
+		SSD1306_Governor.Pending = 0;
+	}
+	ssd1306_FlushDone(SSD1306_Async.Begin);
+	return 1;
+}
+
+void SSD1306_Invalidate(int16_t x, int16_t y, uint16_t w, uint16_t h) {
+	SSD1306_Governor.Stats.Invalidated++;
+	if (SSD1306_Governor.Pending) {
+		/* Folded into frame which is already waiting */
+		SSD1306_Governor.Stats.Merged++;
+	}
+
+	SSD1306_MarkDirty(x, y, w, h);
+}
+
+void SSD1306_SetPresentInterval(uint32_t ms) {
+	SSD1306_Governor.Interval = ms;
+}
+
+uint8_t SSD1306_Present(uint32_t now_ms) {
+	uint8_t m;
+
+	if (!SSD1306_Governor.Pending) {
+		/* Nothing to send */
+		return 0;
+	}
+
+	if (
+		SSD1306_Governor.Stats.Presented &&
+		(now_ms - SSD1306_Governor.LastPresent) < SSD1306_Governor.Interval
+	) {
+		/* Too early, changes stay pending for the next present */
+		SSD1306_Governor.Stats.Dropped++;
+		return 0;
+	}
+
+	for (m = 0; m < SSD1306_HEIGHT / 8; m++) {
+		if (SSD1306_DirtyFirst[m] <= SSD1306_DirtyLast[m]) {
+			SSD1306_Governor.Stats.Bytes += SSD1306_DirtyLast[m] - SSD1306_DirtyFirst[m] + 1;
+		}
+	}
+
+	SSD1306_UpdateDirty();
+	SSD1306_Governor.LastPresent = now_ms;
+	SSD1306_Governor.Stats.Presented++;
+	return 1;
+}
+
+void SSD1306_GetPresentStats(SSD1306_PRESENT_STATS_t* stats) {
+	*stats = SSD1306_Governor.Stats;
+}
+
+void SSD1306_GetFlushStats(SSD1306_FLUSH_STATS_t* stats) {
+#if SSD1306_STATS_ENABLE
+	*stats = SSD1306_Stats;
+#else
+	memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+void SSD1306_ResetFlushStats(void) {
+#if SSD1306_STATS_ENABLE
+	memset(&SSD1306_Stats, 0, sizeof(SSD1306_Stats));
+	ssd1306_FlushEnd = ssd1306_StatsClock();
+#endif
+}
+
+void SSD1306_SetStatsClock(uint32_t (*clock)(void)) {
+#if SSD1306_STATS_ENABLE
+	ssd1306_StatsClock = clock ? clock : ssd1306_DwtClock;
+#else
+	(void)clock;
+#endif
 }
 
 void SSD1306_ToggleInvert(void) {
@@ -134,20 +683,54 @@ void SSD1306_ToggleInvert(void) {
 	}
 }
 
+void SSD1306_SetRotation(SSD1306_ROTATION_t rotation) {
+	/* Portrait and landscape buffers have different layout */
+	if ((rotation ^ SSD1306.Rotation) & 1) {
+		SSD1306_Fill(SSD1306_COLOR_BLACK);
+		SSD1306.CurrentX = 0;
+		SSD1306.CurrentY = 0;
+	}
+	SSD1306.Rotation = (SSD1306_ROTATION_t)(rotation & 3);
+
+	/* Mirroring is done by LCD */
+	SSD1306_WRITECOMMANDS(ssd1306_Remap[SSD1306.Rotation]);
+
+	/* LCD contents are stale in every orientation */
+	SSD1306_MarkDirty(0, 0, SSD1306_W, SSD1306_H);
+}
+
+uint16_t SSD1306_GetWidth(void) {
+	return SSD1306_W;
+}
+
+uint16_t SSD1306_GetHeight(void) {
+	return SSD1306_H;
+}
+
 void SSD1306_Fill(SSD1306_COLOR_t color) {
 	/* Set memory */
 	memset(SSD1306_Buffer, (color == SSD1306_COLOR_BLACK) ? 0x00 : 0xFF, sizeof(SSD1306_Buffer));
 }
 
 void SSD1306_DrawPixel(uint16_t x, uint16_t y, SSD1306_COLOR_t color) {
+	SSD1306_ROP_t op;
+
 	if (
-		x >= SSD1306_WIDTH ||
-		y >= SSD1306_HEIGHT
+		x >= SSD1306_W ||
+		y >= SSD1306_H
 	) {
 		/* Error */
 		return;
 	}
 
+	/* Raster op mode, inversion included */
+	if (SSD1306.Rop != SSD1306_ROP_COPY) {
+		if (ssd1306_InkOp(color, &op)) {
+			ssd1306_RopByte(&SSD1306_Buffer[x + (y / 8) * SSD1306_W], 1 << (y % 8), 0, op);
+		}
+		return;
+	}
+
 	/* Check if pixels are inverted */
 	if (SSD1306.Inverted) {
 		color = (SSD1306_COLOR_t)!color;
@@ -155,9 +738,54 @@ void SSD1306_DrawPixel(uint16_t x, uint16_t y, SSD1306_COLOR_t color) {
 
 	/* Set color */
 	if (color == SSD1306_COLOR_WHITE) {
-		SSD1306_Buffer[x + (y / 8) * SSD1306_WIDTH] |= 1 << (y % 8);
+		SSD1306_Buffer[x + (y / 8) * SSD1306_W] |= 1 << (y % 8);
 	} else {
-		SSD1306_Buffer[x + (y / 8) * SSD1306_WIDTH] &= ~(1 << (y % 8));
+		SSD1306_Buffer[x + (y / 8) * SSD1306_W] &= ~(1 << (y % 8));
+	}
+}
+
+/* Applies operation to list of pixels, operation is already resolved */
+static void ssd1306_PlotPoints(const SSD1306_POINT_t* points, uint16_t count, SSD1306_ROP_t op) {
+	uint16_t w = SSD1306_W;
+	uint16_t h = SSD1306_H;
+	const SSD1306_POINT_t* end = points + count;
+	uint8_t* p;
+	uint8_t bit;
+
+	/* Negative coordinates wrap to large unsigned values, one compare clips both sides */
+	for (; points < end; points++) {
+		if ((uint16_t)points->x < w && (uint16_t)points->y < h) {
+			p = &SSD1306_Buffer[points->x + (points->y >> 3) * w];
+			bit = 1 << (points->y & 7);
+			if (op == SSD1306_ROP_OR) {
+				*p |= bit;
+			} else if (op == SSD1306_ROP_ANDNOT) {
+				*p &= ~bit;
+			} else {
+				*p ^= bit;
+			}
+		}
+	}
+}
+
+void SSD1306_DrawPixels(const SSD1306_POINT_t* points, uint16_t count, SSD1306_COLOR_t color) {
+	SSD1306_ROP_t op;
+
+	if (ssd1306_InkOp(color, &op)) {
+		ssd1306_PlotPoints(points, count, op);
+	}
+}
+
+void SSD1306_DrawPixelsFrom(SSD1306_POINT_GENERATOR_t generator, void* context, SSD1306_COLOR_t color) {
+	SSD1306_POINT_t block[SSD1306_POINT_BLOCK];
+	SSD1306_ROP_t op;
+	uint16_t n;
+
+	if (!ssd1306_InkOp(color, &op)) {
+		return;
+	}
+	while ((n = generator(context, block, SSD1306_POINT_BLOCK)) > 0) {
+		ssd1306_PlotPoints(block, n, op);
 	}
 }
 
@@ -167,37 +795,144 @@ void SSD1306_GotoXY(uint16_t x, uint16_t y) {
 	SSD1306.CurrentY = y;
 }
 
-char SSD1306_Putc(char ch, FontDef_t* Font, SSD1306_COLOR_t color) {
-	uint32_t i, b, j;
+void SSD1306_GetXY(uint16_t* x, uint16_t* y) {
+	*x = SSD1306.CurrentX;
+	*y = SSD1306.CurrentY;
+}
+
+void SSD1306_SetTextMode(SSD1306_TEXTMODE_t mode) {
+	SSD1306.TextMode = mode;
+}
+
+SSD1306_ROP_t SSD1306_SetRop(SSD1306_ROP_t rop) {
+	SSD1306_ROP_t old = SSD1306.Rop;
+
+	SSD1306.Rop = rop;
+	return old;
+}
+
+/* Writes one glyph column, bit i of ink is row i. Whole LCD bytes are written */
+static void ssd1306_PutColumn(int16_t x, int16_t y, uint32_t ink, uint8_t height, SSD1306_COLOR_t color) {
+	uint8_t k, bits, mask;
+	SSD1306_ROP_t op;
+
+	if (SSD1306.Rop != SSD1306_ROP_COPY) {
+		/* Raster op mode touches glyph pixels only, in both text modes */
+		if (ssd1306_InkOp(color, &op)) {
+			for (k = 0; k < height; k += 8) {
+				mask = (height - k) >= 8 ? 0xFF : (0xFF >> (8 - (height - k)));
+				ssd1306_BlitColumn(x, y + k, (uint8_t)(ink >> k), mask, op);
+			}
+		}
+		return;
+	}
+
+	/* Lit pixels are stored as zeros when LCD is inverted */
+	if (SSD1306.Inverted) {
+		color = (SSD1306_COLOR_t)!color;
+	}
+
+	for (k = 0; k < height; k += 8) {
+		mask = (height - k) >= 8 ? 0xFF : (0xFF >> (8 - (height - k)));
+		bits = (uint8_t)(ink >> k);
+
+		if (SSD1306.TextMode == SSD1306_TEXTMODE_TRANSPARENT) {
+			/* Only glyph pixels are touched */
+			ssd1306_BlitColumn(x, y + k, color ? 0xFF : 0x00, bits & mask, SSD1306_ROP_COPY);
+		} else {
+			/* Glyph pixels get color, background gets the other one */
+			ssd1306_BlitColumn(x, y + k, color ? bits : ~bits, mask, SSD1306_ROP_COPY);
+		}
+	}
+}
+
+/* Reads height bits of packed glyph starting at bit, only bytes holding them are read */
+static uint32_t ssd1306_PackedColumn(const uint8_t* glyph, uint32_t bit, uint8_t height) {
+	const uint8_t* p = &glyph[bit >> 3];
+	uint8_t shift = bit & 7;
+	uint8_t n = (shift + height + 7) >> 3;
+	uint32_t ink = p[0];
+
+	if (n > 1) {
+		ink |= (uint32_t)p[1] << 8;
+	}
+	if (n > 2) {
+		ink |= (uint32_t)p[2] << 16;
+	}
+	if (n > 3) {
+		ink |= (uint32_t)p[3] << 24;
+	}
+	ink >>= shift;
+	if (n > 4) {
+		/* Column of more than 25 rows crosses fifth byte */
+		ink |= (uint32_t)p[4] << (32 - shift);
+	}
+	return ink;
+}
+
+/* Draws glyph at cursor and advances cursor, returns 0 when glyph does not fit */
+static uint8_t ssd1306_PutGlyph(uint16_t index, FontDef_t* Font, SSD1306_COLOR_t color) {
+	uint32_t i, j, ink, bit, mask;
+	const uint16_t* rows;
+	const uint8_t* glyph;
 
 	/* Check available space in LCD */
 	if (
-		SSD1306_WIDTH <= (SSD1306.CurrentX + Font->FontWidth) ||
-		SSD1306_HEIGHT <= (SSD1306.CurrentY + Font->FontHeight)
+		SSD1306_W < (SSD1306.CurrentX + Font->FontWidth) ||
+		SSD1306_H < (SSD1306.CurrentY + Font->FontHeight)
 	) {
 		/* Error */
 		return 0;
 	}
 
-	/* Go through font */
-	for (i = 0; i < Font->FontHeight; i++) {
-		b = Font->data[(ch - 32) * Font->FontHeight + i];
+	if (Font->packed) {
+		/* Columns are stored as they are drawn, FontHeight bits each */
+		glyph = &Font->packed[index * ((Font->FontWidth * Font->FontHeight + 7) >> 3)];
+		mask = 0xFFFFFFFFUL >> (32 - Font->FontHeight);
+		for (j = 0, bit = 0; j < Font->FontWidth; j++, bit += Font->FontHeight) {
+			ssd1306_PutColumn(SSD1306.CurrentX + j, SSD1306.CurrentY, ssd1306_PackedColumn(glyph, bit, Font->FontHeight) & mask, Font->FontHeight, color);
+		}
+	} else {
+		/* Go through font column by column */
+		rows = &Font->data[index * Font->FontHeight];
 		for (j = 0; j < Font->FontWidth; j++) {
-			if ((b << j) & 0x8000) {
-				SSD1306_DrawPixel(SSD1306.CurrentX + j, (SSD1306.CurrentY + i), (SSD1306_COLOR_t) color);
-			} else {
-				SSD1306_DrawPixel(SSD1306.CurrentX + j, (SSD1306.CurrentY + i), (SSD1306_COLOR_t)!color);
+			ink = 0;
+			for (i = 0; i < Font->FontHeight; i++) {
+				if ((rows[i] << j) & 0x8000) {
+					ink |= 1UL << i;
+				}
 			}
+			ssd1306_PutColumn(SSD1306.CurrentX + j, SSD1306.CurrentY, ink, Font->FontHeight, color);
 		}
 	}
 
 	/* Increase pointer */
 	SSD1306.CurrentX += Font->FontWidth;
 
+	return 1;
+}
+
+char SSD1306_Putc(char ch, FontDef_t* Font, SSD1306_COLOR_t color) {
+	/* Characters without glyph are drawn with fallback glyph */
+	if (!ssd1306_PutGlyph(FONTS_GetGlyph(Font, (uint8_t)ch), Font, color)) {
+		/* Error */
+		return 0;
+	}
+
 	/* Return character written */
 	return ch;
 }
 
+uint32_t SSD1306_PutcUnicode(uint32_t cp, FontDef_t* Font, SSD1306_COLOR_t color) {
+	if (!ssd1306_PutGlyph(FONTS_GetGlyph(Font, cp), Font, color)) {
+		/* Error */
+		return 0;
+	}
+
+	/* Return code point written */
+	return cp;
+}
+
 char SSD1306_Puts(char* str, FontDef_t* Font, SSD1306_COLOR_t color) {
 	/* Write characters */
 	while (*str) {
@@ -216,22 +951,24 @@ char SSD1306_Puts(char* str, FontDef_t* Font, SSD1306_COLOR_t color) {
 }
 
 
-void SSD1306_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, SSD1306_COLOR_t c) {
-	int16_t dx, dy, sx, sy, err, e2, i, tmp;
-
-	/* Check for overflow */
-	if (x0 >= SSD1306_WIDTH) {
-		x0 = SSD1306_WIDTH - 1;
-	}
-	if (x1 >= SSD1306_WIDTH) {
-		x1 = SSD1306_WIDTH - 1;
+/* Clamps line end points to screen the way lines always did */
+static void ssd1306_ClampPoint(uint16_t* x, uint16_t* y) {
+	if (*x >= SSD1306_W) {
+		*x = SSD1306_W - 1;
 	}
-	if (y0 >= SSD1306_HEIGHT) {
-		y0 = SSD1306_HEIGHT - 1;
-	}
-	if (y1 >= SSD1306_HEIGHT) {
-		y1 = SSD1306_HEIGHT - 1;
+	if (*y >= SSD1306_H) {
+		*y = SSD1306_H - 1;
 	}
+}
+
+/* Bresenham line with resolved operation, end point is left out when last is 0 so that
+ * connected lines do not toggle shared points twice */
+static void ssd1306_Line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, SSD1306_ROP_t op, uint8_t last) {
+	int16_t dx, dy, sx, sy, err, e2;
+
+	/* Check for overflow */
+	ssd1306_ClampPoint(&x0, &y0);
+	ssd1306_ClampPoint(&x1, &y1);
 
 	dx = (x0 < x1) ? (x1 - x0) : (x0 - x1);
 	dy = (y0 < y1) ? (y1 - y0) : (y0 - y1);
@@ -240,54 +977,28 @@ void SSD1306_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, SSD130
 	err = ((dx > dy) ? dx : -dy) / 2;
 
 	if (dx == 0) {
-		if (y1 < y0) {
-			tmp = y1;
-			y1 = y0;
-			y0 = tmp;
-		}
-
-		if (x1 < x0) {
-			tmp = x1;
-			x1 = x0;
-			x0 = tmp;
-		}
-
-		/* Vertical line */
-		for (i = y0; i <= y1; i++) {
-			SSD1306_DrawPixel(x0, i, c);
-		}
-
-		/* Return from function */
-		return;
-	}
-
-	if (dy == 0) {
-		if (y1 < y0) {
-			tmp = y1;
-			y1 = y0;
-			y0 = tmp;
+		if (!last) {
+			if (dy == 0) {
+				return;
+			}
+			y1 -= sy;
 		}
 
-		if (x1 < x0) {
-			tmp = x1;
-			x1 = x0;
-			x0 = tmp;
-		}
-
-		/* Horizontal line */
-		for (i = x0; i <= x1; i++) {
-			SSD1306_DrawPixel(i, y0, c);
-		}
+		/* Vertical line, whole page bytes at a time */
+		ssd1306_FillColumn(x0, y0 < y1 ? y0 : y1, y0 < y1 ? y1 : y0, 0xFF, op);
 
 		/* Return from function */
 		return;
 	}
 
 	while (1) {
-		SSD1306_DrawPixel(x0, y0, c);
 		if (x0 == x1 && y0 == y1) {
+			if (last) {
+				ssd1306_Plot(x0, y0, op);
+			}
 			break;
 		}
+		ssd1306_Plot(x0, y0, op);
 		e2 = err;
 		if (e2 > -dx) {
 			err -= dy;
@@ -300,119 +1011,200 @@ void SSD1306_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, SSD130
 	}
 }
 
+void SSD1306_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, SSD1306_COLOR_t c) {
+	SSD1306_ROP_t op;
+
+	if (ssd1306_InkOp(c, &op)) {
+		ssd1306_Line(x0, y0, x1, y1, op, 1);
+	}
+}
+
 void SSD1306_DrawRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, SSD1306_COLOR_t c) {
+	uint16_t x1, y1;
+	SSD1306_ROP_t op;
+
 	/* Check input parameters */
 	if (
-		x >= SSD1306_WIDTH ||
-		y >= SSD1306_HEIGHT
+		x >= SSD1306_W ||
+		y >= SSD1306_H
 	) {
 		/* Return error */
 		return;
 	}
+	if (!ssd1306_InkOp(c, &op)) {
+		return;
+	}
 
 	/* Check width and height */
-	if ((x + w) >= SSD1306_WIDTH) {
-		w = SSD1306_WIDTH - x;
+	x1 = x + w;
+	y1 = y + h;
+	ssd1306_ClampPoint(&x1, &y1);
+
+	/* Every pixel once, corners belong to top and bottom lines */
+	ssd1306_Line(x, y, x1, y, op, 1);             /* Top line */
+	if (y1 != y) {
+		ssd1306_Line(x, y1, x1, y1, op, 1);       /* Bottom line */
 	}
-	if ((y + h) >= SSD1306_HEIGHT) {
-		h = SSD1306_HEIGHT - y;
+	if (y1 - y > 1) {
+		ssd1306_FillColumn(x, y + 1, y1 - 1, 0xFF, op);      /* Left line */
+		if (x1 != x) {
+			ssd1306_FillColumn(x1, y + 1, y1 - 1, 0xFF, op); /* Right line */
+		}
 	}
-
-	/* Draw 4 lines */
-	SSD1306_DrawLine(x, y, x + w, y, c);         /* Top line */
-	SSD1306_DrawLine(x, y + h, x + w, y + h, c); /* Bottom line */
-	SSD1306_DrawLine(x, y, x, y + h, c);         /* Left line */
-	SSD1306_DrawLine(x + w, y, x + w, y + h, c); /* Right line */
 }
 
 void SSD1306_DrawFilledRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, SSD1306_COLOR_t c) {
-	uint8_t i;
+	SSD1306_ROP_t op;
 
 	/* Check input parameters */
 	if (
-		x >= SSD1306_WIDTH ||
-		y >= SSD1306_HEIGHT
+		x >= SSD1306_W ||
+		y >= SSD1306_H
 	) {
 		/* Return error */
 		return;
 	}
 
-	/* Check width and height */
-	if ((x + w) >= SSD1306_WIDTH) {
-		w = SSD1306_WIDTH - x;
-	}
-	if ((y + h) >= SSD1306_HEIGHT) {
-		h = SSD1306_HEIGHT - y;
+	/* Fill column by column */
+	if (ssd1306_InkOp(c, &op)) {
+		ssd1306_FillRect(x, y, x + w, y + h, ssd1306_Solid[1], op);
 	}
+}
+
+/* Widens column spans of filled triangle by pixels of one edge, same pixels as @ref ssd1306_Line */
+static void ssd1306_EdgeSpans(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t xmin, uint8_t* top, uint8_t* bottom) {
+	int16_t dx, dy, sx, sy, err, e2;
+
+	ssd1306_ClampPoint(&x0, &y0);
+	ssd1306_ClampPoint(&x1, &y1);
 
-	/* Draw lines */
-	for (i = 0; i <= h; i++) {
-		/* Draw lines */
-		SSD1306_DrawLine(x, y + i, x + w, y + i, c);
+	dx = (x0 < x1) ? (x1 - x0) : (x0 - x1);
+	dy = (y0 < y1) ? (y1 - y0) : (y0 - y1);
+	sx = (x0 < x1) ? 1 : -1;
+	sy = (y0 < y1) ? 1 : -1;
+	err = ((dx > dy) ? dx : -dy) / 2;
+
+	while (1) {
+		if (y0 < top[x0 - xmin]) {
+			top[x0 - xmin] = y0;
+		}
+		if (y0 > bottom[x0 - xmin]) {
+			bottom[x0 - xmin] = y0;
+		}
+		if (x0 == x1 && y0 == y1) {
+			break;
+		}
+		e2 = err;
+		if (e2 > -dx) {
+			err -= dy;
+			x0 += sx;
+		}
+		if (e2 < dy) {
+			err += dx;
+			y0 += sy;
+		}
 	}
 }
 
-void SSD1306_DrawTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, SSD1306_COLOR_t color) {
-	/* Draw lines */
-	SSD1306_DrawLine(x1, y1, x2, y2, color);
-	SSD1306_DrawLine(x2, y2, x3, y3, color);
-	SSD1306_DrawLine(x3, y3, x1, y1, color);
+/* XOR outline, edges meet near corners and along thin triangles. Each edge has one run of
+ * pixels per column, so union of the three runs toggles every pixel once */
+static void ssd1306_TriangleXor(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3) {
+	uint8_t top[3][SSD1306_WIDTH > SSD1306_HEIGHT ? SSD1306_WIDTH : SSD1306_HEIGHT];
+	uint8_t bottom[3][sizeof(top[0])];
+	uint8_t t[3], b[3], i, j, n;
+	uint16_t xmin, xmax, x;
+
+	/* Columns of clamped corners */
+	xmin = xmax = x1 < SSD1306_W ? x1 : SSD1306_W - 1;
+	x = x2 < SSD1306_W ? x2 : SSD1306_W - 1;
+	xmin = x < xmin ? x : xmin;
+	xmax = x > xmax ? x : xmax;
+	x = x3 < SSD1306_W ? x3 : SSD1306_W - 1;
+	xmin = x < xmin ? x : xmin;
+	xmax = x > xmax ? x : xmax;
+
+	for (i = 0; i < 3; i++) {
+		memset(top[i], 0xFF, xmax - xmin + 1);
+		memset(bottom[i], 0x00, xmax - xmin + 1);
+	}
+	ssd1306_EdgeSpans(x1, y1, x2, y2, xmin, top[0], bottom[0]);
+	ssd1306_EdgeSpans(x2, y2, x3, y3, xmin, top[1], bottom[1]);
+	ssd1306_EdgeSpans(x3, y3, x1, y1, xmin, top[2], bottom[2]);
+
+	for (x = xmin; x <= xmax; x++) {
+		/* Runs of this column sorted by top, empty runs have top above bottom */
+		for (i = n = 0; i < 3; i++) {
+			if (top[i][x - xmin] > bottom[i][x - xmin]) {
+				continue;
+			}
+			for (j = n++; j > 0 && t[j - 1] > top[i][x - xmin]; j--) {
+				t[j] = t[j - 1];
+				b[j] = b[j - 1];
+			}
+			t[j] = top[i][x - xmin];
+			b[j] = bottom[i][x - xmin];
+		}
+
+		/* Merge overlapping and touching runs */
+		for (i = 0; i < n; i = j) {
+			for (j = i + 1; j < n && t[j] <= b[i] + 1; j++) {
+				b[i] = b[j] > b[i] ? b[j] : b[i];
+			}
+			ssd1306_FillColumn(x, t[i], b[i], 0xFF, SSD1306_ROP_XOR);
+		}
+	}
 }
 
+void SSD1306_DrawTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, SSD1306_COLOR_t color) {
+	SSD1306_ROP_t op;
 
-void SSD1306_DrawFilledTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, SSD1306_COLOR_t color) {
-	int16_t deltax = 0, deltay = 0, x = 0, y = 0, xinc1 = 0, xinc2 = 0,
-	yinc1 = 0, yinc2 = 0, den = 0, num = 0, numadd = 0, numpixels = 0,
-	curpixel = 0;
-
-	deltax = ABS(x2 - x1);
-	deltay = ABS(y2 - y1);
-	x = x1;
-	y = y1;
-
-	if (x2 >= x1) {
-		xinc1 = 1;
-		xinc2 = 1;
-	} else {
-		xinc1 = -1;
-		xinc2 = -1;
+	if (!ssd1306_InkOp(color, &op)) {
+		return;
 	}
 
-	if (y2 >= y1) {
-		yinc1 = 1;
-		yinc2 = 1;
-	} else {
-		yinc1 = -1;
-		yinc2 = -1;
+	if (op == SSD1306_ROP_XOR) {
+		ssd1306_TriangleXor(x1, y1, x2, y2, x3, y3);
+		return;
 	}
 
-	if (deltax >= deltay){
-		xinc1 = 0;
-		yinc2 = 0;
-		den = deltax;
-		num = deltax / 2;
-		numadd = deltay;
-		numpixels = deltax;
-	} else {
-		xinc2 = 0;
-		yinc1 = 0;
-		den = deltay;
-		num = deltay / 2;
-		numadd = deltax;
-		numpixels = deltay;
+	/* Every edge leaves out its end, which is start of the next one */
+	ssd1306_Line(x1, y1, x2, y2, op, 0);
+	ssd1306_Line(x2, y2, x3, y3, op, 0);
+	ssd1306_Line(x3, y3, x1, y1, op, 0);
+	if (x1 == x2 && x2 == x3 && y1 == y2 && y2 == y3) {
+		/* All edges are empty */
+		ssd1306_Line(x1, y1, x1, y1, op, 1);
 	}
+}
 
-	for (curpixel = 0; curpixel <= numpixels; curpixel++) {
-		SSD1306_DrawLine(x, y, x3, y3, color);
+void SSD1306_DrawFilledTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, SSD1306_COLOR_t color) {
+	uint8_t top[SSD1306_WIDTH > SSD1306_HEIGHT ? SSD1306_WIDTH : SSD1306_HEIGHT];
+	uint8_t bottom[sizeof(top)];
+	uint16_t xmin, xmax, x;
+	SSD1306_ROP_t op;
 
-		num += numadd;
-		if (num >= den) {
-			num -= den;
-			x += xinc1;
-			y += yinc1;
-		}
-		x += xinc2;
-		y += yinc2;
+	if (!ssd1306_InkOp(color, &op)) {
+		return;
+	}
+
+	/* Columns of clamped corners */
+	xmin = xmax = x1 < SSD1306_W ? x1 : SSD1306_W - 1;
+	x = x2 < SSD1306_W ? x2 : SSD1306_W - 1;
+	xmin = x < xmin ? x : xmin;
+	xmax = x > xmax ? x : xmax;
+	x = x3 < SSD1306_W ? x3 : SSD1306_W - 1;
+	xmin = x < xmin ? x : xmin;
+	xmax = x > xmax ? x : xmax;
+
+	/* Triangle is convex, every column is one span from top to bottom edge pixel */
+	memset(top, 0xFF, xmax - xmin + 1);
+	memset(bottom, 0x00, xmax - xmin + 1);
+	ssd1306_EdgeSpans(x1, y1, x2, y2, xmin, top, bottom);
+	ssd1306_EdgeSpans(x2, y2, x3, y3, xmin, top, bottom);
+	ssd1306_EdgeSpans(x3, y3, x1, y1, xmin, top, bottom);
+
+	for (x = xmin; x <= xmax; x++) {
+		ssd1306_FillColumn(x, top[x - xmin], bottom[x - xmin], 0xFF, op);
 	}
 }
 
@@ -422,11 +1214,20 @@ void SSD1306_DrawCircle(int16_t x0, int16_t y0, int16_t r, SSD1306_COLOR_t c) {
 	int16_t ddF_y = -2 * r;
 	int16_t x = 0;
 	int16_t y = r;
+	SSD1306_ROP_t op;
 
-    SSD1306_DrawPixel(x0, y0 + r, c);
-    SSD1306_DrawPixel(x0, y0 - r, c);
-    SSD1306_DrawPixel(x0 + r, y0, c);
-    SSD1306_DrawPixel(x0 - r, y0, c);
+	if (!ssd1306_InkOp(c, &op)) {
+		return;
+	}
+	if (r == 0) {
+		ssd1306_Plot(x0, y0, op);
+		return;
+	}
+
+    ssd1306_Plot(x0, y0 + r, op);
+    ssd1306_Plot(x0, y0 - r, op);
+    ssd1306_Plot(x0 + r, y0, op);
+    ssd1306_Plot(x0 - r, y0, op);
 
     while (x < y) {
         if (f >= 0) {
@@ -438,55 +1239,393 @@ void SSD1306_DrawCircle(int16_t x0, int16_t y0, int16_t r, SSD1306_COLOR_t c) {
         ddF_x += 2;
         f += ddF_x;
 
-        SSD1306_DrawPixel(x0 + x, y0 + y, c);
-        SSD1306_DrawPixel(x0 - x, y0 + y, c);
-        SSD1306_DrawPixel(x0 + x, y0 - y, c);
-        SSD1306_DrawPixel(x0 - x, y0 - y, c);
+        /* Octants meet, these points were plotted from the other side already */
+        if (x > y) {
+            break;
+        }
 
-        SSD1306_DrawPixel(x0 + y, y0 + x, c);
-        SSD1306_DrawPixel(x0 - y, y0 + x, c);
-        SSD1306_DrawPixel(x0 + y, y0 - x, c);
-        SSD1306_DrawPixel(x0 - y, y0 - x, c);
+        ssd1306_Plot(x0 + x, y0 + y, op);
+        ssd1306_Plot(x0 - x, y0 + y, op);
+        ssd1306_Plot(x0 + x, y0 - y, op);
+        ssd1306_Plot(x0 - x, y0 - y, op);
+
+        /* Diagonal points are the same in both octants */
+        if (x != y) {
+            ssd1306_Plot(x0 + y, y0 + x, op);
+            ssd1306_Plot(x0 - y, y0 + x, op);
+            ssd1306_Plot(x0 + y, y0 - x, op);
+            ssd1306_Plot(x0 - y, y0 - x, op);
+        }
     }
 }
 
 void SSD1306_DrawFilledCircle(int16_t x0, int16_t y0, int16_t r, SSD1306_COLOR_t c) {
-	int16_t f = 1 - r;
-	int16_t ddF_x = 1;
-	int16_t ddF_y = -2 * r;
-	int16_t x = 0;
-	int16_t y = r;
+	SSD1306_ROP_t op;
 
-    SSD1306_DrawPixel(x0, y0 + r, c);
-    SSD1306_DrawPixel(x0, y0 - r, c);
-    SSD1306_DrawPixel(x0 + r, y0, c);
-    SSD1306_DrawPixel(x0 - r, y0, c);
-    SSD1306_DrawLine(x0 - r, y0, x0 + r, y0, c);
+	if (ssd1306_InkOp(c, &op)) {
+		ssd1306_FillCircle(x0, y0, r, ssd1306_Solid[1], op);
+	}
+}
 
-    while (x < y) {
-        if (f >= 0) {
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
-        }
-        x++;
-        ddF_x += 2;
-        f += ddF_x;
+void SSD1306_GetPattern(uint8_t level, uint8_t* pattern) {
+	uint8_t col, row;
 
-        SSD1306_DrawLine(x0 - x, y0 + y, x0 + x, y0 + y, c);
-        SSD1306_DrawLine(x0 + x, y0 - y, x0 - x, y0 - y, c);
+	for (col = 0; col < 8; col++) {
+		pattern[col] = 0;
+		for (row = 0; row < 8; row++) {
+			if (ssd1306_Bayer[row][col] < level) {
+				pattern[col] |= 1 << row;
+			}
+		}
+	}
+}
 
-        SSD1306_DrawLine(x0 + y, y0 + x, x0 - y, y0 + x, c);
-        SSD1306_DrawLine(x0 + y, y0 - x, x0 - y, y0 - x, c);
-    }
+void SSD1306_DrawPatternRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint8_t* pattern) {
+	/* Check input parameters */
+	if (
+		x >= SSD1306_W ||
+		y >= SSD1306_H
+	) {
+		/* Return error */
+		return;
+	}
+
+	ssd1306_FillRect(x, y, x + w, y + h, pattern, SSD1306_ROP_COPY);
+}
+
+void SSD1306_DrawPatternCircle(int16_t x0, int16_t y0, int16_t r, const uint8_t* pattern) {
+	ssd1306_FillCircle(x0, y0, r, pattern, SSD1306_ROP_COPY);
+}
+
+/* Fills polygon column by column, every pixel once */
+static void ssd1306_FillPolygon(const SSD1306_POINT_t* points, uint8_t count, const uint8_t* pattern, SSD1306_ROP_t op) {
+	int32_t cross[SSD1306_POLYGON_MAX];
+	int32_t yy;
+	int16_t x, xmin, xmax;
+	uint8_t i, j, n;
+	const SSD1306_POINT_t *a, *b;
+
+	if (count < 3 || count > SSD1306_POLYGON_MAX) {
+		/* Error */
+		return;
+	}
+
+	/* Horizontal extent, clipped to screen */
+	xmin = xmax = points[0].x;
+	for (i = 1; i < count; i++) {
+		if (points[i].x < xmin) {
+			xmin = points[i].x;
+		}
+		if (points[i].x > xmax) {
+			xmax = points[i].x;
+		}
+	}
+	if (xmin < 0) {
+		xmin = 0;
+	}
+	if (xmax > SSD1306_W) {
+		xmax = SSD1306_W;
+	}
+
+	/* Vertices are pixel corners, columns and rows are sampled in their centers */
+	for (x = xmin; x < xmax; x++) {
+		n = 0;
+		for (i = 0; i < count; i++) {
+			a = &points[i];
+			b = &points[(i + 1) % count];
+			if ((a->x <= x) == (b->x <= x)) {
+				/* Edge does not cross this column */
+				continue;
+			}
+
+			/* Crossing in 1/256 pixel, sorted in place */
+			yy = (int32_t)a->y * 256 + (int32_t)(2 * (x - a->x) + 1) * (b->y - a->y) * 128 / (b->x - a->x);
+			for (j = n++; j > 0 && cross[j - 1] > yy; j--) {
+				cross[j] = cross[j - 1];
+			}
+			cross[j] = yy;
+		}
+
+		/* Even-odd rule, rows whose centers lie between crossing pairs */
+		for (i = 0; i + 1 < n; i += 2) {
+			ssd1306_FillColumn(x, (cross[i] + 127) >> 8, ((cross[i + 1] + 127) >> 8) - 1, pattern[x & 7], op);
+		}
+	}
+}
+
+void SSD1306_DrawPatternPolygon(const SSD1306_POINT_t* points, uint8_t count, const uint8_t* pattern) {
+	ssd1306_FillPolygon(points, count, pattern, SSD1306_ROP_COPY);
+}
+
+void SSD1306_DrawFilledPolygon(const SSD1306_POINT_t* points, uint8_t count, SSD1306_COLOR_t c) {
+	SSD1306_ROP_t op;
+
+	if (ssd1306_InkOp(c, &op)) {
+		ssd1306_FillPolygon(points, count, ssd1306_Solid[1], op);
+	}
+}
+
+void SSD1306_DrawGrayOrdered(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t* gray) {
+	uint8_t inv = SSD1306.Inverted ? 0xFF : 0x00;
+	uint16_t col, row, r;
+	uint8_t bits, mask;
+	const uint8_t* px;
+
+	for (row = 0; row < h; row += 8) {
+		mask = (h - row) >= 8 ? 0xFF : (0xFF >> (8 - (h - row)));
+		for (col = 0; col < w; col++) {
+			/* Build one LCD byte, fixed work per pixel */
+			bits = 0;
+			px = &gray[row * w + col];
+			for (r = 0; r < 8 && (row + r) < h; r++, px += w) {
+				if (*px > ssd1306_Bayer[(y + row + r) & 7][(x + col) & 7] * 4 + 2) {
+					bits |= 1 << r;
+				}
+			}
+			ssd1306_BlitColumn(x + col, y + row, bits ^ inv, mask, SSD1306_ROP_COPY);
+		}
+	}
+}
+
+void SSD1306_DrawGrayDiffused(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t* gray, int16_t* err) {
+	uint8_t inv = SSD1306.Inverted ? 0xFF : 0x00;
+	int16_t *cur = err, *nxt = err + h + 2, *tmp;
+	int16_t v, e;
+	uint16_t col, row;
+	uint8_t bits = 0;
+
+	memset(err, 0, 2 * (h + 2) * sizeof(int16_t));
+
+	/* Floyd-Steinberg along columns, so LCD bytes are built in a register */
+	for (col = 0; col < w; col++) {
+		for (row = 0; row < h; row++) {
+			v = gray[row * w + col] + cur[row + 1];
+			if (v >= 128) {
+				bits |= 1 << (row % 8);
+				e = v - 255;
+			} else {
+				e = v;
+			}
+
+			/* Next pixel in column, then three neighbours in next column */
+			cur[row + 2] += (e * 7) >> 4;
+			nxt[row] += (e * 3) >> 4;
+			nxt[row + 1] += (e * 5) >> 4;
+			nxt[row + 2] += e >> 4;
+
+			if ((row % 8) == 7 || row == h - 1) {
+				ssd1306_BlitColumn(x + col, y + row - row % 8, bits ^ inv, 0xFF >> (7 - row % 8), SSD1306_ROP_COPY);
+				bits = 0;
+			}
+		}
+
+		tmp = cur;
+		cur = nxt;
+		nxt = tmp;
+		memset(nxt, 0, (h + 2) * sizeof(int16_t));
+	}
+}
+
+void SSD1306_DrawImage(uint16_t x, uint16_t y, const SSD1306_IMAGE_t* img) {
+	const uint8_t* src = img->data;
+	uint8_t pages = (img->Height + 7) / 8;
+	uint8_t inv = SSD1306.Inverted ? 0xFF : 0x00;
+	uint8_t p, n, i, v, mask, fast;
+	uint16_t col;
+
+	for (p = 0; p < pages; p++) {
+		/* Last page may be used only partially */
+		mask = (p == pages - 1 && (img->Height % 8)) ? (0xFF >> (8 - img->Height % 8)) : 0xFF;
+
+		/* Aligned and unclipped page rows are copied run by run */
+		fast = (y % 8) == 0 && mask == 0xFF && !inv &&
+			(x + img->Width) <= SSD1306_W && (y / 8 + p) < SSD1306_H / 8;
+
+		for (col = 0; col < img->Width; col += n) {
+			if (*src < 128) {
+				/* Literal run */
+				n = *src++ + 1;
+				if (fast) {
+					memcpy(&SSD1306_Buffer[x + col + (y / 8 + p) * SSD1306_W], src, n);
+				} else {
+					for (i = 0; i < n; i++) {
+						ssd1306_BlitColumn(x + col + i, y + p * 8, src[i] ^ inv, mask, SSD1306_ROP_COPY);
+					}
+				}
+				src += n;
+			} else if (*src > 128) {
+				/* Repeated byte */
+				n = 257 - *src++;
+				v = *src++;
+				if (fast) {
+					memset(&SSD1306_Buffer[x + col + (y / 8 + p) * SSD1306_W], v, n);
+				} else {
+					for (i = 0; i < n; i++) {
+						ssd1306_BlitColumn(x + col + i, y + p * 8, v ^ inv, mask, SSD1306_ROP_COPY);
+					}
+				}
+			} else {
+				/* No operation */
+				src++;
+				n = 0;
+			}
+		}
+	}
+}
+
+void SSD1306_DrawBitmap(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t* bitmap, const uint8_t* mask, SSD1306_ROP_t rop) {
+	uint8_t pages = (h + 7) / 8;
+	uint8_t p, bits, m, rowmask;
+	uint16_t col, i = 0;
+	SSD1306_ROP_t op;
+
+	for (p = 0; p < pages; p++) {
+		/* Last page may be used only partially */
+		rowmask = (p == pages - 1 && (h % 8)) ? (0xFF >> (8 - h % 8)) : 0xFF;
+
+		for (col = 0; col < w; col++, i++) {
+			bits = bitmap[i];
+			m = mask ? (mask[i] & rowmask) : rowmask;
+			op = rop;
+
+			/* Inverted LCD stores lit pixels as zeros */
+			if (SSD1306.Inverted) {
+				if (op == SSD1306_ROP_COPY) {
+					bits = ~bits;
+				} else if (op == SSD1306_ROP_OR) {
+					/* Clear stored bits instead of setting them */
+					op = SSD1306_ROP_ANDNOT;
+				} else if (op == SSD1306_ROP_ANDNOT) {
+					op = SSD1306_ROP_OR;
+				}
+			}
+
+			ssd1306_BlitColumn(x + col, y + p * 8, bits, m, op);
+		}
+	}
+}
+
+void SSD1306_ReadBitmap(int16_t x, int16_t y, uint16_t w, uint16_t h, uint8_t* bitmap) {
+	uint8_t pages = (h + 7) / 8;
+	uint8_t inv = SSD1306.Inverted ? 0xFF : 0x00;
+	uint8_t p;
+	uint16_t col;
+
+	for (p = 0; p < pages; p++) {
+		for (col = 0; col < w; col++) {
+			/* Same colors as @ref SSD1306_DrawBitmap expects */
+			*bitmap++ = ssd1306_ReadColumn(x + col, y + p * 8) ^ inv;
+		}
+	}
+}
+
+void SSD1306_StreamImage(uint16_t x, uint8_t page, const SSD1306_IMAGE_t* img) {
+	const uint8_t* src = img->data;
+	uint8_t pages = (img->Height + 7) / 8;
+	uint8_t inv = SSD1306.Inverted ? 0xFF : 0x00;
+	uint8_t p, n, i, v, literal;
+	uint8_t cmd[3];
+	uint16_t col;
+
+	if (SSD1306.Rotation & 1) {
+		/* Image is not transposed */
+		return;
+	}
+
+	for (p = 0; p < pages && (page + p) < SSD1306_HEIGHT / 8; p++) {
+		cmd[0] = 0xB0 + page + p;
+		cmd[1] = x & 0x0F;
+		cmd[2] = 0x10 | (x >> 4);
+		SSD1306_WRITECOMMANDS(cmd);
+
+		/* Decoded bytes go straight to the bus */
+		SSD1306_Transport_Begin();
+		for (col = 0; col < img->Width; col += n) {
+			literal = *src < 128;
+			if (literal) {
+				n = *src++ + 1;
+			} else if (*src > 128) {
+				n = 257 - *src++;
+			} else {
+				src++;
+				n = 0;
+				continue;
+			}
+			for (i = 0; i < n; i++) {
+				v = literal ? *src++ : *src;
+				if ((x + col + i) < SSD1306_WIDTH) {
+					SSD1306_Transport_Put(v ^ inv);
+				}
+			}
+			if (!literal) {
+				src++;
+			}
+		}
+		SSD1306_Transport_End();
+	}
+}
+
+void SSD1306_ScrollLeft(uint16_t x, uint8_t page, uint16_t w, uint8_t pages) {
+	uint8_t inv = SSD1306.Inverted ? 0xFF : 0x00;
+	uint8_t cmd[7];
+	uint8_t* p;
+	uint8_t m;
+
+	/* Check input parameters */
+	if (
+		x >= SSD1306_W ||
+		page >= SSD1306_H / 8 ||
+		w < 2 || !pages
+	) {
+		/* Error */
+		return;
+	}
+	if ((x + w) > SSD1306_W) {
+		w = SSD1306_W - x;
+	}
+	if ((page + pages) > SSD1306_H / 8) {
+		pages = SSD1306_H / 8 - page;
+	}
+
+	/* Shift STM buffer, new right column is cleared */
+	for (m = page; m < page + pages; m++) {
+		p = &SSD1306_Buffer[x + m * SSD1306_W];
+		memmove(p, p + 1, w - 1);
+		p[w - 1] = inv;
+	}
+
+	if (SSD1306.Rotation & 1) {
+		/* LCD pages are buffer columns in portrait, whole area has to be sent */
+		SSD1306_MarkDirty(x, page * 8, w, pages * 8);
+		return;
+	}
+
+	/* Same shift inside LCD memory */
+	cmd[0] = SSD1306_SCROLL_LEFT_CMD;
+	cmd[1] = 0x00;
+	cmd[2] = page;
+	cmd[3] = 0x01;
+	cmd[4] = page + pages - 1;
+	cmd[5] = x;
+	cmd[6] = x + w - 1;
+	SSD1306_WRITECOMMANDS(cmd);
+
+	/* Pending changes moved one column to the left together with the pixels */
+	for (m = page; m < page + pages; m++) {
+		if (
+			SSD1306_DirtyFirst[m] <= SSD1306_DirtyLast[m] &&
+			SSD1306_DirtyFirst[m] > x && SSD1306_DirtyFirst[m] < x + w
+		) {
+			SSD1306_DirtyFirst[m]--;
+		}
+	}
+	SSD1306_MarkDirty(x + w - 1, page * 8, 1, pages * 8);
 }
 
 void SSD1306_ON(void) {
-	SSD1306_WRITECOMMAND(0x8D);
-	SSD1306_WRITECOMMAND(0x14);
-	SSD1306_WRITECOMMAND(0xAF);
+	static const uint8_t on[] = {0x8D, 0x14, 0xAF};
+	SSD1306_WRITECOMMANDS(on);
 }
 void SSD1306_OFF(void) {
-	SSD1306_WRITECOMMAND(0x8D);
-	SSD1306_WRITECOMMAND(0x10);
-	SSD1306_WRITECOMMAND(0xAE);  }
+	static const uint8_t off[] = {0x8D, 0x10, 0xAE};
+	SSD1306_WRITECOMMANDS(off);  }
@@ -11,7 +11,7 @@
 
 
 /**
- * This SSD1306 LCD uses I2C for communication
+ * This SSD1306 LCD uses I2C or SPI for communication, see ssd1306_transport.h
  *
  * Library features functions for drawing lines, rectangles and circles.
  *
@@ -27,23 +27,12 @@ SDA        |PB7          |Serial data line
  */
 
 #include "stm32f1xx.h"
-#include "ssd1306_i2c.h"
+#include "ssd1306_transport.h"
 #include "fonts.h"
 #include "stdlib.h"
 #include "string.h"
 
 
-/* I2C settings */
-#ifndef SSD1306_I2C
-#define SSD1306_I2C              I2C1
-#endif
-
-/* I2C address */
-#ifndef SSD1306_I2C_ADDR
-#define SSD1306_I2C_ADDR         0x78
-//#define SSD1306_I2C_ADDR       0x7A
-#endif
-
 /* SSD1306 settings */
 /* SSD1306 width in pixels */
 #ifndef SSD1306_WIDTH
@@ -53,6 +42,22 @@ SDA        |PB7          |Serial data line
 #ifndef SSD1306_HEIGHT
 #define SSD1306_HEIGHT           64
 #endif
+/* Minimum time between two presents in milliseconds, see @ref SSD1306_Present */
+#ifndef SSD1306_PRESENT_INTERVAL
+#define SSD1306_PRESENT_INTERVAL 40
+#endif
+/* Content scroll command which moves LCD memory one column towards column 0, see @ref SSD1306_ScrollLeft */
+#ifndef SSD1306_SCROLL_LEFT_CMD
+#define SSD1306_SCROLL_LEFT_CMD  0x2D
+#endif
+/* Maximum number of polygon vertices */
+#ifndef SSD1306_POLYGON_MAX
+#define SSD1306_POLYGON_MAX      16
+#endif
+/* Flush timing and transport counters, 1 to enable, see @ref SSD1306_GetFlushStats */
+#ifndef SSD1306_STATS_ENABLE
+#define SSD1306_STATS_ENABLE     0
+#endif
 
 /**
  * @brief  SSD1306 color enumeration
@@ -62,6 +67,94 @@ typedef enum {
 	SSD1306_COLOR_WHITE = 0x01  /*!< Pixel is set. Color depends on LCD */
 } SSD1306_COLOR_t;
 
+/**
+ * @brief  Text rendering modes
+ */
+typedef enum {
+	SSD1306_TEXTMODE_OPAQUE = 0x00, /*!< Glyph background is drawn with the opposite color (default) */
+	SSD1306_TEXTMODE_TRANSPARENT    /*!< Only glyph pixels are drawn, background stays untouched */
+} SSD1306_TEXTMODE_t;
+
+/**
+ * @brief  Display rotations
+ * @note   180 degrees is done by LCD itself. In 90 and 270 degrees rotations drawing area is SSD1306_HEIGHT wide
+ *         and SSD1306_WIDTH high, buffer is kept in portrait layout and transposed 8x8 pixels at a time while it is sent
+ */
+typedef enum {
+	SSD1306_ROTATION_0 = 0x00, /*!< Landscape, default */
+	SSD1306_ROTATION_90,       /*!< Portrait, rotated clockwise */
+	SSD1306_ROTATION_180,      /*!< Landscape, upside down */
+	SSD1306_ROTATION_270       /*!< Portrait, rotated counter clockwise */
+} SSD1306_ROTATION_t;
+
+/**
+ * @brief  Point on LCD, may lie outside of the screen
+ */
+typedef struct {
+	int16_t x;  /*!< X location */
+	int16_t y;  /*!< Y location */
+} SSD1306_POINT_t;
+
+/**
+ * @brief  Point generator for @ref SSD1306_DrawPixelsFrom
+ * @param  *context: User context passed to @ref SSD1306_DrawPixelsFrom
+ * @param  *points: Array to fill with next points
+ * @param  max: Size of points array
+ * @retval Number of points filled, 0 when there are no more points
+ */
+typedef uint16_t (*SSD1306_POINT_GENERATOR_t)(void* context, SSD1306_POINT_t* points, uint16_t max);
+
+/**
+ * @brief  Raster operations for bitmap drawing and, through @ref SSD1306_SetRop, for solid primitives and glyphs
+ */
+typedef enum {
+	SSD1306_ROP_COPY = 0x00, /*!< Bitmap pixels replace LCD pixels */
+	SSD1306_ROP_OR,          /*!< Only set bitmap pixels are drawn, rest is transparent */
+	SSD1306_ROP_XOR,         /*!< Set bitmap pixels toggle LCD pixels, drawing twice restores background */
+	SSD1306_ROP_ANDNOT       /*!< Set bitmap pixels clear LCD pixels, rest is transparent */
+} SSD1306_ROP_t;
+
+/**
+ * @brief  Present governor statistics
+ */
+typedef struct {
+	uint32_t Invalidated;  /*!< Calls to @ref SSD1306_Invalidate */
+	uint32_t Merged;       /*!< Invalidations merged into a frame that was already pending */
+	uint32_t Dropped;      /*!< Present requests postponed because interval did not elapse yet */
+	uint32_t Presented;    /*!< Frames actually sent to LCD */
+	uint32_t Bytes;        /*!< Data bytes sent by presented frames */
+} SSD1306_PRESENT_STATS_t;
+
+/**
+ * @brief  Flush statistics, times are in clock cycles
+ * @note   A flush is one call to @ref SSD1306_UpdateScreen or @ref SSD1306_UpdateDirty,
+ *         or all calls of @ref SSD1306_UpdateDirtyAsync until it returns 1.
+ *         Render time is counted from the end of previous flush to the start of this one,
+ *         transmit time is the flush itself
+ */
+typedef struct {
+	uint32_t Flushes;         /*!< Flushes done */
+	uint32_t Bursts;          /*!< Command and data bursts handed to transport by flushes */
+	uint32_t Bytes;           /*!< Command and data bytes sent by flushes */
+	uint32_t RenderCycles;    /*!< Total render time */
+	uint32_t TransmitCycles;  /*!< Total transmit time */
+	uint32_t LastRender;      /*!< Render time before last flush */
+	uint32_t LastTransmit;    /*!< Transmit time of last flush */
+	uint32_t MaxTransmit;     /*!< Longest flush */
+} SSD1306_FLUSH_STATS_t;
+
+/**
+ * @brief  Compressed image structure
+ * @note   Pixels are stored page-major like the LCD memory: one byte holds 8 vertical pixels (LSB on top),
+ *         bytes run left to right, pages top to bottom. Every page row is compressed on its own with PackBits,
+ *         so no run crosses a page. Use tools/ssd1306_imgconv.c to generate images from PBM files.
+ */
+typedef struct {
+	uint16_t Width;       /*!< Image width in pixels */
+	uint16_t Height;      /*!< Image height in pixels */
+	const uint8_t *data;  /*!< PackBits compressed page rows */
+} SSD1306_IMAGE_t;
+
 
 
 /**
@@ -81,6 +174,93 @@ uint8_t SSD1306_Init(void);
  */
 void SSD1306_UpdateScreen(void);
 
+/**
+ * @brief  Marks area of internal RAM as changed
+ * @note   Area is clipped to the screen and merged with areas marked before per page of 8 rows
+ * @param  x: Top left X location, may be negative
+ * @param  y: Top left Y location, may be negative
+ * @param  w: Area width in units of pixels
+ * @param  h: Area height in units of pixels
+ * @retval None
+ */
+void SSD1306_MarkDirty(int16_t x, int16_t y, uint16_t w, uint16_t h);
+
+/**
+ * @brief  Updates only marked columns of every page from internal RAM to LCD
+ * @note   Marks are cleared afterwards. @ref SSD1306_UpdateScreen() clears them as well
+ * @param  None
+ * @retval None
+ */
+void SSD1306_UpdateDirty(void);
+
+/**
+ * @brief  Sends marked columns like @ref SSD1306_UpdateDirty without waiting for the bus
+ * @note   Every call starts sending the next marked page in background and returns. Call it again,
+ *         from a task of Async_Interface.h for example, until it returns 1. Sent pages are unmarked,
+ *         areas marked in between are sent by the next flush. Buffer should not be drawn to
+ *         while it returns 0 unless tearing is fine
+ * @param  None
+ * @retval 1 when all marked pages are on LCD, 0 while pages are still being sent
+ */
+uint8_t SSD1306_UpdateDirtyAsync(void);
+
+/**
+ * @brief  Marks area as changed for the next @ref SSD1306_Present
+ * @note   Any task may call it after drawing, all areas are merged until they are presented
+ * @param  x: Top left X location, may be negative
+ * @param  y: Top left Y location, may be negative
+ * @param  w: Area width in units of pixels
+ * @param  h: Area height in units of pixels
+ * @retval None
+ */
+void SSD1306_Invalidate(int16_t x, int16_t y, uint16_t w, uint16_t h);
+
+/**
+ * @brief  Sets minimum time between two presented frames
+ * @param  ms: Interval in milliseconds, default is SSD1306_PRESENT_INTERVAL
+ * @retval None
+ */
+void SSD1306_SetPresentInterval(uint32_t ms);
+
+/**
+ * @brief  Sends all invalidated areas if present interval elapsed since last frame
+ * @note   Call it periodically from main loop instead of @ref SSD1306_UpdateScreen().
+ *         Requests that come too early keep their areas pending, so they are sent with the next frame
+ * @param  now_ms: Current time in milliseconds, may wrap around
+ * @retval 1 when frame was sent, 0 otherwise
+ */
+uint8_t SSD1306_Present(uint32_t now_ms);
+
+/**
+ * @brief  Gets present governor statistics
+ * @param  *stats: Pointer to @ref SSD1306_PRESENT_STATS_t structure to fill
+ * @retval None
+ */
+void SSD1306_GetPresentStats(SSD1306_PRESENT_STATS_t* stats);
+
+/**
+ * @brief  Gets flush statistics
+ * @note   All counters stay zero unless SSD1306_STATS_ENABLE is 1
+ * @param  *stats: Pointer to @ref SSD1306_FLUSH_STATS_t structure to fill
+ * @retval None
+ */
+void SSD1306_GetFlushStats(SSD1306_FLUSH_STATS_t* stats);
+
+/**
+ * @brief  Sets all flush statistics to zero
+ * @param  None
+ * @retval None
+ */
+void SSD1306_ResetFlushStats(void);
+
+/**
+ * @brief  Replaces DWT cycle counter as time source of flush statistics, for host builds
+ * @note   Call it before @ref SSD1306_Init, which enables DWT only when it is the time source
+ * @param  clock: Function returning free running cycle count, NULL selects DWT again
+ * @retval None
+ */
+void SSD1306_SetStatsClock(uint32_t (*clock)(void));
+
 /**
  * @brief  Toggles pixels invertion inside internal RAM
  * @note   @ref SSD1306_UpdateScreen() must be called after that in order to see updated LCD screen
@@ -89,6 +269,29 @@ void SSD1306_UpdateScreen(void);
  */
 void SSD1306_ToggleInvert(void);
 
+/**
+ * @brief  Sets display rotation
+ * @note   Buffer is cleared when switching between landscape and portrait, whole LCD is marked dirty.
+ *         All drawing coordinates are rotated ones, use @ref SSD1306_GetWidth and @ref SSD1306_GetHeight for drawing area size
+ * @param  rotation: Rotation. This parameter can be a value of @ref SSD1306_ROTATION_t enumeration
+ * @retval None
+ */
+void SSD1306_SetRotation(SSD1306_ROTATION_t rotation);
+
+/**
+ * @brief  Gets width of drawing area in current rotation
+ * @param  None
+ * @retval Width in pixels
+ */
+uint16_t SSD1306_GetWidth(void);
+
+/**
+ * @brief  Gets height of drawing area in current rotation
+ * @param  None
+ * @retval Height in pixels
+ */
+uint16_t SSD1306_GetHeight(void);
+
 /**
  * @brief  Fills entire LCD with desired color
  * @note   @ref SSD1306_UpdateScreen() must be called after that in order to see updated LCD screen
@@ -107,6 +310,26 @@ void SSD1306_Fill(SSD1306_COLOR_t Color);
  */
 void SSD1306_DrawPixel(uint16_t x, uint16_t y, SSD1306_COLOR_t color);
 
+/**
+ * @brief  Draws many pixels of one color
+ * @note   Color and inversion are resolved once for all points, every point costs one unsigned compare
+ *         per coordinate and one read-modify-write of its LCD byte. Points outside of the screen are skipped
+ * @param  *points: Array of @ref SSD1306_POINT_t points
+ * @param  count: Number of points
+ * @param  color: Color used for drawing. This parameter can be a value of @ref SSD1306_COLOR_t enumeration
+ * @retval None
+ */
+void SSD1306_DrawPixels(const SSD1306_POINT_t* points, uint16_t count, SSD1306_COLOR_t color);
+
+/**
+ * @brief  Draws pixels of one color produced by generator, points are fetched in blocks
+ * @param  generator: Function which fills blocks of points, see @ref SSD1306_POINT_GENERATOR_t
+ * @param  *context: User context passed to generator
+ * @param  color: Color used for drawing. This parameter can be a value of @ref SSD1306_COLOR_t enumeration
+ * @retval None
+ */
+void SSD1306_DrawPixelsFrom(SSD1306_POINT_GENERATOR_t generator, void* context, SSD1306_COLOR_t color);
+
 /**
  * @brief  Sets cursor pointer to desired location for strings
  * @param  x: X location. This parameter can be a value between 0 and SSD1306_WIDTH - 1
@@ -115,9 +338,37 @@ void SSD1306_DrawPixel(uint16_t x, uint16_t y, SSD1306_COLOR_t color);
  */
 void SSD1306_GotoXY(uint16_t x, uint16_t y);
 
+/**
+ * @brief  Gets current cursor location, characters advance it
+ * @param  *x: Pointer where X location is saved
+ * @param  *y: Pointer where Y location is saved
+ * @retval None
+ */
+void SSD1306_GetXY(uint16_t* x, uint16_t* y);
+
+/**
+ * @brief  Sets how characters are drawn by @ref SSD1306_Putc and @ref SSD1306_Puts
+ * @param  mode: Text mode. This parameter can be a value of @ref SSD1306_TEXTMODE_t enumeration
+ * @retval None
+ */
+void SSD1306_SetTextMode(SSD1306_TEXTMODE_t mode);
+
+/**
+ * @brief  Sets how pixels, lines, outlines, solid fills and glyphs are combined with LCD pixels
+ * @note   SSD1306_ROP_COPY draws with given color as always. Other modes draw white ink only:
+ *         SSD1306_ROP_OR sets pixels, SSD1306_ROP_XOR toggles them and SSD1306_ROP_ANDNOT
+ *         clears them, and shapes drawn in black draw nothing. Every pixel of a shape is touched
+ *         once, so XOR drawing a shape twice restores background. Pattern, gray and image fills
+ *         always copy, bitmaps take their own operation
+ * @param  rop: Raster operation. This parameter can be a value of @ref SSD1306_ROP_t enumeration
+ * @retval Previous raster operation
+ */
+SSD1306_ROP_t SSD1306_SetRop(SSD1306_ROP_t rop);
+
 /**
  * @brief  Puts character to internal RAM
- * @note   @ref SSD1306_UpdateScreen() must be called after that in order to see updated LCD screen
+ * @note   @ref SSD1306_UpdateScreen() must be called after that in order to see updated LCD screen.
+ *         Character which font has no glyph for is drawn with fallback glyph of font
  * @param  ch: Character to be written
  * @param  *Font: Pointer to @ref FontDef_t structure with used font
  * @param  color: Color used for drawing. This parameter can be a value of @ref SSD1306_COLOR_t enumeration
@@ -125,6 +376,17 @@ void SSD1306_GotoXY(uint16_t x, uint16_t y);
  */
 char SSD1306_Putc(char ch, FontDef_t* Font, SSD1306_COLOR_t color);
 
+/**
+ * @brief  Puts Unicode character to internal RAM
+ * @note   @ref SSD1306_UpdateScreen() must be called after that in order to see updated LCD screen.
+ *         Code point which font has no glyph for is drawn with fallback glyph of font, see @ref FontDef_t
+ * @param  cp: Unicode code point to be written
+ * @param  *Font: Pointer to @ref FontDef_t structure with used font
+ * @param  color: Color used for drawing. This parameter can be a value of @ref SSD1306_COLOR_t enumeration
+ * @retval Code point written, 0 when there is no space left on LCD
+ */
+uint32_t SSD1306_PutcUnicode(uint32_t cp, FontDef_t* Font, SSD1306_COLOR_t color);
+
 /**
  * @brief  Puts string to internal RAM
  * @note   @ref SSD1306_UpdateScreen() must be called after that in order to see updated LCD screen
@@ -174,6 +436,8 @@ void SSD1306_DrawFilledRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
 /**
  * @brief  Draws triangle on LCD
  * @note   @ref SSD1306_UpdateScreen() must be called after that in order to see updated LCD screen
+ * @note   With SSD1306_ROP_XOR edges are merged column by column so pixels shared by edges toggle
+ *         once, this takes 6 * max(SSD1306_WIDTH, SSD1306_HEIGHT) bytes of stack
  * @param  x1: First coordinate X location. Valid input is 0 to SSD1306_WIDTH - 1
  * @param  y1: First coordinate Y location. Valid input is 0 to SSD1306_HEIGHT - 1
  * @param  x2: Second coordinate X location. Valid input is 0 to SSD1306_WIDTH - 1
@@ -185,6 +449,20 @@ void SSD1306_DrawFilledRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
  */
 void SSD1306_DrawTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, SSD1306_COLOR_t color);
 
+/**
+ * @brief  Draws filled triangle on LCD
+ * @note   @ref SSD1306_UpdateScreen() must be called after that in order to see updated LCD screen
+ * @param  x1: First coordinate X location. Valid input is 0 to SSD1306_WIDTH - 1
+ * @param  y1: First coordinate Y location. Valid input is 0 to SSD1306_HEIGHT - 1
+ * @param  x2: Second coordinate X location. Valid input is 0 to SSD1306_WIDTH - 1
+ * @param  y2: Second coordinate Y location. Valid input is 0 to SSD1306_HEIGHT - 1
+ * @param  x3: Third coordinate X location. Valid input is 0 to SSD1306_WIDTH - 1
+ * @param  y3: Third coordinate Y location. Valid input is 0 to SSD1306_HEIGHT - 1
+ * @param  c: Color to be used. This parameter can be a value of @ref SSD1306_COLOR_t enumeration
+ * @retval None
+ */
+void SSD1306_DrawFilledTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, SSD1306_COLOR_t color);
+
 /**
  * @brief  Draws circle to STM buffer
  * @note   @ref SSD1306_UpdateScreen() must be called after that in order to see updated LCD screen
@@ -207,6 +485,148 @@ void SSD1306_DrawCircle(int16_t x0, int16_t y0, int16_t r, SSD1306_COLOR_t c);
  */
 void SSD1306_DrawFilledCircle(int16_t x0, int16_t y0, int16_t r, SSD1306_COLOR_t c);
 
+/**
+ * @brief  Builds 8x8 ordered dither pattern for shaded fills
+ * @note   Pattern is 8 LCD bytes, one per column (x & 7), so fills write whole page bytes
+ * @param  level: Shade level, 0 (black) to 64 (white)
+ * @param  *pattern: Pointer to 8 bytes where pattern will be saved
+ * @retval None
+ */
+void SSD1306_GetPattern(uint8_t level, uint8_t* pattern);
 
+/**
+ * @brief  Draws rectangle filled with 8x8 pattern
+ * @note   @ref SSD1306_UpdateScreen() must be called after that in order to see updated LCD screen
+ * @param  x: Top left X start point. Valid input is 0 to SSD1306_WIDTH - 1
+ * @param  y: Top left Y start point. Valid input is 0 to SSD1306_HEIGHT - 1
+ * @param  w: Rectangle width in units of pixels
+ * @param  h: Rectangle height in units of pixels
+ * @param  *pattern: Pointer to 8 byte pattern, see @ref SSD1306_GetPattern
+ * @retval None
+ */
+void SSD1306_DrawPatternRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint8_t* pattern);
+
+/**
+ * @brief  Draws circle filled with 8x8 pattern
+ * @note   @ref SSD1306_UpdateScreen() must be called after that in order to see updated LCD screen
+ * @param  x0: X location for center of circle
+ * @param  y0: Y location for center of circle
+ * @param  r: Circle radius in units of pixels
+ * @param  *pattern: Pointer to 8 byte pattern, see @ref SSD1306_GetPattern
+ * @retval None
+ */
+void SSD1306_DrawPatternCircle(int16_t x0, int16_t y0, int16_t r, const uint8_t* pattern);
+
+/**
+ * @brief  Draws polygon filled with 8x8 pattern
+ * @note   @ref SSD1306_UpdateScreen() must be called after that in order to see updated LCD screen
+ * @note   Vertices are pixel corners and even-odd rule is used, so polygons sharing an edge do not overlap
+ * @param  *points: Pointer to array of vertices
+ * @param  count: Number of vertices, 3 to SSD1306_POLYGON_MAX
+ * @param  *pattern: Pointer to 8 byte pattern, see @ref SSD1306_GetPattern
+ * @retval None
+ */
+void SSD1306_DrawPatternPolygon(const SSD1306_POINT_t* points, uint8_t count, const uint8_t* pattern);
+
+/**
+ * @brief  Draws filled polygon
+ * @note   @ref SSD1306_UpdateScreen() must be called after that in order to see updated LCD screen
+ * @param  *points: Pointer to array of vertices
+ * @param  count: Number of vertices, 3 to SSD1306_POLYGON_MAX
+ * @param  c: Color to be used. This parameter can be a value of @ref SSD1306_COLOR_t enumeration
+ * @retval None
+ */
+void SSD1306_DrawFilledPolygon(const SSD1306_POINT_t* points, uint8_t count, SSD1306_COLOR_t c);
+
+/**
+ * @brief  Draws 8-bit grayscale image with 8x8 ordered dithering
+ * @note   Work per pixel is fixed, suitable for live data like sensor heatmaps
+ * @param  x: Top left X location, may be partially outside of screen
+ * @param  y: Top left Y location, may be partially outside of screen
+ * @param  w: Image width in units of pixels
+ * @param  h: Image height in units of pixels
+ * @param  *gray: Row-major image, 0 is black and 255 is white
+ * @retval None
+ */
+void SSD1306_DrawGrayOrdered(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t* gray);
+
+/**
+ * @brief  Draws 8-bit grayscale image with Floyd-Steinberg error diffusion
+ * @note   Image is scanned column by column so every LCD byte is built before it is written.
+ *         Work per pixel is fixed
+ * @param  x: Top left X location, may be partially outside of screen
+ * @param  y: Top left Y location, may be partially outside of screen
+ * @param  w: Image width in units of pixels
+ * @param  h: Image height in units of pixels
+ * @param  *gray: Row-major image, 0 is black and 255 is white
+ * @param  *err: Work buffer of 2 * (h + 2) elements
+ * @retval None
+ */
+void SSD1306_DrawGrayDiffused(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t* gray, int16_t* err);
+
+/**
+ * @brief  Decodes compressed image straight into STM buffer
+ * @note   @ref SSD1306_UpdateScreen() must be called after that in order to see updated LCD screen
+ * @note   When y is a multiple of 8 and image fits on the screen, whole runs are copied with memset/memcpy
+ * @param  x: Top left X location. Valid input is 0 to SSD1306_WIDTH - 1
+ * @param  y: Top left Y location. Valid input is 0 to SSD1306_HEIGHT - 1
+ * @param  *img: Pointer to @ref SSD1306_IMAGE_t structure with image to draw
+ * @retval None
+ */
+void SSD1306_DrawImage(uint16_t x, uint16_t y, const SSD1306_IMAGE_t* img);
+
+/**
+ * @brief  Decodes compressed image directly to LCD memory, bypassing STM buffer
+ * @note   Useful for splash screens. STM buffer is not changed, so next @ref SSD1306_UpdateScreen() overwrites the image.
+ *         Works in landscape rotations only, nothing is sent in portrait ones
+ * @param  x: Top left X location. Valid input is 0 to SSD1306_WIDTH - 1
+ * @param  page: Top page (row of 8 pixels). Valid input is 0 to SSD1306_HEIGHT / 8 - 1
+ * @param  *img: Pointer to @ref SSD1306_IMAGE_t structure with image to send
+ * @retval None
+ */
+void SSD1306_StreamImage(uint16_t x, uint8_t page, const SSD1306_IMAGE_t* img);
+
+/**
+ * @brief  Moves area of whole pages one column to the left, both in STM buffer and in LCD memory
+ * @note   LCD is shifted with one content scroll command, so only the new right column is marked dirty
+ *         and has to be sent by @ref SSD1306_UpdateDirty(). New column is cleared.
+ *         Needs LCD with content scroll commands (0x2C/0x2D), in portrait rotations whole area is marked dirty instead
+ * @param  x: Left column of area. Valid input is 0 to SSD1306_WIDTH - 1
+ * @param  page: Top page (row of 8 pixels) of area
+ * @param  w: Area width in units of pixels, at least 2
+ * @param  pages: Area height in units of pages
+ * @retval None
+ */
+void SSD1306_ScrollLeft(uint16_t x, uint8_t page, uint16_t w, uint8_t pages);
+
+
+
+/**
+ * @brief  Draws page-major bitmap to STM buffer
+ * @note   @ref SSD1306_UpdateScreen() must be called after that in order to see updated LCD screen
+ * @note   Bitmap layout is the same as LCD memory: byte holds 8 vertical pixels, LSB on top, w bytes per page row
+ * @param  x: Top left X location, may be negative or partially outside of screen
+ * @param  y: Top left Y location, may be negative or partially outside of screen
+ * @param  w: Bitmap width in units of pixels
+ * @param  h: Bitmap height in units of pixels
+ * @param  *bitmap: Pointer to bitmap data
+ * @param  *mask: Pointer to mask with the same layout, only pixels set in mask are drawn. NULL draws whole bitmap
+ * @param  rop: Raster operation. This parameter can be a value of @ref SSD1306_ROP_t enumeration
+ * @retval None
+ */
+void SSD1306_DrawBitmap(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t* bitmap, const uint8_t* mask, SSD1306_ROP_t rop);
+
+/**
+ * @brief  Copies area of STM buffer into page-major bitmap
+ * @note   Lit pixels are read as 1, so bitmap can be drawn back with @ref SSD1306_DrawBitmap and SSD1306_ROP_COPY.
+ *         Pixels outside of the screen are read as 0. Bitmap must hold w * ((h + 7) / 8) bytes
+ * @param  x: Top left X location, may be negative or partially outside of screen
+ * @param  y: Top left Y location, may be negative or partially outside of screen
+ * @param  w: Area width in units of pixels
+ * @param  h: Area height in units of pixels
+ * @param  *bitmap: Pointer to bitmap where pixels will be saved
+ * @retval None
+ */
+void SSD1306_ReadBitmap(int16_t x, int16_t y, uint16_t w, uint16_t h, uint8_t* bitmap);
 
 #endif /* SSD1306_H_ */
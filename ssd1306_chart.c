@@ -0,0 +1,175 @@
+/*
+ * ssd1306_chart.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ */
+#include "ssd1306_chart.h"
+#include "ssd1306_text.h"
+
+/* Glyphs reserved for one label */
+#define SSD1306_CHART_LABEL      6
+
+/* Maps value to plot row */
+static int16_t ssd1306_Chart_Row(const SSD1306_CHART_t* chart, int16_t value) {
+	if (value < chart->Min) {
+		value = chart->Min;
+	}
+	if (value > chart->Max) {
+		value = chart->Max;
+	}
+	return chart->Y + (int32_t)(chart->Max - value) * (chart->Height - 1) / (chart->Max - chart->Min);
+}
+
+/* Renders one plot column, segment from previous value to new one */
+static void ssd1306_Chart_Column(const SSD1306_CHART_t* chart, int16_t x, int16_t value, int16_t prev, uint8_t first) {
+	int16_t y0 = ssd1306_Chart_Row(chart, value);
+	int16_t y1 = first ? y0 : ssd1306_Chart_Row(chart, prev);
+	int16_t t;
+
+	if (y0 > y1) {
+		t = y0;
+		y0 = y1;
+		y1 = t;
+	}
+
+	/* Filled rectangle covers w + 1 by h + 1 pixels */
+	SSD1306_DrawFilledRectangle(x, chart->Y, 0, chart->Height - 1, SSD1306_COLOR_BLACK);
+	SSD1306_DrawFilledRectangle(x, y0, 0, y1 - y0, SSD1306_COLOR_WHITE);
+	SSD1306_MarkDirty(x, chart->Y, 1, chart->Height);
+}
+
+/* Draws one label right aligned left of plot area */
+static void ssd1306_Chart_Label(const SSD1306_CHART_t* chart, int16_t y, int16_t value) {
+	FontDef_t* font = chart->Font;
+	int16_t x = chart->X - 1 - SSD1306_CHART_LABEL * font->FontWidth;
+	uint16_t w = SSD1306_CHART_LABEL * font->FontWidth;
+	SSD1306_NUMFMT_t fmt = {0, SSD1306_ALIGN_LEFT, 0, 0, 0};
+	char str[SSD1306_NUM_MAX + 1];
+	uint8_t len = SSD1306_FormatInt(str, value, &fmt);
+
+	if (x < 0) {
+		w += x;
+		x = 0;
+	}
+	SSD1306_DrawFilledRectangle(x, y, w - 1, font->FontHeight - 1, SSD1306_COLOR_BLACK);
+	SSD1306_GotoXY(chart->X - 1 - len * font->FontWidth, y);
+	SSD1306_Puts(str, font, SSD1306_COLOR_WHITE);
+	SSD1306_MarkDirty(x, y, w, font->FontHeight);
+}
+
+/* Draws labels which differ from those on screen */
+static void ssd1306_Chart_Labels(SSD1306_CHART_t* chart) {
+	if (!chart->Font) {
+		return;
+	}
+
+	if (!chart->Labels || chart->LabelMax != chart->Max) {
+		ssd1306_Chart_Label(chart, chart->Y, chart->Max);
+		chart->LabelMax = chart->Max;
+	}
+	if (!chart->Labels || chart->LabelMin != chart->Min) {
+		ssd1306_Chart_Label(chart, chart->Y + chart->Height - chart->Font->FontHeight, chart->Min);
+		chart->LabelMin = chart->Min;
+	}
+	chart->Labels = 1;
+}
+
+/* Renders all plot columns from ring buffer */
+static void ssd1306_Chart_Plot(const SSD1306_CHART_t* chart) {
+	uint16_t w = chart->Width;
+	uint16_t k, i, x0;
+
+	/* Columns without samples */
+	x0 = (chart->Mode == SSD1306_CHART_SCROLL) ? chart->X : chart->X + chart->Count;
+	if (chart->Count < w) {
+		SSD1306_DrawFilledRectangle(x0, chart->Y, w - chart->Count - 1, chart->Height - 1, SSD1306_COLOR_BLACK);
+		SSD1306_MarkDirty(x0, chart->Y, w - chart->Count, chart->Height);
+	}
+
+	for (k = 0; k < chart->Count; k++) {
+		if (chart->Mode == SSD1306_CHART_SCROLL) {
+			/* Oldest sample first, newest one in the right column */
+			i = (chart->Head + w - chart->Count + k) % w;
+			ssd1306_Chart_Column(chart, chart->X + w - chart->Count + k, chart->samples[i], chart->samples[(i + w - 1) % w], k == 0);
+		} else {
+			/* Ring index is column, sample at 0 follows the one at w - 1 once ring is full */
+			ssd1306_Chart_Column(chart, chart->X + k, chart->samples[k], chart->samples[(k + w - 1) % w], k == 0 && chart->Count < w);
+		}
+	}
+}
+
+void SSD1306_Chart_Init(SSD1306_CHART_t* chart, int16_t x, int16_t y, uint16_t w, uint16_t h, int16_t* samples, FontDef_t* font, SSD1306_CHART_MODE_t mode) {
+	chart->X = x;
+	chart->Y = y;
+	chart->Width = w;
+	chart->Height = h;
+	chart->samples = samples;
+	chart->Count = 0;
+	chart->Head = 0;
+	chart->Min = 0;
+	chart->Max = h - 1;
+	chart->Labels = 0;
+	chart->Scrolled = 0;
+	chart->Font = font;
+	chart->Mode = mode;
+
+	SSD1306_Chart_Redraw(chart);
+}
+
+void SSD1306_Chart_SetRange(SSD1306_CHART_t* chart, int16_t min, int16_t max) {
+	if (
+		max <= min ||
+		(min == chart->Min && max == chart->Max)
+	) {
+		/* Nothing to do */
+		return;
+	}
+
+	chart->Min = min;
+	chart->Max = max;
+	ssd1306_Chart_Plot(chart);
+	ssd1306_Chart_Labels(chart);
+}
+
+void SSD1306_Chart_Push(SSD1306_CHART_t* chart, int16_t value, uint32_t now_ms) {
+	uint16_t w = chart->Width;
+	int16_t prev = chart->samples[(chart->Head + w - 1) % w];
+	int16_t x;
+
+	chart->samples[chart->Head] = value;
+	if (chart->Count < w) {
+		chart->Count++;
+	}
+
+	if (chart->Mode == SSD1306_CHART_SCROLL) {
+		if (chart->Scrolled && (now_ms - chart->LastScroll) < SSD1306_CHART_SCROLL_INTERVAL) {
+			/* LCD would drop the scroll, whole plot is sent instead */
+			if (++chart->Head >= w) {
+				chart->Head = 0;
+			}
+			ssd1306_Chart_Plot(chart);
+			return;
+		}
+
+		/* LCD moves old columns itself */
+		SSD1306_ScrollLeft(chart->X, chart->Y / 8, w, chart->Height / 8);
+		chart->Scrolled = 1;
+		chart->LastScroll = now_ms;
+		x = chart->X + w - 1;
+	} else {
+		x = chart->X + chart->Head;
+	}
+
+	ssd1306_Chart_Column(chart, x, value, prev, chart->Count == 1);
+
+	if (++chart->Head >= w) {
+		chart->Head = 0;
+	}
+}
+
+void SSD1306_Chart_Redraw(SSD1306_CHART_t* chart) {
+	chart->Labels = 0;
+	ssd1306_Chart_Plot(chart);
+	ssd1306_Chart_Labels(chart);
+}
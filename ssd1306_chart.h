@@ -0,0 +1,113 @@
+/*
+ * ssd1306_chart.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ */
+
+#ifndef SSD1306_CHART_H_
+#define SSD1306_CHART_H_
+
+/**
+ * Strip chart widget for time series.
+ *
+ * Samples are kept in a ring buffer with one entry per plot column. Every new sample renders
+ * exactly one plot column (a vertical segment from the previous value to the new one) and marks
+ * only that column dirty, so @ref SSD1306_UpdateDirty sends one byte per page of the plot.
+ * The whole plot is rendered again only when value range changes.
+ *
+ * Two modes are supported:
+ *  - Sweep: column ring, new sample overwrites the oldest one in place and the write position
+ *    wraps from right edge back to the left one, like on an oscilloscope
+ *  - Scroll: new sample always appears at right edge, older ones move left. Plot is shifted with
+ *    @ref SSD1306_ScrollLeft, so LCD moves its own memory and still only one column is sent.
+ *    Plot area must start and end at page boundary (Y and Height multiple of 8).
+ *    LCD ignores a content scroll which comes less than two frame periods after the previous one,
+ *    so a sample pushed sooner than SSD1306_CHART_SCROLL_INTERVAL after the last scroll renders
+ *    the whole plot again and marks it dirty instead
+ *
+ * Min and max labels are drawn left of the plot area when font is given, they are redrawn
+ * only when the range changes. Leave room for 6 glyphs there.
+ */
+
+#include "ssd1306.h"
+
+/* Minimum time between two content scrolls in milliseconds, at least two LCD frame periods */
+#ifndef SSD1306_CHART_SCROLL_INTERVAL
+#define SSD1306_CHART_SCROLL_INTERVAL 20
+#endif
+
+/**
+ * @brief  Chart modes
+ */
+typedef enum {
+	SSD1306_CHART_SWEEP = 0x00,  /*!< Column ring, write position wraps around */
+	SSD1306_CHART_SCROLL         /*!< Newest sample on the right, LCD content scroll at most every SSD1306_CHART_SCROLL_INTERVAL */
+} SSD1306_CHART_MODE_t;
+
+/**
+ * @brief  Chart structure
+ */
+typedef struct {
+	int16_t X;                   /*!< Top left X location of plot area */
+	int16_t Y;                   /*!< Top left Y location of plot area */
+	uint16_t Width;              /*!< Plot width in pixels, one sample per column */
+	uint16_t Height;             /*!< Plot height in pixels */
+	int16_t* samples;            /*!< Ring buffer of Width samples */
+	uint16_t Count;              /*!< Samples stored in ring */
+	uint16_t Head;               /*!< Ring index of next sample */
+	int16_t Min;                 /*!< Value shown at bottom row */
+	int16_t Max;                 /*!< Value shown at top row */
+	int16_t LabelMin;            /*!< Min label currently on screen */
+	int16_t LabelMax;            /*!< Max label currently on screen */
+	uint8_t Labels;              /*!< Labels are on screen */
+	uint8_t Scrolled;            /*!< LastScroll is valid */
+	uint32_t LastScroll;         /*!< Time of last content scroll in milliseconds */
+	FontDef_t* Font;             /*!< Label font, NULL for no labels */
+	SSD1306_CHART_MODE_t Mode;   /*!< Chart mode */
+} SSD1306_CHART_t;
+
+/**
+ * @brief  Initializes chart, clears plot area and marks it dirty
+ * @param  *chart: Pointer to @ref SSD1306_CHART_t structure to initialize
+ * @param  x: Top left X location of plot area
+ * @param  y: Top left Y location of plot area
+ * @param  w: Plot width in units of pixels
+ * @param  h: Plot height in units of pixels
+ * @param  *samples: Ring buffer of w samples
+ * @param  *font: Pointer to @ref FontDef_t font for min and max labels, NULL for no labels
+ * @param  mode: Chart mode. This parameter can be a value of @ref SSD1306_CHART_MODE_t enumeration
+ * @retval None
+ */
+void SSD1306_Chart_Init(SSD1306_CHART_t* chart, int16_t x, int16_t y, uint16_t w, uint16_t h, int16_t* samples, FontDef_t* font, SSD1306_CHART_MODE_t mode);
+
+/**
+ * @brief  Sets value range of plot
+ * @note   Whole plot is rendered again and labels are updated when range changes, nothing is done otherwise
+ * @param  *chart: Pointer to @ref SSD1306_CHART_t structure
+ * @param  min: Value of bottom row
+ * @param  max: Value of top row, must be greater than min
+ * @retval None
+ */
+void SSD1306_Chart_SetRange(SSD1306_CHART_t* chart, int16_t min, int16_t max);
+
+/**
+ * @brief  Adds sample to chart, renders and marks dirty one plot column
+ * @note   @ref SSD1306_UpdateDirty() must be called after that in order to see updated LCD screen.
+ *         In scroll mode whole plot is rendered and marked dirty when last content scroll was
+ *         less than SSD1306_CHART_SCROLL_INTERVAL ago
+ * @param  *chart: Pointer to @ref SSD1306_CHART_t structure
+ * @param  value: New sample
+ * @param  now_ms: Current time in milliseconds, may wrap around. Only used in scroll mode
+ * @retval None
+ */
+void SSD1306_Chart_Push(SSD1306_CHART_t* chart, int16_t value, uint32_t now_ms);
+
+/**
+ * @brief  Renders whole chart again from ring buffer, including labels
+ * @param  *chart: Pointer to @ref SSD1306_CHART_t structure
+ * @retval None
+ */
+void SSD1306_Chart_Redraw(SSD1306_CHART_t* chart);
+
+#endif /* SSD1306_CHART_H_ */
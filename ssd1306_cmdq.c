@@ -0,0 +1,191 @@
+/*
+ * ssd1306_cmdq.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ */
+#include "ssd1306_cmdq.h"
+#include "ssd1306_text.h"
+
+#define SSD1306_CMDQ_MASK   (SSD1306_CMDQ_SIZE - 1)
+
+/* Head and Tail run freely and wrap at 256, difference is number of waiting commands */
+static uint8_t ssd1306_CmdQ_Count(const SSD1306_CMDQ_t* q) {
+	return (uint8_t)(q->Head - q->Tail);
+}
+
+void SSD1306_CmdQ_Init(SSD1306_CMDQ_t* q) {
+	q->Head = 0;
+	q->Tail = 0;
+	q->Stats.Posted = 0;
+	q->Stats.Dropped = 0;
+	q->Stats.HighWater = 0;
+}
+
+uint8_t SSD1306_CmdQ_Post(SSD1306_CMDQ_t* q, const SSD1306_CMD_t* cmd) {
+	uint8_t head = q->Head;
+	uint8_t count = ssd1306_CmdQ_Count(q);
+
+	if (count >= SSD1306_CMDQ_SIZE) {
+		/* Full, consumer is behind */
+		q->Stats.Dropped++;
+		return 0;
+	}
+
+	q->Cmd[head & SSD1306_CMDQ_MASK] = *cmd;
+
+	/* Command must be in memory before consumer can see it */
+	__DMB();
+	q->Head = head + 1;
+
+	q->Stats.Posted++;
+	if (count + 1 > q->Stats.HighWater) {
+		q->Stats.HighWater = count + 1;
+	}
+
+	return 1;
+}
+
+uint8_t SSD1306_CmdQ_Pixel(SSD1306_CMDQ_t* q, int16_t x, int16_t y, SSD1306_COLOR_t color) {
+	SSD1306_CMD_t cmd;
+
+	cmd.Op = SSD1306_CMD_PIXEL;
+	cmd.Color = color;
+	cmd.X = x;
+	cmd.Y = y;
+
+	return SSD1306_CmdQ_Post(q, &cmd);
+}
+
+uint8_t SSD1306_CmdQ_Rect(SSD1306_CMDQ_t* q, int16_t x, int16_t y, uint16_t w, uint16_t h, SSD1306_COLOR_t color) {
+	SSD1306_CMD_t cmd;
+
+	cmd.Op = SSD1306_CMD_RECT;
+	cmd.Color = color;
+	cmd.X = x;
+	cmd.Y = y;
+	cmd.u.Area.W = w;
+	cmd.u.Area.H = h;
+
+	return SSD1306_CmdQ_Post(q, &cmd);
+}
+
+uint8_t SSD1306_CmdQ_Text(SSD1306_CMDQ_t* q, int16_t x, int16_t y, const char* str, FontDef_t* Font, SSD1306_COLOR_t color) {
+	SSD1306_CMD_t cmd;
+	uint8_t i;
+
+	cmd.Op = SSD1306_CMD_TEXT;
+	cmd.Color = color;
+	cmd.X = x;
+	cmd.Y = y;
+	cmd.u.Text.Font = Font;
+	/* Rest is zero filled, full field needs no terminator */
+	for (i = 0; i < SSD1306_CMDQ_TEXT; i++) {
+		cmd.u.Text.u.Str[i] = *str;
+		if (*str) {
+			str++;
+		}
+	}
+
+	return SSD1306_CmdQ_Post(q, &cmd);
+}
+
+uint8_t SSD1306_CmdQ_Number(SSD1306_CMDQ_t* q, int16_t x, int16_t y, int32_t value, uint8_t digits, FontDef_t* Font, SSD1306_COLOR_t color) {
+	SSD1306_CMD_t cmd;
+
+	cmd.Op = SSD1306_CMD_NUMBER;
+	cmd.Color = color;
+	cmd.X = x;
+	cmd.Y = y;
+	cmd.u.Text.Font = Font;
+	cmd.u.Text.u.Number.Value = value;
+	cmd.u.Text.u.Number.Digits = digits;
+
+	return SSD1306_CmdQ_Post(q, &cmd);
+}
+
+uint8_t SSD1306_CmdQ_Bitmap(SSD1306_CMDQ_t* q, int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t* bitmap, SSD1306_ROP_t rop) {
+	SSD1306_CMD_t cmd;
+
+	cmd.Op = SSD1306_CMD_BITMAP;
+	cmd.Color = rop;
+	cmd.X = x;
+	cmd.Y = y;
+	cmd.u.Area.W = w;
+	cmd.u.Area.H = h;
+	cmd.u.Area.Data = bitmap;
+
+	return SSD1306_CmdQ_Post(q, &cmd);
+}
+
+/* Draws text at command location and marks covered area dirty */
+static void ssd1306_CmdQ_DrawText(const SSD1306_CMD_t* cmd, char* str) {
+	uint16_t x, y;
+
+	SSD1306_GotoXY(cmd->X, cmd->Y);
+	SSD1306_Puts(str, cmd->u.Text.Font, (SSD1306_COLOR_t)cmd->Color);
+	SSD1306_GetXY(&x, &y);
+	SSD1306_MarkDirty(cmd->X, cmd->Y, x - cmd->X, cmd->u.Text.Font->FontHeight);
+}
+
+static void ssd1306_CmdQ_Execute(const SSD1306_CMD_t* cmd) {
+	char str[SSD1306_CMDQ_TEXT > SSD1306_NUM_MAX ? SSD1306_CMDQ_TEXT + 1 : SSD1306_NUM_MAX + 1];
+	SSD1306_NUMFMT_t fmt = {0, SSD1306_ALIGN_RIGHT, 0, 0, 0};
+
+	switch (cmd->Op) {
+		case SSD1306_CMD_PIXEL:
+			SSD1306_DrawPixel(cmd->X, cmd->Y, (SSD1306_COLOR_t)cmd->Color);
+			SSD1306_MarkDirty(cmd->X, cmd->Y, 1, 1);
+			break;
+		case SSD1306_CMD_RECT:
+			/* Filled rectangle covers both end points */
+			SSD1306_DrawFilledRectangle(cmd->X, cmd->Y, cmd->u.Area.W, cmd->u.Area.H, (SSD1306_COLOR_t)cmd->Color);
+			SSD1306_MarkDirty(cmd->X, cmd->Y, cmd->u.Area.W + 1, cmd->u.Area.H + 1);
+			break;
+		case SSD1306_CMD_TEXT:
+			memcpy(str, cmd->u.Text.u.Str, SSD1306_CMDQ_TEXT);
+			str[SSD1306_CMDQ_TEXT] = 0;
+			ssd1306_CmdQ_DrawText(cmd, str);
+			break;
+		case SSD1306_CMD_NUMBER:
+			fmt.Width = cmd->u.Text.u.Number.Digits;
+			SSD1306_FormatInt(str, cmd->u.Text.u.Number.Value, &fmt);
+			ssd1306_CmdQ_DrawText(cmd, str);
+			break;
+		case SSD1306_CMD_BITMAP:
+			SSD1306_DrawBitmap(cmd->X, cmd->Y, cmd->u.Area.W, cmd->u.Area.H, cmd->u.Area.Data, NULL, (SSD1306_ROP_t)cmd->Color);
+			SSD1306_MarkDirty(cmd->X, cmd->Y, cmd->u.Area.W, cmd->u.Area.H);
+			break;
+		default:
+			break;
+	}
+}
+
+uint16_t SSD1306_CmdQ_Drain(SSD1306_CMDQ_t* q, uint16_t max) {
+	SSD1306_CMD_t cmd;
+	uint16_t x, y;
+	uint16_t n = 0;
+	uint8_t tail = q->Tail;
+
+	/* Text commands move cursor, main loop keeps its own */
+	SSD1306_GetXY(&x, &y);
+
+	while (tail != q->Head && (!max || n < max)) {
+		/* Head read before command, command copied before slot is given back */
+		__DMB();
+		cmd = q->Cmd[tail & SSD1306_CMDQ_MASK];
+		__DMB();
+		q->Tail = ++tail;
+
+		ssd1306_CmdQ_Execute(&cmd);
+		n++;
+	}
+
+	SSD1306_GotoXY(x, y);
+
+	return n;
+}
+
+void SSD1306_CmdQ_GetStats(const SSD1306_CMDQ_t* q, SSD1306_CMDQ_STATS_t* stats) {
+	*stats = q->Stats;
+}
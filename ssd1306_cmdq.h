@@ -0,0 +1,195 @@
+/*
+ * ssd1306_cmdq.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ */
+
+#ifndef SSD1306_CMDQ_H_
+#define SSD1306_CMDQ_H_
+
+/**
+ * Draw command queue between interrupt handlers and main loop.
+ *
+ * Drawing functions share STM buffer and text cursor and are not reentrant, so they must
+ * not be called from an interrupt while main loop draws. Interrupt posts a small command
+ * instead, text is copied into the command, and main loop rasterizes queued commands with
+ * @ref SSD1306_CmdQ_Drain before it flushes the screen. Drawn areas are marked dirty.
+ *
+ * Queue is a lock-free single producer, single consumer ring: only producer writes Head and
+ * only consumer writes Tail, no interrupt is ever masked. Full queue drops new command and
+ * counts it. Handlers which may preempt each other must post to separate queues, or run
+ * on the same interrupt priority.
+ */
+
+#include "ssd1306.h"
+
+/* Number of commands in queue, must be a power of 2 */
+#ifndef SSD1306_CMDQ_SIZE
+#define SSD1306_CMDQ_SIZE   16
+#endif
+/* Characters copied into one text command, longer text is cut */
+#ifndef SSD1306_CMDQ_TEXT
+#define SSD1306_CMDQ_TEXT   8
+#endif
+
+#if (SSD1306_CMDQ_SIZE & (SSD1306_CMDQ_SIZE - 1)) || SSD1306_CMDQ_SIZE > 128
+#error "SSD1306_CMDQ_SIZE must be a power of 2 up to 128"
+#endif
+
+/**
+ * @brief  Draw command operations
+ */
+typedef enum {
+	SSD1306_CMD_PIXEL = 0x00, /*!< Sets one pixel */
+	SSD1306_CMD_RECT,         /*!< Fills rectangle */
+	SSD1306_CMD_TEXT,         /*!< Draws text copied into command */
+	SSD1306_CMD_NUMBER,       /*!< Draws decimal number right aligned in fixed number of characters */
+	SSD1306_CMD_BITMAP        /*!< Draws page-major bitmap with raster operation */
+} SSD1306_CMD_OP_t;
+
+/**
+ * @brief  Draw command structure
+ */
+typedef struct {
+	uint8_t Op;                                  /*!< Value of @ref SSD1306_CMD_OP_t enumeration */
+	uint8_t Color;                               /*!< Value of @ref SSD1306_COLOR_t enumeration, or @ref SSD1306_ROP_t for bitmap */
+	int16_t X;                                   /*!< Top left X location */
+	int16_t Y;                                   /*!< Top left Y location */
+	union {
+		struct {
+			uint16_t W;                          /*!< Width in pixels */
+			uint16_t H;                          /*!< Height in pixels */
+			const uint8_t* Data;                 /*!< Bitmap, must stay valid until command is drained */
+		} Area;
+		struct {
+			FontDef_t* Font;                     /*!< Pointer to @ref FontDef_t font */
+			union {
+				char Str[SSD1306_CMDQ_TEXT];     /*!< Text, not terminated when all characters are used */
+				struct {
+					int32_t Value;               /*!< Number to draw */
+					uint8_t Digits;              /*!< Field width in characters, number is padded with spaces */
+				} Number;
+			} u;
+		} Text;
+	} u;
+} SSD1306_CMD_t;
+
+/**
+ * @brief  Queue statistics
+ */
+typedef struct {
+	uint32_t Posted;     /*!< Commands accepted */
+	uint32_t Dropped;    /*!< Commands dropped because queue was full */
+	uint8_t HighWater;   /*!< Most commands waiting at the same time */
+} SSD1306_CMDQ_STATS_t;
+
+/**
+ * @brief  Queue structure
+ */
+typedef struct {
+	SSD1306_CMD_t Cmd[SSD1306_CMDQ_SIZE];
+	volatile uint8_t Head;      /*!< Next slot to write, written by producer only */
+	volatile uint8_t Tail;      /*!< Next slot to read, written by consumer only */
+	SSD1306_CMDQ_STATS_t Stats; /*!< Posted and HighWater written by producer, Dropped too */
+} SSD1306_CMDQ_t;
+
+/**
+ * @brief  Empties queue and clears its statistics
+ * @note   Must not be called while producer or consumer uses queue
+ * @param  *q: Pointer to @ref SSD1306_CMDQ_t structure
+ * @retval None
+ */
+void SSD1306_CmdQ_Init(SSD1306_CMDQ_t* q);
+
+/**
+ * @brief  Copies command into queue, producer side
+ * @param  *q: Pointer to @ref SSD1306_CMDQ_t structure
+ * @param  *cmd: Pointer to @ref SSD1306_CMD_t command
+ * @retval Post status:
+ *           - 0: Queue is full, command is dropped
+ *           - > 0: Command is queued
+ */
+uint8_t SSD1306_CmdQ_Post(SSD1306_CMDQ_t* q, const SSD1306_CMD_t* cmd);
+
+/**
+ * @brief  Queues one pixel, producer side
+ * @param  *q: Pointer to @ref SSD1306_CMDQ_t structure
+ * @param  x: X location
+ * @param  y: Y location
+ * @param  color: Color used for drawing. This parameter can be a value of @ref SSD1306_COLOR_t enumeration
+ * @retval 0 when queue is full, > 0 otherwise
+ */
+uint8_t SSD1306_CmdQ_Pixel(SSD1306_CMDQ_t* q, int16_t x, int16_t y, SSD1306_COLOR_t color);
+
+/**
+ * @brief  Queues filled rectangle, producer side
+ * @param  *q: Pointer to @ref SSD1306_CMDQ_t structure
+ * @param  x: Top left X location
+ * @param  y: Top left Y location
+ * @param  w: Rectangle width in units of pixels
+ * @param  h: Rectangle height in units of pixels
+ * @param  color: Color used for drawing. This parameter can be a value of @ref SSD1306_COLOR_t enumeration
+ * @retval 0 when queue is full, > 0 otherwise
+ */
+uint8_t SSD1306_CmdQ_Rect(SSD1306_CMDQ_t* q, int16_t x, int16_t y, uint16_t w, uint16_t h, SSD1306_COLOR_t color);
+
+/**
+ * @brief  Queues text, producer side
+ * @note   At most SSD1306_CMDQ_TEXT characters are copied
+ * @param  *q: Pointer to @ref SSD1306_CMDQ_t structure
+ * @param  x: Top left X location
+ * @param  y: Top left Y location
+ * @param  *str: String, may be reused as soon as function returns
+ * @param  *Font: Pointer to @ref FontDef_t structure with used font
+ * @param  color: Color used for drawing. This parameter can be a value of @ref SSD1306_COLOR_t enumeration
+ * @retval 0 when queue is full, > 0 otherwise
+ */
+uint8_t SSD1306_CmdQ_Text(SSD1306_CMDQ_t* q, int16_t x, int16_t y, const char* str, FontDef_t* Font, SSD1306_COLOR_t color);
+
+/**
+ * @brief  Queues decimal number, producer side
+ * @note   Number is formatted by consumer, so producer does no formatting at all
+ * @param  *q: Pointer to @ref SSD1306_CMDQ_t structure
+ * @param  x: Top left X location
+ * @param  y: Top left Y location
+ * @param  value: Number to draw
+ * @param  digits: Field width in characters, shorter number is padded with spaces on the left
+ * @param  *Font: Pointer to @ref FontDef_t structure with used font
+ * @param  color: Color used for drawing. This parameter can be a value of @ref SSD1306_COLOR_t enumeration
+ * @retval 0 when queue is full, > 0 otherwise
+ */
+uint8_t SSD1306_CmdQ_Number(SSD1306_CMDQ_t* q, int16_t x, int16_t y, int32_t value, uint8_t digits, FontDef_t* Font, SSD1306_COLOR_t color);
+
+/**
+ * @brief  Queues bitmap, producer side
+ * @note   Bitmap is not copied, it must stay unchanged until command is drained
+ * @param  *q: Pointer to @ref SSD1306_CMDQ_t structure
+ * @param  x: Top left X location
+ * @param  y: Top left Y location
+ * @param  w: Bitmap width in units of pixels
+ * @param  h: Bitmap height in units of pixels
+ * @param  *bitmap: Page-major bitmap, see @ref SSD1306_DrawBitmap
+ * @param  rop: Raster operation. This parameter can be a value of @ref SSD1306_ROP_t enumeration
+ * @retval 0 when queue is full, > 0 otherwise
+ */
+uint8_t SSD1306_CmdQ_Bitmap(SSD1306_CMDQ_t* q, int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t* bitmap, SSD1306_ROP_t rop);
+
+/**
+ * @brief  Draws queued commands and marks their areas dirty, consumer side
+ * @note   Call it from main loop only. Text cursor is kept, current text mode is used
+ * @param  *q: Pointer to @ref SSD1306_CMDQ_t structure
+ * @param  max: Most commands drawn in this call, 0 draws all of them
+ * @retval Number of commands drawn
+ */
+uint16_t SSD1306_CmdQ_Drain(SSD1306_CMDQ_t* q, uint16_t max);
+
+/**
+ * @brief  Gets queue statistics
+ * @param  *q: Pointer to @ref SSD1306_CMDQ_t structure
+ * @param  *stats: Pointer to @ref SSD1306_CMDQ_STATS_t structure where statistics are saved
+ * @retval None
+ */
+void SSD1306_CmdQ_GetStats(const SSD1306_CMDQ_t* q, SSD1306_CMDQ_STATS_t* stats);
+
+#endif /* SSD1306_CMDQ_H_ */
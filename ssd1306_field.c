@@ -0,0 +1,76 @@
+/*
+ * ssd1306_field.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ */
+#include "ssd1306_field.h"
+
+void SSD1306_Field_Init(SSD1306_FIELD_t* field, int16_t x, int16_t y, uint8_t width, char* shown, FontDef_t* Font, SSD1306_COLOR_t color) {
+	field->X = x;
+	field->Y = y;
+	field->Width = width;
+	field->Font = Font;
+	field->Color = color;
+	field->Shown = shown;
+	field->Valid = 0;
+}
+
+/* Draws cells first to last - 1 from Shown */
+static void ssd1306_Field_Draw(const SSD1306_FIELD_t* field, uint8_t first, uint8_t last) {
+	FontDef_t* font = field->Font;
+	int16_t x = field->X + first * font->FontWidth;
+	uint16_t w = (last - first) * font->FontWidth;
+	uint8_t i;
+
+	/* Background first, glyphs are drawn the same way in both text modes */
+	SSD1306_DrawFilledRectangle(x, field->Y, w - 1, font->FontHeight - 1, (SSD1306_COLOR_t)!field->Color);
+	SSD1306_GotoXY(x, field->Y);
+	for (i = first; i < last; i++) {
+		SSD1306_Putc(field->Shown[i], font, field->Color);
+	}
+	SSD1306_MarkDirty(x, field->Y, w, font->FontHeight);
+}
+
+uint8_t SSD1306_Field_Set(SSD1306_FIELD_t* field, const char* str) {
+	uint16_t cx, cy, i, first = 0;
+	uint8_t changed = 0, drawn = 0;
+	char ch;
+
+	SSD1306_GetXY(&cx, &cy);
+
+	/* Cell i + 1 == Width closes last run, i goes up to 255 */
+	for (i = 0; i <= field->Width; i++) {
+		if (i < field->Width) {
+			ch = *str ? *str++ : ' ';
+			if (ch < 32 || ch > 126) {
+				/* No glyph in font */
+				ch = '?';
+			}
+			if (!field->Valid || field->Shown[i] != ch) {
+				if (!changed) {
+					first = i;
+					changed = 1;
+				}
+				field->Shown[i] = ch;
+				continue;
+			}
+		}
+
+		/* Run of changed cells ends here */
+		if (changed) {
+			ssd1306_Field_Draw(field, first, i);
+			drawn += i - first;
+			changed = 0;
+		}
+	}
+
+	field->Valid = 1;
+	SSD1306_GotoXY(cx, cy);
+
+	return drawn;
+}
+
+void SSD1306_Field_Invalidate(SSD1306_FIELD_t* field) {
+	field->Valid = 0;
+}
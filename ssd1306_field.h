@@ -0,0 +1,69 @@
+/*
+ * ssd1306_field.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ */
+
+#ifndef SSD1306_FIELD_H_
+#define SSD1306_FIELD_H_
+
+/**
+ * Retained text fields.
+ *
+ * Field is a fixed row of glyph cells which remembers what it shows. New text is compared
+ * with it character by character, only cells which changed are drawn again and marked
+ * with @ref SSD1306_MarkDirty, so @ref SSD1306_UpdateDirty sends just those columns.
+ * A reading like "Temp: 23.4C" which goes to "Temp: 23.5C" redraws one cell.
+ *
+ * Numbers are formatted with @ref SSD1306_FormatFixed and friends into a buffer which is
+ * then given to @ref SSD1306_Field_Set.
+ */
+
+#include "ssd1306.h"
+
+/**
+ * @brief  Text field structure
+ */
+typedef struct {
+	int16_t X;               /*!< Top left X location */
+	int16_t Y;               /*!< Top left Y location */
+	uint8_t Width;           /*!< Field width in glyph cells */
+	FontDef_t* Font;         /*!< Pointer to @ref FontDef_t font */
+	SSD1306_COLOR_t Color;   /*!< Glyph color, cell background gets the other one */
+	char* Shown;             /*!< Width characters shown on screen */
+	uint8_t Valid;           /*!< Shown matches screen, cleared by @ref SSD1306_Field_Invalidate */
+} SSD1306_FIELD_t;
+
+/**
+ * @brief  Initializes field, first @ref SSD1306_Field_Set draws all of its cells
+ * @param  *field: Pointer to @ref SSD1306_FIELD_t structure to initialize
+ * @param  x: Top left X location
+ * @param  y: Top left Y location
+ * @param  width: Field width in glyph cells
+ * @param  *shown: Buffer of width characters which keeps field contents
+ * @param  *Font: Pointer to @ref FontDef_t structure with used font
+ * @param  color: Glyph color. This parameter can be a value of @ref SSD1306_COLOR_t enumeration
+ * @retval None
+ */
+void SSD1306_Field_Init(SSD1306_FIELD_t* field, int16_t x, int16_t y, uint8_t width, char* shown, FontDef_t* Font, SSD1306_COLOR_t color);
+
+/**
+ * @brief  Shows text in field, draws and marks dirty only cells which changed
+ * @note   @ref SSD1306_UpdateDirty() must be called after that in order to see updated LCD screen.
+ *         Text cursor is kept
+ * @param  *field: Pointer to @ref SSD1306_FIELD_t structure
+ * @param  *str: Text, shorter text is padded with spaces and longer one is cut to field width
+ * @retval Number of cells drawn
+ */
+uint8_t SSD1306_Field_Set(SSD1306_FIELD_t* field, const char* str);
+
+/**
+ * @brief  Forgets field contents, next @ref SSD1306_Field_Set draws all cells again
+ * @note   Call it when screen under field was cleared or drawn over
+ * @param  *field: Pointer to @ref SSD1306_FIELD_t structure
+ * @retval None
+ */
+void SSD1306_Field_Invalidate(SSD1306_FIELD_t* field);
+
+#endif /* SSD1306_FIELD_H_ */
@@ -0,0 +1,191 @@
+/*
+ * ssd1306_gray.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ */
+#include "ssd1306_gray.h"
+
+/* Write command burst */
+#define SSD1306_WRITECOMMANDS(commands)    SSD1306_Transport_Command((commands), sizeof(commands))
+
+/* Frames in one gray cycle */
+#define SSD1306_GRAY_FRAMES      3
+
+/* Gray bitplanes, LCD layout */
+static uint8_t SSD1306_GrayHi[SSD1306_WIDTH * SSD1306_HEIGHT / 8];
+static uint8_t SSD1306_GrayLo[SSD1306_WIDTH * SSD1306_HEIGHT / 8];
+
+/* Private grayscale structure */
+typedef struct {
+	uint32_t FrameTime;
+	uint32_t NextFrame;
+	uint32_t WindowStart;
+	uint32_t WindowFrames;
+	uint8_t Frame;
+	SSD1306_GRAY_STATS_t Stats;
+} SSD1306_GRAY_t;
+
+/* Private variable */
+static SSD1306_GRAY_t SSD1306_Gray;
+
+void SSD1306_Gray_Init(uint32_t now_us) {
+	/* Horizontal addressing mode, LCD wraps back to 0,0 after each frame by itself */
+	static const uint8_t init[] = {
+		0x20, 0x00,
+		0x21, 0x00, SSD1306_WIDTH - 1, //column start and end
+		0x22, 0x00, SSD1306_HEIGHT / 8 - 1 //page start and end
+	};
+
+	SSD1306_WRITECOMMANDS(init);
+
+	SSD1306_Gray_Fill(0);
+
+	memset(&SSD1306_Gray, 0, sizeof(SSD1306_Gray));
+	SSD1306_Gray.FrameTime = SSD1306_GRAY_FRAME_US;
+	SSD1306_Gray.NextFrame = now_us;
+	SSD1306_Gray.WindowStart = now_us;
+}
+
+void SSD1306_Gray_DeInit(void) {
+	/* Back to page addressing mode, full window */
+	static const uint8_t deinit[] = {
+		0x21, 0x00, SSD1306_WIDTH - 1,
+		0x22, 0x00, SSD1306_HEIGHT / 8 - 1,
+		0x20, 0x10
+	};
+
+	SSD1306_WRITECOMMANDS(deinit);
+}
+
+void SSD1306_Gray_SetFrameTime(uint32_t us) {
+	SSD1306_Gray.FrameTime = us;
+}
+
+void SSD1306_Gray_Fill(uint8_t level) {
+	memset(SSD1306_GrayHi, (level & 0x02) ? 0xFF : 0x00, sizeof(SSD1306_GrayHi));
+	memset(SSD1306_GrayLo, (level & 0x01) ? 0xFF : 0x00, sizeof(SSD1306_GrayLo));
+}
+
+void SSD1306_Gray_DrawPixel(uint16_t x, uint16_t y, uint8_t level) {
+	uint16_t i;
+	uint8_t bit;
+
+	if (
+		x >= SSD1306_WIDTH ||
+		y >= SSD1306_HEIGHT
+	) {
+		/* Error */
+		return;
+	}
+
+	i = x + (y / 8) * SSD1306_WIDTH;
+	bit = 1 << (y % 8);
+	SSD1306_GrayHi[i] = (level & 0x02) ? (SSD1306_GrayHi[i] | bit) : (SSD1306_GrayHi[i] & ~bit);
+	SSD1306_GrayLo[i] = (level & 0x01) ? (SSD1306_GrayLo[i] | bit) : (SSD1306_GrayLo[i] & ~bit);
+}
+
+void SSD1306_Gray_DrawFilledRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t level) {
+	uint8_t hi = (level & 0x02) ? 0xFF : 0x00;
+	uint8_t lo = (level & 0x01) ? 0xFF : 0x00;
+	uint16_t y1, col, i;
+	uint8_t p, mask;
+
+	/* Check input parameters */
+	if (
+		x >= SSD1306_WIDTH ||
+		y >= SSD1306_HEIGHT ||
+		!w || !h
+	) {
+		/* Return error */
+		return;
+	}
+
+	/* Check width and height */
+	if ((x + w) > SSD1306_WIDTH) {
+		w = SSD1306_WIDTH - x;
+	}
+	if ((y + h) > SSD1306_HEIGHT) {
+		h = SSD1306_HEIGHT - y;
+	}
+	y1 = y + h - 1;
+
+	for (p = y / 8; p <= y1 / 8; p++) {
+		/* Rows of this page inside rectangle */
+		mask = 0xFF;
+		if (p == y / 8) {
+			mask &= 0xFF << (y % 8);
+		}
+		if (p == y1 / 8) {
+			mask &= 0xFF >> (7 - y1 % 8);
+		}
+
+		i = x + p * SSD1306_WIDTH;
+		for (col = 0; col < w; col++, i++) {
+			SSD1306_GrayHi[i] = (SSD1306_GrayHi[i] & ~mask) | (hi & mask);
+			SSD1306_GrayLo[i] = (SSD1306_GrayLo[i] & ~mask) | (lo & mask);
+		}
+	}
+}
+
+/* Sends one frame derived from both planes */
+static void ssd1306_Gray_SendFrame(uint8_t frame) {
+	uint16_t i;
+
+	SSD1306_Transport_Begin();
+
+	/* Separate loops keep the per byte work to one load pair and one operation */
+	if (frame == 0) {
+		for (i = 0; i < sizeof(SSD1306_GrayHi); i++) {
+			SSD1306_Transport_Put(SSD1306_GrayHi[i] | SSD1306_GrayLo[i]);
+		}
+	} else if (frame == 1) {
+		for (i = 0; i < sizeof(SSD1306_GrayHi); i++) {
+			SSD1306_Transport_Put(SSD1306_GrayHi[i]);
+		}
+	} else {
+		for (i = 0; i < sizeof(SSD1306_GrayHi); i++) {
+			SSD1306_Transport_Put(SSD1306_GrayHi[i] & SSD1306_GrayLo[i]);
+		}
+	}
+
+	SSD1306_Transport_End();
+}
+
+uint8_t SSD1306_Gray_Process(uint32_t now_us) {
+	uint32_t elapsed;
+
+	/* Not due yet, wrap-around safe */
+	if ((int32_t)(now_us - SSD1306_Gray.NextFrame) < 0) {
+		return 0;
+	}
+
+	if ((now_us - SSD1306_Gray.NextFrame) >= SSD1306_Gray.FrameTime) {
+		/* Bus could not keep up, start new cadence from now */
+		SSD1306_Gray.Stats.Late++;
+		SSD1306_Gray.NextFrame = now_us;
+	}
+	SSD1306_Gray.NextFrame += SSD1306_Gray.FrameTime;
+
+	ssd1306_Gray_SendFrame(SSD1306_Gray.Frame);
+	if (++SSD1306_Gray.Frame >= SSD1306_GRAY_FRAMES) {
+		SSD1306_Gray.Frame = 0;
+	}
+	SSD1306_Gray.Stats.Frames++;
+	SSD1306_Gray.WindowFrames++;
+
+	/* Refresh rate over last second */
+	elapsed = now_us - SSD1306_Gray.WindowStart;
+	if (elapsed >= 1000000) {
+		SSD1306_Gray.Stats.FrameRate = (uint32_t)((uint64_t)SSD1306_Gray.WindowFrames * 1000000 / elapsed);
+		SSD1306_Gray.Stats.CycleRate = SSD1306_Gray.Stats.FrameRate / SSD1306_GRAY_FRAMES;
+		SSD1306_Gray.WindowFrames = 0;
+		SSD1306_Gray.WindowStart = now_us;
+	}
+
+	return 1;
+}
+
+void SSD1306_Gray_GetStats(SSD1306_GRAY_STATS_t* stats) {
+	*stats = SSD1306_Gray.Stats;
+}
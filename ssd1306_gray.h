@@ -0,0 +1,110 @@
+/*
+ * ssd1306_gray.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ */
+
+#ifndef SSD1306_GRAY_H_
+#define SSD1306_GRAY_H_
+
+/**
+ * Temporal grayscale for SSD1306.
+ *
+ * Pixels have 4 levels (0 = black, 3 = white) kept in two bitplanes of LCD layout.
+ * Each gray cycle is sent as 3 ordinary frames:
+ *  - frame 0: level >= 1  (high plane OR low plane)
+ *  - frame 1: level >= 2  (high plane)
+ *  - frame 2: level == 3  (high plane AND low plane)
+ * so pixel is lit in "level" frames out of 3. Frames are derived on the fly byte by byte while
+ * being sent, no third buffer is needed.
+ *
+ * While gray mode is active LCD runs in horizontal addressing mode with full screen window,
+ * so a frame is a single data transfer of SSD1306_WIDTH * SSD1306_HEIGHT / 8 bytes without any command.
+ *
+ * Call @ref SSD1306_Gray_Process as often as possible, it sends next frame when it is due
+ * and keeps statistics of achieved refresh rate and late frames.
+ * When Late keeps growing the bus cannot keep up with configured frame time.
+ */
+
+#include "ssd1306.h"
+
+/* Default frame time in microseconds, 3 frames make one gray cycle */
+#ifndef SSD1306_GRAY_FRAME_US
+#define SSD1306_GRAY_FRAME_US    10000
+#endif
+
+/**
+ * @brief  Grayscale refresh statistics
+ */
+typedef struct {
+	uint32_t Frames;       /*!< Frames sent since @ref SSD1306_Gray_Init */
+	uint32_t Late;         /*!< Frames sent more than one frame time after their deadline */
+	uint32_t FrameRate;    /*!< Achieved frames per second, measured over last second */
+	uint32_t CycleRate;    /*!< Achieved gray cycles per second (FrameRate / 3) */
+} SSD1306_GRAY_STATS_t;
+
+/**
+ * @brief  Enters grayscale mode
+ * @note   Switches LCD to horizontal addressing mode and clears both planes
+ * @param  now_us: Current time in microseconds
+ * @retval None
+ */
+void SSD1306_Gray_Init(uint32_t now_us);
+
+/**
+ * @brief  Leaves grayscale mode and restores page addressing mode used by @ref SSD1306_UpdateScreen
+ * @param  None
+ * @retval None
+ */
+void SSD1306_Gray_DeInit(void);
+
+/**
+ * @brief  Sets time between frames
+ * @param  us: Frame time in microseconds
+ * @retval None
+ */
+void SSD1306_Gray_SetFrameTime(uint32_t us);
+
+/**
+ * @brief  Fills both planes with desired level
+ * @param  level: Gray level, 0 to 3
+ * @retval None
+ */
+void SSD1306_Gray_Fill(uint8_t level);
+
+/**
+ * @brief  Draws gray pixel at desired location
+ * @param  x: X location. This parameter can be a value between 0 and SSD1306_WIDTH - 1
+ * @param  y: Y location. This parameter can be a value between 0 and SSD1306_HEIGHT - 1
+ * @param  level: Gray level, 0 to 3
+ * @retval None
+ */
+void SSD1306_Gray_DrawPixel(uint16_t x, uint16_t y, uint8_t level);
+
+/**
+ * @brief  Draws filled gray rectangle, whole page bytes are written where possible
+ * @param  x: Top left X start point. Valid input is 0 to SSD1306_WIDTH - 1
+ * @param  y: Top left Y start point. Valid input is 0 to SSD1306_HEIGHT - 1
+ * @param  w: Rectangle width in units of pixels
+ * @param  h: Rectangle height in units of pixels
+ * @param  level: Gray level, 0 to 3
+ * @retval None
+ */
+void SSD1306_Gray_DrawFilledRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t level);
+
+/**
+ * @brief  Sends next frame if it is due
+ * @param  now_us: Current time in microseconds, may wrap around
+ * @retval 1 when frame was sent, 0 otherwise
+ */
+uint8_t SSD1306_Gray_Process(uint32_t now_us);
+
+/**
+ * @brief  Gets refresh statistics
+ * @param  *stats: Pointer to @ref SSD1306_GRAY_STATS_t structure to fill
+ * @retval None
+ */
+void SSD1306_Gray_GetStats(SSD1306_GRAY_STATS_t* stats);
+
+#endif /* SSD1306_GRAY_H_ */
@@ -0,0 +1,66 @@
+/*
+ * ssd1306_sprite.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ */
+#include "ssd1306_sprite.h"
+
+void SSD1306_Sprite_Init(SSD1306_SPRITE_t* sprite, const uint8_t* bitmap, const uint8_t* mask, uint8_t w, uint8_t h, SSD1306_SPRITE_MODE_t mode, uint8_t* save) {
+	sprite->X = 0;
+	sprite->Y = 0;
+	sprite->Width = w;
+	sprite->Height = h;
+	sprite->bitmap = bitmap;
+	sprite->mask = mask;
+	sprite->save = save;
+	sprite->Mode = mode;
+	sprite->Visible = 0;
+}
+
+void SSD1306_Sprite_Show(SSD1306_SPRITE_t* sprite, int16_t x, int16_t y) {
+	if (sprite->Visible) {
+		/* Already on screen */
+		return;
+	}
+
+	sprite->X = x;
+	sprite->Y = y;
+
+	if (sprite->Mode == SSD1306_SPRITE_XOR) {
+		SSD1306_DrawBitmap(x, y, sprite->Width, sprite->Height, sprite->bitmap, NULL, SSD1306_ROP_XOR);
+	} else {
+		/* Keep background before it gets overwritten */
+		SSD1306_ReadBitmap(x, y, sprite->Width, sprite->Height, sprite->save);
+		SSD1306_DrawBitmap(x, y, sprite->Width, sprite->Height, sprite->bitmap, sprite->mask, SSD1306_ROP_COPY);
+	}
+
+	SSD1306_MarkDirty(x, y, sprite->Width, sprite->Height);
+	sprite->Visible = 1;
+}
+
+void SSD1306_Sprite_Hide(SSD1306_SPRITE_t* sprite) {
+	if (!sprite->Visible) {
+		return;
+	}
+
+	if (sprite->Mode == SSD1306_SPRITE_XOR) {
+		/* Second XOR restores background */
+		SSD1306_DrawBitmap(sprite->X, sprite->Y, sprite->Width, sprite->Height, sprite->bitmap, NULL, SSD1306_ROP_XOR);
+	} else {
+		SSD1306_DrawBitmap(sprite->X, sprite->Y, sprite->Width, sprite->Height, sprite->save, NULL, SSD1306_ROP_COPY);
+	}
+
+	SSD1306_MarkDirty(sprite->X, sprite->Y, sprite->Width, sprite->Height);
+	sprite->Visible = 0;
+}
+
+void SSD1306_Sprite_Move(SSD1306_SPRITE_t* sprite, int16_t x, int16_t y) {
+	if (sprite->Visible && sprite->X == x && sprite->Y == y) {
+		/* Nothing to do */
+		return;
+	}
+
+	SSD1306_Sprite_Hide(sprite);
+	SSD1306_Sprite_Show(sprite, x, y);
+}
@@ -0,0 +1,91 @@
+/*
+ * ssd1306_sprite.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ */
+
+#ifndef SSD1306_SPRITE_H_
+#define SSD1306_SPRITE_H_
+
+/**
+ * Sprite layer on top of SSD1306 STM buffer.
+ *
+ * Sprite is a small page-major bitmap (same layout as @ref SSD1306_DrawBitmap) drawn over the background.
+ * Moving a sprite erases it from the old position, draws it at the new one and marks only
+ * both bounding boxes with @ref SSD1306_MarkDirty, so @ref SSD1306_UpdateDirty sends just those columns.
+ *
+ * Two render modes are supported:
+ *  - XOR: sprite is toggled in and out, no extra RAM, background shows through inverted
+ *  - Save-under: background below sprite is saved before drawing and copied back on erase
+ *
+ * Overlapping sprites must be hidden in reverse order of showing them.
+ */
+
+#include "ssd1306.h"
+
+/**
+ * @brief  Sprite render modes
+ */
+typedef enum {
+	SSD1306_SPRITE_XOR = 0x00,  /*!< Sprite is XORed with background */
+	SSD1306_SPRITE_SAVE_UNDER   /*!< Background is saved and restored, sprite pixels replace background */
+} SSD1306_SPRITE_MODE_t;
+
+/**
+ * @brief  Sprite structure
+ */
+typedef struct {
+	int16_t X;                   /*!< Current top left X location */
+	int16_t Y;                   /*!< Current top left Y location */
+	uint8_t Width;               /*!< Sprite width in pixels */
+	uint8_t Height;              /*!< Sprite height in pixels */
+	const uint8_t* bitmap;       /*!< Page-major sprite bitmap */
+	const uint8_t* mask;         /*!< Page-major mask for save-under mode, NULL for opaque sprite */
+	uint8_t* save;               /*!< Save-under buffer of Width * ((Height + 7) / 8) bytes, unused in XOR mode */
+	SSD1306_SPRITE_MODE_t Mode;  /*!< Render mode */
+	uint8_t Visible;             /*!< Sprite is currently drawn in STM buffer */
+} SSD1306_SPRITE_t;
+
+/**
+ * @brief  Initializes sprite, sprite is hidden after that
+ * @param  *sprite: Pointer to @ref SSD1306_SPRITE_t structure to initialize
+ * @param  *bitmap: Page-major sprite bitmap
+ * @param  *mask: Page-major mask, only used in save-under mode. NULL makes sprite opaque
+ * @param  w: Sprite width in units of pixels
+ * @param  h: Sprite height in units of pixels
+ * @param  mode: Render mode. This parameter can be a value of @ref SSD1306_SPRITE_MODE_t enumeration
+ * @param  *save: Save-under buffer of w * ((h + 7) / 8) bytes, NULL in XOR mode
+ * @retval None
+ */
+void SSD1306_Sprite_Init(SSD1306_SPRITE_t* sprite, const uint8_t* bitmap, const uint8_t* mask, uint8_t w, uint8_t h, SSD1306_SPRITE_MODE_t mode, uint8_t* save);
+
+/**
+ * @brief  Draws sprite at desired location and marks its area dirty
+ * @note   @ref SSD1306_UpdateDirty() must be called after that in order to see updated LCD screen
+ * @param  *sprite: Pointer to @ref SSD1306_SPRITE_t structure
+ * @param  x: Top left X location, may be partially outside of screen
+ * @param  y: Top left Y location, may be partially outside of screen
+ * @retval None
+ */
+void SSD1306_Sprite_Show(SSD1306_SPRITE_t* sprite, int16_t x, int16_t y);
+
+/**
+ * @brief  Erases sprite and marks its area dirty
+ * @note   @ref SSD1306_UpdateDirty() must be called after that in order to see updated LCD screen
+ * @param  *sprite: Pointer to @ref SSD1306_SPRITE_t structure
+ * @retval None
+ */
+void SSD1306_Sprite_Hide(SSD1306_SPRITE_t* sprite);
+
+/**
+ * @brief  Moves sprite to new location, only old and new areas are touched and marked dirty
+ * @note   @ref SSD1306_UpdateDirty() must be called after that in order to see updated LCD screen
+ * @param  *sprite: Pointer to @ref SSD1306_SPRITE_t structure
+ * @param  x: New top left X location
+ * @param  y: New top left Y location
+ * @retval None
+ */
+void SSD1306_Sprite_Move(SSD1306_SPRITE_t* sprite, int16_t x, int16_t y);
+
+#endif /* SSD1306_SPRITE_H_ */
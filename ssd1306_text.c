@@ -0,0 +1,355 @@
+/*
+ * ssd1306_text.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ */
+#include "ssd1306_text.h"
+
+/* Private line structure */
+typedef struct {
+	const char* start;   /* First byte of line */
+	const char* end;     /* First byte behind last glyph of line */
+	const char* next;    /* First byte of next line, NULL at the end of text */
+	uint16_t count;      /* Glyphs in line */
+	uint8_t truncated;   /* Line did not fit and was cut */
+} SSD1306_LINE_t;
+
+uint32_t SSD1306_Utf8Next(const char** str) {
+	const uint8_t* s = (const uint8_t*)*str;
+	uint32_t cp;
+	uint8_t n, i;
+
+	if (*s == 0) {
+		/* End of string */
+		return 0;
+	}
+
+	if (*s < 0x80) {
+		*str += 1;
+		return *s;
+	} else if ((*s & 0xE0) == 0xC0) {
+		cp = *s & 0x1F;
+		n = 1;
+	} else if ((*s & 0xF0) == 0xE0) {
+		cp = *s & 0x0F;
+		n = 2;
+	} else if ((*s & 0xF8) == 0xF0) {
+		cp = *s & 0x07;
+		n = 3;
+	} else {
+		*str += 1;
+		return 0xFFFD;
+	}
+
+	for (i = 1; i <= n; i++) {
+		if ((s[i] & 0xC0) != 0x80) {
+			/* Broken sequence */
+			*str += 1;
+			return 0xFFFD;
+		}
+		cp = (cp << 6) | (s[i] & 0x3F);
+	}
+
+	*str += n + 1;
+	return cp;
+}
+
+/* Finds next line of at most max glyphs */
+static void ssd1306_Text_Line(const char* s, uint16_t max, uint8_t wrap, SSD1306_LINE_t* line) {
+	const char *p = s, *prev;
+	const char* space = NULL;
+	uint16_t n = 0, spaceCount = 0;
+	uint32_t cp;
+
+	line->start = s;
+	line->truncated = 0;
+
+	for (;;) {
+		prev = p;
+		cp = SSD1306_Utf8Next(&p);
+		if (cp == 0) {
+			line->end = prev;
+			line->next = NULL;
+			break;
+		}
+		if (cp == '\n') {
+			line->end = prev;
+			line->next = p;
+			break;
+		}
+		if (cp == '\r') {
+			continue;
+		}
+
+		if (n == max) {
+			/* Line is full */
+			if (!wrap) {
+				/* Skip rest of the line */
+				line->end = prev;
+				line->truncated = 1;
+				while (cp && cp != '\n') {
+					cp = SSD1306_Utf8Next(&p);
+				}
+				line->next = cp ? p : NULL;
+			} else if (cp == ' ') {
+				/* Break exactly at space */
+				line->end = prev;
+				line->next = p;
+			} else if (space) {
+				/* Break at last space */
+				line->end = space;
+				line->next = space + 1;
+				n = spaceCount;
+			} else {
+				/* Word longer than line, break inside it */
+				line->end = prev;
+				line->next = prev;
+			}
+
+			/* Next line does not start with spaces */
+			if (wrap) {
+				while (*line->next == ' ') {
+					line->next++;
+				}
+				if (*line->next == 0) {
+					line->next = NULL;
+				}
+			}
+			break;
+		}
+
+		if (cp == ' ') {
+			space = prev;
+			spaceCount = n;
+		}
+		n++;
+	}
+
+	line->count = n;
+}
+
+/* Lays text into box, draws it when draw is set */
+static uint16_t ssd1306_Text_Layout(const SSD1306_TEXTBOX_t* box, const char* str, SSD1306_COLOR_t color, uint8_t draw, FONTS_SIZE_t* size) {
+	FontDef_t* font = box->Font;
+	uint16_t max = box->Width / font->FontWidth;
+	uint16_t maxLines = (box->Height + box->LineSpacing) / (font->FontHeight + box->LineSpacing);
+	uint16_t lines = 0, width, dots, n;
+	int16_t x, y = box->Y;
+	SSD1306_LINE_t line;
+	const char* p;
+	uint32_t cp;
+
+	if (size) {
+		size->Length = 0;
+		size->Height = 0;
+	}
+
+	if (!max) {
+		/* Not even one glyph fits */
+		return 0;
+	}
+
+	while (str && lines < maxLines) {
+		ssd1306_Text_Line(str, max, box->Flags & SSD1306_TEXT_WRAP, &line);
+
+		/* Truncated line or last line with more text to come gets ellipsis */
+		dots = 0;
+		if (
+			(box->Flags & SSD1306_TEXT_ELLIPSIS) &&
+			(line.truncated || (lines == maxLines - 1 && line.next))
+		) {
+			dots = max < 3 ? max : 3;
+			if (line.count + dots > max) {
+				line.count = max - dots;
+			}
+		}
+
+		/* Measured once, then aligned */
+		width = (line.count + dots) * font->FontWidth;
+		if (box->Align == SSD1306_ALIGN_CENTER) {
+			x = box->X + (box->Width - width) / 2;
+		} else if (box->Align == SSD1306_ALIGN_RIGHT) {
+			x = box->X + box->Width - width;
+		} else {
+			x = box->X;
+		}
+
+		if (draw) {
+			/* Glyph run */
+			SSD1306_GotoXY(x, y);
+			p = line.start;
+			for (n = 0; n < line.count && p < line.end; ) {
+				cp = SSD1306_Utf8Next(&p);
+				if (cp == '\r') {
+					continue;
+				}
+				SSD1306_PutcUnicode(cp, font, color);
+				n++;
+			}
+			for (n = 0; n < dots; n++) {
+				SSD1306_Putc('.', font, color);
+			}
+		}
+
+		if (size && width > size->Length) {
+			size->Length = width;
+		}
+
+		lines++;
+		y += font->FontHeight + box->LineSpacing;
+		str = line.next;
+	}
+
+	if (size && lines) {
+		size->Height = lines * (font->FontHeight + box->LineSpacing) - box->LineSpacing;
+	}
+
+	return lines;
+}
+
+uint16_t SSD1306_DrawText(const SSD1306_TEXTBOX_t* box, const char* str, SSD1306_COLOR_t color) {
+	return ssd1306_Text_Layout(box, str, color, 1, NULL);
+}
+
+uint16_t SSD1306_MeasureText(const SSD1306_TEXTBOX_t* box, const char* str, FONTS_SIZE_t* size) {
+	return ssd1306_Text_Layout(box, str, SSD1306_COLOR_WHITE, 0, size);
+}
+
+/* Divides by 10 with multiply by reciprocal, exact for every 32-bit value */
+static uint32_t ssd1306_Num_Div10(uint32_t v) {
+	return (uint32_t)(((uint64_t)v * 0xCCCCCCCDu) >> 35);
+}
+
+/* Pads and aligns digits, digits are in reverse order in rev */
+static uint8_t ssd1306_Num_Field(char* str, const char* rev, uint8_t n, char sign, const SSD1306_NUMFMT_t* fmt) {
+	uint8_t width = fmt->Width > SSD1306_NUM_MAX ? SSD1306_NUM_MAX : fmt->Width;
+	uint8_t len = n + (sign != 0);
+	uint8_t pad, left, i = 0;
+
+	if (!width) {
+		width = len > SSD1306_NUM_MAX ? SSD1306_NUM_MAX : len;
+	}
+	if (len > width) {
+		/* Does not fit */
+		memset(str, '#', width);
+		str[width] = 0;
+		return width;
+	}
+
+	pad = width - len;
+	if (fmt->Align == SSD1306_ALIGN_LEFT) {
+		left = 0;
+	} else if (fmt->Align == SSD1306_ALIGN_CENTER) {
+		left = pad / 2;
+	} else {
+		left = pad;
+	}
+
+	if (fmt->Align == SSD1306_ALIGN_RIGHT && (fmt->Flags & SSD1306_NUM_ZEROS)) {
+		/* Zeros go behind sign */
+		if (sign) {
+			str[i++] = sign;
+		}
+		while (left--) {
+			str[i++] = '0';
+		}
+	} else {
+		while (left--) {
+			str[i++] = ' ';
+		}
+		if (sign) {
+			str[i++] = sign;
+		}
+	}
+	while (n) {
+		str[i++] = rev[--n];
+	}
+	while (i < width) {
+		str[i++] = ' ';
+	}
+	str[i] = 0;
+
+	return i;
+}
+
+/* Formats decimal magnitude with point before last decimals digits */
+static uint8_t ssd1306_Num_Decimal(char* str, int32_t value, uint8_t decimals, const SSD1306_NUMFMT_t* fmt) {
+	uint32_t v = value < 0 ? 0 - (uint32_t)value : (uint32_t)value;
+	uint32_t q;
+	char rev[SSD1306_NUM_MAX + 1];
+	char sign = 0;
+	uint8_t n = 0, digits = 0;
+
+	if (decimals > 9) {
+		decimals = 9;
+	}
+	if (value < 0) {
+		sign = '-';
+	} else if (fmt->Flags & SSD1306_NUM_PLUS) {
+		sign = '+';
+	}
+
+	/* At least one digit in front of point, sign takes one place of leading zeros */
+	do {
+		q = ssd1306_Num_Div10(v);
+		rev[n++] = '0' + (v - q * 10);
+		v = q;
+		if (++digits == decimals) {
+			rev[n++] = '.';
+		}
+	} while ((v || digits <= decimals || digits < fmt->Digits) && n < SSD1306_NUM_MAX - (sign != 0));
+
+	return ssd1306_Num_Field(str, rev, n, sign, fmt);
+}
+
+uint8_t SSD1306_FormatInt(char* str, int32_t value, const SSD1306_NUMFMT_t* fmt) {
+	return ssd1306_Num_Decimal(str, value, 0, fmt);
+}
+
+uint8_t SSD1306_FormatFixed(char* str, int32_t value, const SSD1306_NUMFMT_t* fmt) {
+	return ssd1306_Num_Decimal(str, value, fmt->Decimals, fmt);
+}
+
+uint8_t SSD1306_FormatHex(char* str, uint32_t value, const SSD1306_NUMFMT_t* fmt) {
+	const char* hex = (fmt->Flags & SSD1306_NUM_LOWER) ? "0123456789abcdef" : "0123456789ABCDEF";
+	char rev[8];
+	uint8_t n = 0;
+
+	do {
+		rev[n++] = hex[value & 0x0F];
+		value >>= 4;
+	} while ((value || n < fmt->Digits) && n < sizeof(rev));
+
+	return ssd1306_Num_Field(str, rev, n, 0, fmt);
+}
+
+/* Sends formatted glyphs to renderer */
+static uint16_t ssd1306_Num_Draw(uint16_t x, uint16_t y, const char* str, uint8_t len, FontDef_t* Font, SSD1306_COLOR_t color) {
+	uint8_t i;
+
+	SSD1306_GotoXY(x, y);
+	for (i = 0; i < len; i++) {
+		SSD1306_Putc(str[i], Font, color);
+	}
+
+	return len * Font->FontWidth;
+}
+
+uint16_t SSD1306_DrawInt(uint16_t x, uint16_t y, int32_t value, const SSD1306_NUMFMT_t* fmt, FontDef_t* Font, SSD1306_COLOR_t color) {
+	char str[SSD1306_NUM_MAX + 1];
+
+	return ssd1306_Num_Draw(x, y, str, SSD1306_FormatInt(str, value, fmt), Font, color);
+}
+
+uint16_t SSD1306_DrawFixed(uint16_t x, uint16_t y, int32_t value, const SSD1306_NUMFMT_t* fmt, FontDef_t* Font, SSD1306_COLOR_t color) {
+	char str[SSD1306_NUM_MAX + 1];
+
+	return ssd1306_Num_Draw(x, y, str, SSD1306_FormatFixed(str, value, fmt), Font, color);
+}
+
+uint16_t SSD1306_DrawHex(uint16_t x, uint16_t y, uint32_t value, const SSD1306_NUMFMT_t* fmt, FontDef_t* Font, SSD1306_COLOR_t color) {
+	char str[SSD1306_NUM_MAX + 1];
+
+	return ssd1306_Num_Draw(x, y, str, SSD1306_FormatHex(str, value, fmt), Font, color);
+}
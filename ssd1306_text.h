@@ -0,0 +1,168 @@
+/*
+ * ssd1306_text.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ */
+
+#ifndef SSD1306_TEXT_H_
+#define SSD1306_TEXT_H_
+
+/**
+ * Text layout on top of @ref SSD1306_Putc.
+ *
+ * Text is UTF-8 and is laid into a box: lines are broken at '\n', wrapped at spaces when
+ * SSD1306_TEXT_WRAP is set, and every line is aligned left, center or right inside the box.
+ * Lines or text which do not fit end with "..." when SSD1306_TEXT_ELLIPSIS is set.
+ *
+ * Every line is measured once and then its glyphs are emitted in one pass,
+ * no string is measured or drawn twice.
+ *
+ * Numbers are formatted without printf: integers, fixed-point values and hex are converted
+ * with multiply by reciprocal instead of division, padded and aligned in a fixed field and
+ * their glyphs are sent straight to @ref SSD1306_Putc.
+ */
+
+#include "ssd1306.h"
+
+/* Layout flags */
+#define SSD1306_TEXT_WRAP        0x01  /*!< Wrap long lines at spaces, or inside word when it is longer than box */
+#define SSD1306_TEXT_ELLIPSIS    0x02  /*!< End truncated line or text with "..." */
+
+/* Number format flags */
+#define SSD1306_NUM_ZEROS        0x01  /*!< Pad right aligned number with zeros behind sign instead of spaces */
+#define SSD1306_NUM_PLUS         0x02  /*!< Show '+' in front of positive numbers */
+#define SSD1306_NUM_LOWER        0x04  /*!< Hex digits a-f instead of A-F */
+
+/* Longest formatted number in characters, wider field is limited to it */
+#define SSD1306_NUM_MAX          16
+
+/**
+ * @brief  Horizontal alignment of lines inside box
+ */
+typedef enum {
+	SSD1306_ALIGN_LEFT = 0x00,
+	SSD1306_ALIGN_CENTER,
+	SSD1306_ALIGN_RIGHT
+} SSD1306_ALIGN_t;
+
+/**
+ * @brief  Text box structure
+ */
+typedef struct {
+	int16_t X;               /*!< Top left X location */
+	int16_t Y;               /*!< Top left Y location */
+	uint16_t Width;          /*!< Box width in pixels */
+	uint16_t Height;         /*!< Box height in pixels */
+	FontDef_t* Font;         /*!< Pointer to @ref FontDef_t font */
+	SSD1306_ALIGN_t Align;   /*!< Alignment of lines */
+	uint8_t Flags;           /*!< SSD1306_TEXT_WRAP and SSD1306_TEXT_ELLIPSIS */
+	uint8_t LineSpacing;     /*!< Extra pixels between lines */
+} SSD1306_TEXTBOX_t;
+
+/**
+ * @brief  Number format structure
+ */
+typedef struct {
+	uint8_t Width;           /*!< Field width in characters, 0 for length of number. Number which does not fit shows '#' */
+	SSD1306_ALIGN_t Align;   /*!< Alignment of number inside field */
+	uint8_t Flags;           /*!< SSD1306_NUM_ZEROS, SSD1306_NUM_PLUS and SSD1306_NUM_LOWER */
+	uint8_t Digits;          /*!< Minimum digits, shorter number gets leading zeros */
+	uint8_t Decimals;        /*!< Digits behind decimal point of fixed-point numbers */
+} SSD1306_NUMFMT_t;
+
+/**
+ * @brief  Decodes next UTF-8 character
+ * @note   Invalid sequences decode to U+FFFD and skip one byte
+ * @param  **str: Pointer to string pointer, it is moved behind decoded character
+ * @retval Unicode code point, 0 at the end of string
+ */
+uint32_t SSD1306_Utf8Next(const char** str);
+
+/**
+ * @brief  Lays text into box and draws it
+ * @note   @ref SSD1306_UpdateScreen() must be called after that in order to see updated LCD screen
+ * @param  *box: Pointer to @ref SSD1306_TEXTBOX_t structure
+ * @param  *str: UTF-8 string
+ * @param  color: Color used for drawing. This parameter can be a value of @ref SSD1306_COLOR_t enumeration
+ * @retval Number of lines drawn
+ */
+uint16_t SSD1306_DrawText(const SSD1306_TEXTBOX_t* box, const char* str, SSD1306_COLOR_t color);
+
+/**
+ * @brief  Lays text into box without drawing it
+ * @param  *box: Pointer to @ref SSD1306_TEXTBOX_t structure
+ * @param  *str: UTF-8 string
+ * @param  *size: Pointer to @ref FONTS_SIZE_t where width of longest line and height of all lines are saved
+ * @retval Number of lines
+ */
+uint16_t SSD1306_MeasureText(const SSD1306_TEXTBOX_t* box, const char* str, FONTS_SIZE_t* size);
+
+/**
+ * @brief  Formats decimal integer
+ * @param  *str: Buffer of at least SSD1306_NUM_MAX + 1 characters, result is terminated
+ * @param  value: Number to format
+ * @param  *fmt: Pointer to @ref SSD1306_NUMFMT_t format, Decimals is not used
+ * @retval Number of characters
+ */
+uint8_t SSD1306_FormatInt(char* str, int32_t value, const SSD1306_NUMFMT_t* fmt);
+
+/**
+ * @brief  Formats fixed-point number
+ * @note   value is number multiplied by 10 ^ fmt->Decimals, -1234 with 2 decimals shows "-12.34"
+ * @param  *str: Buffer of at least SSD1306_NUM_MAX + 1 characters, result is terminated
+ * @param  value: Scaled number to format
+ * @param  *fmt: Pointer to @ref SSD1306_NUMFMT_t format
+ * @retval Number of characters
+ */
+uint8_t SSD1306_FormatFixed(char* str, int32_t value, const SSD1306_NUMFMT_t* fmt);
+
+/**
+ * @brief  Formats hexadecimal number
+ * @param  *str: Buffer of at least SSD1306_NUM_MAX + 1 characters, result is terminated
+ * @param  value: Number to format
+ * @param  *fmt: Pointer to @ref SSD1306_NUMFMT_t format, Decimals and SSD1306_NUM_PLUS are not used
+ * @retval Number of characters
+ */
+uint8_t SSD1306_FormatHex(char* str, uint32_t value, const SSD1306_NUMFMT_t* fmt);
+
+/**
+ * @brief  Draws decimal integer
+ * @note   @ref SSD1306_UpdateScreen() must be called after that in order to see updated LCD screen
+ * @param  x: Top left X location
+ * @param  y: Top left Y location
+ * @param  value: Number to draw
+ * @param  *fmt: Pointer to @ref SSD1306_NUMFMT_t format
+ * @param  *Font: Pointer to @ref FontDef_t structure with used font
+ * @param  color: Color used for drawing. This parameter can be a value of @ref SSD1306_COLOR_t enumeration
+ * @retval Width of drawn field in pixels
+ */
+uint16_t SSD1306_DrawInt(uint16_t x, uint16_t y, int32_t value, const SSD1306_NUMFMT_t* fmt, FontDef_t* Font, SSD1306_COLOR_t color);
+
+/**
+ * @brief  Draws fixed-point number, see @ref SSD1306_FormatFixed
+ * @note   @ref SSD1306_UpdateScreen() must be called after that in order to see updated LCD screen
+ * @param  x: Top left X location
+ * @param  y: Top left Y location
+ * @param  value: Number multiplied by 10 ^ fmt->Decimals
+ * @param  *fmt: Pointer to @ref SSD1306_NUMFMT_t format
+ * @param  *Font: Pointer to @ref FontDef_t structure with used font
+ * @param  color: Color used for drawing. This parameter can be a value of @ref SSD1306_COLOR_t enumeration
+ * @retval Width of drawn field in pixels
+ */
+uint16_t SSD1306_DrawFixed(uint16_t x, uint16_t y, int32_t value, const SSD1306_NUMFMT_t* fmt, FontDef_t* Font, SSD1306_COLOR_t color);
+
+/**
+ * @brief  Draws hexadecimal number
+ * @note   @ref SSD1306_UpdateScreen() must be called after that in order to see updated LCD screen
+ * @param  x: Top left X location
+ * @param  y: Top left Y location
+ * @param  value: Number to draw
+ * @param  *fmt: Pointer to @ref SSD1306_NUMFMT_t format
+ * @param  *Font: Pointer to @ref FontDef_t structure with used font
+ * @param  color: Color used for drawing. This parameter can be a value of @ref SSD1306_COLOR_t enumeration
+ * @retval Width of drawn field in pixels
+ */
+uint16_t SSD1306_DrawHex(uint16_t x, uint16_t y, uint32_t value, const SSD1306_NUMFMT_t* fmt, FontDef_t* Font, SSD1306_COLOR_t color);
+
+#endif /* SSD1306_TEXT_H_ */
@@ -0,0 +1,134 @@
+/*
+ * ssd1306_transport.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ */
+
+#ifndef SSD1306_TRANSPORT_H_
+#define SSD1306_TRANSPORT_H_
+
+/**
+ * Transport between SSD1306 core and the LCD.
+ *
+ * Display core only sends command bursts and data bursts, it does not know which bus is used.
+ * Backend is chosen at compile time with SSD1306_TRANSPORT:
+ *  - SSD1306_TRANSPORT_I2C: built on I2C_Interface.h, control byte 0x00/0x40 selects commands or data.
+ *    Asynchronous data is sent by the interrupt driven master of I2C_Interface.h
+ *  - SSD1306_TRANSPORT_SPI: 4-wire SPI1 (SCK PA5, MOSI PA7) plus D/C, CS and RES pins.
+ *    Asynchronous data goes through DMA1 channel 3
+ *
+ * Pinout for SPI
+ *
+SSD1306    |STM32F10x    |DESCRIPTION
+D0         |PA5          |Serial clock
+D1         |PA7          |Serial data
+DC         |PA3          |Data/command select, see SSD1306_SPI_DC_PIN
+CS         |PA4          |Chip select, see SSD1306_SPI_CS_PIN
+RES        |PA2          |Reset, see SSD1306_SPI_RES_PIN
+ */
+
+#include "stdint.h"
+
+/* Backends */
+#define SSD1306_TRANSPORT_I2C    0
+#define SSD1306_TRANSPORT_SPI    1
+
+/* Selected backend */
+#ifndef SSD1306_TRANSPORT
+#define SSD1306_TRANSPORT        SSD1306_TRANSPORT_I2C
+#endif
+
+/* I2C settings */
+#ifndef SSD1306_I2C
+#define SSD1306_I2C              I2C1
+#endif
+
+/* I2C address */
+#ifndef SSD1306_I2C_ADDR
+#define SSD1306_I2C_ADDR         0x78
+//#define SSD1306_I2C_ADDR       0x7A
+#endif
+
+/* SPI settings, pins of port A from 0 to 7 */
+#ifndef SSD1306_SPI_DC_PIN
+#define SSD1306_SPI_DC_PIN       3
+#endif
+#ifndef SSD1306_SPI_CS_PIN
+#define SSD1306_SPI_CS_PIN       4
+#endif
+#ifndef SSD1306_SPI_RES_PIN
+#define SSD1306_SPI_RES_PIN      2
+#endif
+/* SPI1 baud rate prescaler bits (BR[2:0] of CR1), 2 gives 72 MHz / 8 = 9 MHz */
+#ifndef SSD1306_SPI_BR
+#define SSD1306_SPI_BR           2
+#endif
+
+/**
+ * @brief  Completion callback of @ref SSD1306_Transport_DataAsync
+ */
+typedef void (*SSD1306_TRANSPORT_DONE_t)(void);
+
+/**
+ * @brief  Initializes bus and resets LCD where backend can
+ * @param  None
+ * @retval 1 when LCD answered or backend cannot tell, 0 when LCD was not detected
+ */
+uint8_t SSD1306_Transport_Init(void);
+
+/**
+ * @brief  Sends command bytes as one burst
+ * @param  *cmd: Command bytes, including their parameters
+ * @param  count: Number of bytes
+ * @retval None
+ */
+void SSD1306_Transport_Command(const uint8_t* cmd, uint16_t count);
+
+/**
+ * @brief  Sends display data as one burst and waits until it is sent
+ * @param  *data: Data bytes for LCD memory
+ * @param  count: Number of bytes
+ * @retval None
+ */
+void SSD1306_Transport_Data(const uint8_t* data, uint16_t count);
+
+/**
+ * @brief  Starts sending display data in background
+ * @note   Data must stay unchanged until done is called. done may be called from interrupt
+ * @param  *data: Data bytes for LCD memory
+ * @param  count: Number of bytes
+ * @param  done: Completion callback, may be NULL
+ * @retval None
+ */
+void SSD1306_Transport_DataAsync(const uint8_t* data, uint16_t count, SSD1306_TRANSPORT_DONE_t done);
+
+/**
+ * @brief  Checks if background transfer is still running
+ * @param  None
+ * @retval 1 when busy, 0 otherwise
+ */
+uint8_t SSD1306_Transport_Busy(void);
+
+/**
+ * @brief  Opens data burst whose bytes are produced one by one with @ref SSD1306_Transport_Put
+ * @param  None
+ * @retval None
+ */
+void SSD1306_Transport_Begin(void);
+
+/**
+ * @brief  Sends one byte of burst opened by @ref SSD1306_Transport_Begin
+ * @param  data: Data byte
+ * @retval None
+ */
+void SSD1306_Transport_Put(uint8_t data);
+
+/**
+ * @brief  Closes burst opened by @ref SSD1306_Transport_Begin
+ * @param  None
+ * @retval None
+ */
+void SSD1306_Transport_End(void);
+
+#endif /* SSD1306_TRANSPORT_H_ */
@@ -0,0 +1,79 @@
+/*
+ * ssd1306_transport_i2c.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ */
+#include "ssd1306_transport.h"
+
+#if SSD1306_TRANSPORT == SSD1306_TRANSPORT_I2C
+
+/*LIB Layer*/
+#include "stdtypes.h"
+/*MCAL*/
+#include "I2C_Interface.h"
+
+/* Control bytes */
+#define SSD1306_I2C_COMMAND      0x00
+#define SSD1306_I2C_DATA         0x40
+
+/* Completion callback of background data burst */
+static SSD1306_TRANSPORT_DONE_t ssd1306_I2C_Done;
+
+/* End of background burst, called from I2C interrupt */
+static void ssd1306_I2C_Complete(void* context, u8 error) {
+	(void)context;
+	(void)error;
+	if (ssd1306_I2C_Done) {
+		ssd1306_I2C_Done();
+	}
+}
+
+uint8_t SSD1306_Transport_Init(void) {
+	I2C_Init(SSD1306_I2C);
+
+	/* Check if LCD connected to I2C */
+	return I2C_IsDeviceConnected(SSD1306_I2C, SSD1306_I2C_ADDR);
+}
+
+void SSD1306_Transport_Command(const uint8_t* cmd, uint16_t count) {
+	while (I2C_Busy(SSD1306_I2C))
+		;
+	I2C_WriteMulti(SSD1306_I2C, SSD1306_I2C_ADDR, SSD1306_I2C_COMMAND, (u8 *)cmd, count);
+}
+
+void SSD1306_Transport_Data(const uint8_t* data, uint16_t count) {
+	while (I2C_Busy(SSD1306_I2C))
+		;
+	I2C_WriteMulti(SSD1306_I2C, SSD1306_I2C_ADDR, SSD1306_I2C_DATA, (u8 *)data, count);
+}
+
+void SSD1306_Transport_DataAsync(const uint8_t* data, uint16_t count, SSD1306_TRANSPORT_DONE_t done) {
+	while (I2C_Busy(SSD1306_I2C))
+		;
+
+	/* Control byte goes out as register byte, interrupts send the rest */
+	ssd1306_I2C_Done = done;
+	I2C_WriteMultiAsync(SSD1306_I2C, SSD1306_I2C_ADDR, SSD1306_I2C_DATA, data, count, ssd1306_I2C_Complete, 0);
+}
+
+uint8_t SSD1306_Transport_Busy(void) {
+	return I2C_Busy(SSD1306_I2C);
+}
+
+void SSD1306_Transport_Begin(void) {
+	while (I2C_Busy(SSD1306_I2C))
+		;
+	I2C_Start(SSD1306_I2C, SSD1306_I2C_ADDR, I2C_TRANSMITTER_MODE, NACK);
+	I2C_WriteData(SSD1306_I2C, SSD1306_I2C_DATA);
+}
+
+void SSD1306_Transport_Put(uint8_t data) {
+	I2C_WriteData(SSD1306_I2C, data);
+}
+
+void SSD1306_Transport_End(void) {
+	I2C_Stop(SSD1306_I2C);
+}
+
+#endif /* SSD1306_TRANSPORT == SSD1306_TRANSPORT_I2C */
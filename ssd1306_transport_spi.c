@@ -0,0 +1,168 @@
+/*
+ * ssd1306_transport_spi.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Alaa Elkhateeb
+ */
+#include "ssd1306_transport.h"
+
+#if SSD1306_TRANSPORT == SSD1306_TRANSPORT_SPI
+
+#include "stm32f1xx.h"
+
+/* Control pins of port A */
+#define SSD1306_SPI_HIGH(pin)    (GPIOA->BSRR = 1UL << (pin))
+#define SSD1306_SPI_LOW(pin)     (GPIOA->BRR = 1UL << (pin))
+
+/* Port A pin modes, 50 MHz */
+#define SSD1306_SPI_MODE_OUT     0x3
+#define SSD1306_SPI_MODE_AF      0xB
+
+/* Private variables */
+static volatile uint8_t ssd1306_SPI_Busy;
+static SSD1306_TRANSPORT_DONE_t ssd1306_SPI_Done;
+
+/* Sets mode of port A pin from 0 to 7 */
+static void ssd1306_SPI_PinMode(uint8_t pin, uint32_t mode) {
+	GPIOA->CRL = (GPIOA->CRL & ~(0xFUL << (pin * 4))) | (mode << (pin * 4));
+}
+
+/* Waits until last byte left shift register */
+static void ssd1306_SPI_Flush(void) {
+	while (!(SPI1->SR & SPI_SR_TXE))
+		;
+	while (SPI1->SR & SPI_SR_BSY)
+		;
+}
+
+/* Sends burst, D/C pin selects commands (0) or data (1) */
+static void ssd1306_SPI_Send(const uint8_t* p, uint16_t count, uint8_t dc) {
+	/* DMA transfer still running */
+	while (ssd1306_SPI_Busy)
+		;
+
+	if (dc) {
+		SSD1306_SPI_HIGH(SSD1306_SPI_DC_PIN);
+	} else {
+		SSD1306_SPI_LOW(SSD1306_SPI_DC_PIN);
+	}
+	SSD1306_SPI_LOW(SSD1306_SPI_CS_PIN);
+
+	while (count--) {
+		while (!(SPI1->SR & SPI_SR_TXE))
+			;
+		SPI1->DR = *p++;
+	}
+
+	/* D/C and CS may change only after last bit */
+	ssd1306_SPI_Flush();
+	SSD1306_SPI_HIGH(SSD1306_SPI_CS_PIN);
+}
+
+uint8_t SSD1306_Transport_Init(void) {
+	volatile uint32_t p;
+
+	RCC->APB2ENR |= RCC_APB2ENR_IOPAEN | RCC_APB2ENR_SPI1EN;
+	RCC->AHBENR |= RCC_AHBENR_DMA1EN;
+
+	/* SCK and MOSI driven by SPI1, control pins are plain outputs */
+	ssd1306_SPI_PinMode(5, SSD1306_SPI_MODE_AF);
+	ssd1306_SPI_PinMode(7, SSD1306_SPI_MODE_AF);
+	ssd1306_SPI_PinMode(SSD1306_SPI_DC_PIN, SSD1306_SPI_MODE_OUT);
+	ssd1306_SPI_PinMode(SSD1306_SPI_CS_PIN, SSD1306_SPI_MODE_OUT);
+	ssd1306_SPI_PinMode(SSD1306_SPI_RES_PIN, SSD1306_SPI_MODE_OUT);
+	SSD1306_SPI_HIGH(SSD1306_SPI_CS_PIN);
+
+	/* Master, mode 0, software slave select, 8 bit frames */
+	SPI1->CR1 = SPI_CR1_MSTR | SPI_CR1_SSM | SPI_CR1_SSI | (SSD1306_SPI_BR << 3);
+	SPI1->CR1 |= SPI_CR1_SPE;
+
+	/* Reset pulse, LCD needs at least 3 us */
+	SSD1306_SPI_LOW(SSD1306_SPI_RES_PIN);
+	for (p = 0; p < 1000; p++)
+		;
+	SSD1306_SPI_HIGH(SSD1306_SPI_RES_PIN);
+	for (p = 0; p < 1000; p++)
+		;
+
+	NVIC_EnableIRQ(DMA1_Channel3_IRQn);
+
+	/* Write only bus, LCD cannot be detected */
+	return 1;
+}
+
+void SSD1306_Transport_Command(const uint8_t* cmd, uint16_t count) {
+	ssd1306_SPI_Send(cmd, count, 0);
+}
+
+void SSD1306_Transport_Data(const uint8_t* data, uint16_t count) {
+	ssd1306_SPI_Send(data, count, 1);
+}
+
+void SSD1306_Transport_DataAsync(const uint8_t* data, uint16_t count, SSD1306_TRANSPORT_DONE_t done) {
+	while (ssd1306_SPI_Busy)
+		;
+
+	if (!count) {
+		if (done) {
+			done();
+		}
+		return;
+	}
+
+	ssd1306_SPI_Done = done;
+	ssd1306_SPI_Busy = 1;
+
+	SSD1306_SPI_HIGH(SSD1306_SPI_DC_PIN);
+	SSD1306_SPI_LOW(SSD1306_SPI_CS_PIN);
+
+	/* SPI1 TX request is served by DMA1 channel 3 */
+	DMA1_Channel3->CCR = 0;
+	DMA1_Channel3->CPAR = (uint32_t)&SPI1->DR;
+	DMA1_Channel3->CMAR = (uint32_t)data;
+	DMA1_Channel3->CNDTR = count;
+	DMA1_Channel3->CCR = DMA_CCR_MINC | DMA_CCR_DIR | DMA_CCR_TCIE | DMA_CCR_EN;
+	SPI1->CR2 |= SPI_CR2_TXDMAEN;
+}
+
+uint8_t SSD1306_Transport_Busy(void) {
+	return ssd1306_SPI_Busy;
+}
+
+void SSD1306_Transport_Begin(void) {
+	while (ssd1306_SPI_Busy)
+		;
+
+	SSD1306_SPI_HIGH(SSD1306_SPI_DC_PIN);
+	SSD1306_SPI_LOW(SSD1306_SPI_CS_PIN);
+}
+
+void SSD1306_Transport_Put(uint8_t data) {
+	while (!(SPI1->SR & SPI_SR_TXE))
+		;
+	SPI1->DR = data;
+}
+
+void SSD1306_Transport_End(void) {
+	ssd1306_SPI_Flush();
+	SSD1306_SPI_HIGH(SSD1306_SPI_CS_PIN);
+}
+
+void DMA1_Channel3_IRQHandler(void) {
+	SSD1306_TRANSPORT_DONE_t done = ssd1306_SPI_Done;
+
+	DMA1->IFCR = DMA_IFCR_CGIF3;
+	DMA1_Channel3->CCR = 0;
+	SPI1->CR2 &= ~SPI_CR2_TXDMAEN;
+
+	/* DMA is done when last byte was written to DR, not when it left the pin */
+	ssd1306_SPI_Flush();
+	SSD1306_SPI_HIGH(SSD1306_SPI_CS_PIN);
+
+	ssd1306_SPI_Busy = 0;
+	if (done) {
+		done();
+	}
+}
+
+#endif /* SSD1306_TRANSPORT == SSD1306_TRANSPORT_SPI */
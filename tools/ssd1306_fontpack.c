@@ -0,0 +1,185 @@
+/*
+ * ssd1306_fontpack.c
+ *
+ *  Host tool: converts font tables of one uint16_t per glyph row (layout of fonts.c before packing,
+ *  MSB is the left pixel) to packed @ref FontDef_t tables.
+ *
+ *  Build:  cc -O2 -o ssd1306_fontpack ssd1306_fontpack.c
+ *  Usage:  ssd1306_fontpack width height name [codepoints] < rows.c > font.c
+ *
+ *  Every 0x number of input is one glyph row, text in between (array declaration, comments) is
+ *  skipped, so a row table can be cut out of C source as is.
+ *
+ *  codepoints lists code points of the glyphs in input order as comma separated values or ranges,
+ *  e.g. "32-126,176,181,8592-8595". Default is 32-126. When it is not exactly 32-126 a sorted
+ *  @ref FONTS_RANGE_t table name_Ranges is written too, list must be ascending.
+ *
+ *  Packed glyph is width * height bits, column after column from the left, every column from
+ *  the top pixel, LSB of byte first. Glyph takes (width * height + 7) / 8 bytes.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+#define MAX_RANGES    64
+
+/* Code point range of consecutive glyphs */
+typedef struct {
+	unsigned first;
+	unsigned count;
+	unsigned glyph;
+} range_t;
+
+/* Reads next 0x number, returns 0 at the end of input */
+static int hex_next(unsigned* value) {
+	int c, prev = 0;
+
+	while ((c = getchar()) != EOF) {
+		if ((c == 'x' || c == 'X') && prev == '0') {
+			*value = 0;
+			while ((c = getchar()) != EOF && isxdigit(c)) {
+				*value = *value * 16 + (isdigit(c) ? c - '0' : (tolower(c) - 'a' + 10));
+			}
+			return 1;
+		}
+		prev = c;
+	}
+	return 0;
+}
+
+/* Parses "a-b,c,..." into ranges, returns number of ranges or -1 */
+static int parse_ranges(const char* s, range_t* ranges) {
+	unsigned a, b, glyph = 0;
+	char* end;
+	int n = 0;
+
+	while (*s) {
+		a = strtoul(s, &end, 0);
+		b = a;
+		if (end == s) {
+			return -1;
+		}
+		if (*end == '-') {
+			s = end + 1;
+			b = strtoul(s, &end, 0);
+			if (end == s || b < a) {
+				return -1;
+			}
+		}
+		if (n == MAX_RANGES || (n && a <= ranges[n - 1].first + ranges[n - 1].count - 1)) {
+			return -1;
+		}
+		if (n && a == ranges[n - 1].first + ranges[n - 1].count) {
+			/* Adjacent, merge */
+			ranges[n - 1].count += b - a + 1;
+		} else {
+			ranges[n].first = a;
+			ranges[n].count = b - a + 1;
+			ranges[n].glyph = glyph;
+			n++;
+		}
+		glyph += b - a + 1;
+		s = end;
+		if (*s == ',') {
+			s++;
+		} else if (*s) {
+			return -1;
+		}
+	}
+	return n;
+}
+
+/* Code point of glyph index */
+static unsigned glyph_codepoint(const range_t* ranges, int n, unsigned glyph) {
+	int i;
+
+	for (i = n - 1; i > 0 && ranges[i].glyph > glyph; i--) {
+	}
+	return ranges[i].first + glyph - ranges[i].glyph;
+}
+
+int main(int argc, char** argv) {
+	range_t ranges[MAX_RANGES];
+	unsigned rows[32], v, cp, total;
+	unsigned char glyph[64];
+	int w, h, n = 0, nranges, i, j, bit, bytes, count = 0;
+
+	if (argc < 4 || argc > 5) {
+		fprintf(stderr, "usage: %s width height name [codepoints] < rows.c\n", argv[0]);
+		return 1;
+	}
+	w = atoi(argv[1]);
+	h = atoi(argv[2]);
+	nranges = parse_ranges(argc == 5 ? argv[4] : "32-126", ranges);
+	if (w < 1 || w > 16 || h < 1 || h > 32) {
+		fprintf(stderr, "%s: width must be 1 to 16 and height 1 to 32\n", argv[0]);
+		return 1;
+	}
+	if (nranges < 1) {
+		fprintf(stderr, "%s: bad code point list, ascending values or ranges expected\n", argv[0]);
+		return 1;
+	}
+	total = ranges[nranges - 1].glyph + ranges[nranges - 1].count;
+	bytes = (w * h + 7) / 8;
+
+	printf("const uint8_t %s [] = {\n", argv[3]);
+	while (hex_next(&v)) {
+		rows[n++] = v;
+		if (n < h) {
+			continue;
+		}
+		n = 0;
+		if ((unsigned)count == total) {
+			fprintf(stderr, "%s: more glyphs than code points\n", argv[0]);
+			return 1;
+		}
+
+		/* Column-major bits */
+		for (i = 0; i < bytes; i++) {
+			glyph[i] = 0;
+		}
+		for (j = 0; j < w; j++) {
+			for (i = 0; i < h; i++) {
+				if ((rows[i] << j) & 0x8000) {
+					bit = j * h + i;
+					glyph[bit / 8] |= 1 << (bit % 8);
+				}
+			}
+		}
+
+		for (i = 0; i < bytes; i++) {
+			printf("0x%02X,%s", glyph[i], i + 1 < bytes ? " " : "");
+		}
+		cp = glyph_codepoint(ranges, nranges, count);
+		if (cp == ' ') {
+			printf("  // sp\n");
+		} else if (cp < 128 && isgraph(cp) && cp != '\\') {
+			printf("  // %c\n", cp);
+		} else {
+			printf("  // U+%04X\n", cp);
+		}
+		count++;
+	}
+	printf("};\n");
+
+	if (n) {
+		fprintf(stderr, "%s: %d rows left over, input is not a multiple of height\n", argv[0], n);
+		return 1;
+	}
+	if ((unsigned)count != total) {
+		fprintf(stderr, "%s: %d glyphs for %u code points\n", argv[0], count, total);
+		return 1;
+	}
+
+	if (nranges > 1 || ranges[0].first != 32 || ranges[0].count != 95) {
+		printf("\nconst FONTS_RANGE_t %s_Ranges [] = {\n", argv[3]);
+		for (i = 0; i < nranges; i++) {
+			printf("\t{%u, %u, %u},\n", ranges[i].first, ranges[i].count, ranges[i].glyph);
+		}
+		printf("};\n");
+	}
+
+	fprintf(stderr, "%s: %d glyphs in %d ranges, %d -> %d bytes\n", argv[3], count, nranges,
+		count * h * 2, count * bytes);
+	return 0;
+}
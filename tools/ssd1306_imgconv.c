@@ -0,0 +1,248 @@
+/*
+ * ssd1306_imgconv.c
+ *
+ *  Host tool: converts PBM bitmaps and PGM grayscale images to compressed @ref SSD1306_IMAGE_t sources.
+ *
+ *  Build:  cc -O2 -o ssd1306_imgconv ssd1306_imgconv.c
+ *  Usage:  ssd1306_imgconv [-d threshold|ordered|fs] image.pbm|image.pgm name > image.c
+ *
+ *  Both plain (P1) and raw (P4) PBM are accepted, black PBM pixels become lit LCD pixels.
+ *  PGM (P2, P5) images are dithered to 1 bit, bright pixels become lit LCD pixels:
+ *   - threshold: pixel is lit above half brightness (default)
+ *   - ordered:   8x8 Bayer matrix, same as @ref SSD1306_DrawGrayOrdered
+ *   - fs:        Floyd-Steinberg error diffusion
+ *  Other formats (PNG, BMP, ...) can be turned into PBM/PGM first, e.g. "convert logo.png logo.pgm".
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+/* Reads next PBM header number, skipping whitespace and comments */
+static int pbm_number(FILE* f) {
+	int c, n = 0;
+
+	do {
+		c = fgetc(f);
+		if (c == '#') {
+			while (c != '\n' && c != EOF) {
+				c = fgetc(f);
+			}
+		}
+	} while (isspace(c));
+
+	while (isdigit(c)) {
+		n = n * 10 + (c - '0');
+		c = fgetc(f);
+	}
+	return n;
+}
+
+/* 8x8 Bayer matrix, [row][column] */
+static const unsigned char bayer[8][8] = {
+	{ 0, 32,  8, 40,  2, 34, 10, 42},
+	{48, 16, 56, 24, 50, 18, 58, 26},
+	{12, 44,  4, 36, 14, 46,  6, 38},
+	{60, 28, 52, 20, 62, 30, 54, 22},
+	{ 3, 35, 11, 43,  1, 33,  9, 41},
+	{51, 19, 59, 27, 49, 17, 57, 25},
+	{15, 47,  7, 39, 13, 45,  5, 37},
+	{63, 31, 55, 23, 61, 29, 53, 21}
+};
+
+/* Dithers 0-255 gray pixels in place to 0/1 */
+static void dither(unsigned char* px, int w, int h, const char* mode) {
+	int x, y, v, e;
+	int* err;
+
+	if (!strcmp(mode, "ordered")) {
+		for (y = 0; y < h; y++) {
+			for (x = 0; x < w; x++) {
+				px[y * w + x] = px[y * w + x] > bayer[y & 7][x & 7] * 4 + 2;
+			}
+		}
+	} else if (!strcmp(mode, "fs")) {
+		/* Two rows of error, one extra pixel on both sides */
+		err = calloc((size_t)2 * (w + 2), sizeof(int));
+		for (y = 0; y < h; y++) {
+			for (x = 0; x < w; x++) {
+				v = px[y * w + x] + err[x + 1];
+				px[y * w + x] = v >= 128;
+				e = v - (v >= 128 ? 255 : 0);
+				err[x + 2] += e * 7 / 16;
+				err[w + 2 + x] += e * 3 / 16;
+				err[w + 2 + x + 1] += e * 5 / 16;
+				err[w + 2 + x + 2] += e / 16;
+			}
+			memcpy(err, err + w + 2, (w + 2) * sizeof(int));
+			memset(err + w + 2, 0, (w + 2) * sizeof(int));
+		}
+		free(err);
+	} else {
+		for (x = 0; x < w * h; x++) {
+			px[x] = px[x] >= 128;
+		}
+	}
+}
+
+/* Reads PBM or PGM into one byte per pixel, 1 means lit LCD pixel */
+static unsigned char* pnm_read(FILE* f, int* w, int* h, const char* mode) {
+	unsigned char* px;
+	int type, x, y, c, i, max = 1;
+
+	if (fgetc(f) != 'P') {
+		return NULL;
+	}
+	type = fgetc(f);
+	if (type != '1' && type != '4' && type != '2' && type != '5') {
+		return NULL;
+	}
+	*w = pbm_number(f);
+	*h = pbm_number(f);
+	if (type == '2' || type == '5') {
+		max = pbm_number(f);
+	}
+	if (*w <= 0 || *h <= 0 || max <= 0 || max > 255) {
+		return NULL;
+	}
+
+	px = calloc((size_t)*w * *h, 1);
+	if (type == '2' || type == '5') {
+		for (i = 0; i < *w * *h; i++) {
+			c = (type == '2') ? pbm_number(f) : fgetc(f);
+			px[i] = (unsigned char)(c * 255 / max);
+		}
+		dither(px, *w, *h, mode);
+		return px;
+	}
+
+	for (y = 0; y < *h; y++) {
+		if (type == '1') {
+			for (x = 0; x < *w; x++) {
+				do {
+					c = fgetc(f);
+				} while (c != '0' && c != '1' && c != EOF);
+				px[y * *w + x] = (c == '1');
+			}
+		} else {
+			for (x = 0; x < *w; x += 8) {
+				c = fgetc(f);
+				for (i = 0; i < 8 && x + i < *w; i++) {
+					px[y * *w + x + i] = (c >> (7 - i)) & 1;
+				}
+			}
+		}
+	}
+	return px;
+}
+
+/* Repeats of at least this many bytes become runs, shorter ones stay in literals like in
+ * standard PackBits, so output never grows beyond n + (n + 127) / 128 bytes */
+#define PACKBITS_MIN_RUN 3
+
+/* Length of repeated byte at in[i], at most 128 */
+static int packbits_run(const unsigned char* in, int i, int n) {
+	int run = 1;
+
+	while (i + run < n && run < 128 && in[i + run] == in[i]) {
+		run++;
+	}
+	return run;
+}
+
+/* PackBits one page row, returns number of bytes written to out, -1 when size is too small */
+static int packbits(const unsigned char* in, int n, unsigned char* out, int size) {
+	int i = 0, o = 0, run, lit;
+
+	while (i < n) {
+		run = packbits_run(in, i, n);
+		if (run >= PACKBITS_MIN_RUN) {
+			if (o + 2 > size) {
+				return -1;
+			}
+			out[o++] = (unsigned char)(257 - run);
+			out[o++] = in[i];
+			i += run;
+			continue;
+		}
+
+		/* Literal until next run, short repeats are folded in */
+		lit = run;
+		while (i + lit < n && lit < 128 && packbits_run(in, i + lit, n) < PACKBITS_MIN_RUN) {
+			lit++;
+		}
+		if (o + 1 + lit > size) {
+			return -1;
+		}
+		out[o++] = (unsigned char)(lit - 1);
+		memcpy(&out[o], &in[i], lit);
+		o += lit;
+		i += lit;
+	}
+	return o;
+}
+
+int main(int argc, char** argv) {
+	FILE* f;
+	unsigned char *px, *row, *out;
+	const char* mode = "threshold";
+	int w, h, pages, p, x, b, len = 0, i, n, size;
+
+	if (argc == 5 && !strcmp(argv[1], "-d")) {
+		mode = argv[2];
+		argv += 2;
+		argc -= 2;
+	}
+	if (argc != 3) {
+		fprintf(stderr, "usage: %s [-d threshold|ordered|fs] image.pbm|image.pgm name\n", argv[0]);
+		return 1;
+	}
+	f = fopen(argv[1], "rb");
+	if (!f) {
+		perror(argv[1]);
+		return 1;
+	}
+	px = pnm_read(f, &w, &h, mode);
+	fclose(f);
+	if (!px) {
+		fprintf(stderr, "%s: not a PBM/PGM file\n", argv[1]);
+		return 1;
+	}
+
+	pages = (h + 7) / 8;
+	row = malloc(w);
+	/* Worst case is one literal header per 128 bytes */
+	size = pages * (w + (w + 127) / 128);
+	out = malloc(size);
+
+	for (p = 0; p < pages; p++) {
+		/* Page-major bytes, LSB is the top pixel */
+		for (x = 0; x < w; x++) {
+			row[x] = 0;
+			for (b = 0; b < 8 && p * 8 + b < h; b++) {
+				row[x] |= px[(p * 8 + b) * w + x] << b;
+			}
+		}
+		n = packbits(row, w, &out[len], size - len);
+		if (n < 0) {
+			fprintf(stderr, "%s: output buffer too small\n", argv[1]);
+			return 1;
+		}
+		len += n;
+	}
+
+	printf("/* %s: %dx%d, %d bytes raw, %d bytes compressed */\n", argv[1], w, h, pages * w, len);
+	printf("#include \"ssd1306.h\"\n\n");
+	printf("static const uint8_t %s_data[] = {", argv[2]);
+	for (i = 0; i < len; i++) {
+		printf("%s0x%02X,", (i % 16) ? " " : "\n\t", out[i]);
+	}
+	printf("\n};\n\n");
+	printf("const SSD1306_IMAGE_t %s = {%d, %d, %s_data};\n", argv[2], w, h, argv[2]);
+
+	fprintf(stderr, "%s: %d -> %d bytes\n", argv[2], pages * w, len);
+	free(px);
+	free(row);
+	free(out);
+	return 0;
+}